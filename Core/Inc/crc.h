@@ -29,19 +29,26 @@ extern "C" {
 #include "main.h"
 
 /* USER CODE BEGIN Includes */
-
+#include <stdbool.h>
 /* USER CODE END Includes */
 
 extern CRC_HandleTypeDef hcrc;
 
 /* USER CODE BEGIN Private defines */
+#define CRC32_INIT_VALUE    DEFAULT_CRC_INITVALUE
 
+/* Below this size the DMA set-up costs more than feeding the unit directly */
+#define CRC_DMA_MIN_SIZE    256U
+/* A GPDMA block is limited to 64 KB, keep it a multiple of a word */
+#define CRC_DMA_MAX_BLOCK   0xFFFCU
 /* USER CODE END Private defines */
 
 void MX_CRC_Init(void);
 
 /* USER CODE BEGIN Prototypes */
-
+uint32_t crc32_continue(uint32_t crc, const void *data, uint32_t size);
+uint32_t crc32_continue_dma(uint32_t crc, const void *data, uint32_t size);
+void crc_dma_irq_handler(void);
 /* USER CODE END Prototypes */
 
 #ifdef __cplusplus
@@ -57,6 +57,7 @@ void PendSV_Handler(void);
 void SysTick_Handler(void);
 void FDCAN1_IT0_IRQHandler(void);
 /* USER CODE BEGIN EFP */
+void GPDMA1_Channel7_IRQHandler(void);
 
 /* USER CODE END EFP */
 
@@ -21,7 +21,14 @@
 #include "crc.h"
 
 /* USER CODE BEGIN 0 */
+/* GPDMA1 channel 7 is not in the .ioc: its handle and interrupt live in user
+   code, see crc_dma_irq_handler() */
+static DMA_HandleTypeDef crc_dma_handle;
+static volatile bool crc_dma_busy = false;
+static volatile bool crc_dma_error = false;
 
+static void crc_dma_complete_callback(DMA_HandleTypeDef *hdma);
+static void crc_dma_error_callback(DMA_HandleTypeDef *hdma);
 /* USER CODE END 0 */
 
 CRC_HandleTypeDef hcrc;
@@ -49,6 +56,40 @@ void MX_CRC_Init(void)
   }
   /* USER CODE BEGIN CRC_Init 2 */
 
+  /* GPDMA1 channel 7 feeds the CRC unit from memory, one word per beat.
+     The destination byte and half-word exchanges reverse every word so the
+     unit sees the bytes in memory order, as with the byte input format. */
+  DMA_DataHandlingConfTypeDef data_handling = {0};
+
+  crc_dma_handle.Instance = GPDMA1_Channel7;
+  crc_dma_handle.Init.Request = DMA_REQUEST_SW;
+  crc_dma_handle.Init.BlkHWRequest = DMA_BREQ_SINGLE_BURST;
+  crc_dma_handle.Init.Direction = DMA_MEMORY_TO_MEMORY;
+  crc_dma_handle.Init.SrcInc = DMA_SINC_INCREMENTED;
+  crc_dma_handle.Init.DestInc = DMA_DINC_FIXED;
+  crc_dma_handle.Init.SrcDataWidth = DMA_SRC_DATAWIDTH_WORD;
+  crc_dma_handle.Init.DestDataWidth = DMA_DEST_DATAWIDTH_WORD;
+  crc_dma_handle.Init.Priority = DMA_LOW_PRIORITY_HIGH_WEIGHT;
+  crc_dma_handle.Init.SrcBurstLength = 1;
+  crc_dma_handle.Init.DestBurstLength = 1;
+  crc_dma_handle.Init.TransferAllocatedPort = DMA_SRC_ALLOCATED_PORT0|DMA_DEST_ALLOCATED_PORT0;
+  crc_dma_handle.Init.TransferEventMode = DMA_TCEM_BLOCK_TRANSFER;
+  crc_dma_handle.Init.Mode = DMA_NORMAL;
+  if (HAL_DMA_Init(&crc_dma_handle) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  data_handling.DataExchange = DMA_EXCHANGE_DEST_BYTE | DMA_EXCHANGE_DEST_HALFWORD;
+  data_handling.DataAlignment = DMA_DATA_RIGHTALIGN_ZEROPADDED;
+  if (HAL_DMAEx_ConfigDataHandling(&crc_dma_handle, &data_handling) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  crc_dma_handle.XferCpltCallback = crc_dma_complete_callback;
+  crc_dma_handle.XferErrorCallback = crc_dma_error_callback;
+
   /* USER CODE END CRC_Init 2 */
 
 }
@@ -64,6 +105,10 @@ void HAL_CRC_MspInit(CRC_HandleTypeDef* crcHandle)
     /* CRC clock enable */
     __HAL_RCC_CRC_CLK_ENABLE();
   /* USER CODE BEGIN CRC_MspInit 1 */
+    __HAL_RCC_GPDMA1_CLK_ENABLE();
+
+    HAL_NVIC_SetPriority(GPDMA1_Channel7_IRQn, 1, 0);
+    HAL_NVIC_EnableIRQ(GPDMA1_Channel7_IRQn);
 
   /* USER CODE END CRC_MspInit 1 */
   }
@@ -80,6 +125,7 @@ void HAL_CRC_MspDeInit(CRC_HandleTypeDef* crcHandle)
     /* Peripheral clock disable */
     __HAL_RCC_CRC_CLK_DISABLE();
   /* USER CODE BEGIN CRC_MspDeInit 1 */
+    HAL_NVIC_DisableIRQ(GPDMA1_Channel7_IRQn);
 
   /* USER CODE END CRC_MspDeInit 1 */
   }
@@ -87,4 +133,136 @@ void HAL_CRC_MspDeInit(CRC_HandleTypeDef* crcHandle)
 
 /* USER CODE BEGIN 1 */
 
+/**
+  * @brief  Continue a CRC32 computation from a previous result.
+  * @note   The peripheral is seeded with the running value through its INIT
+  *         register so that several independent CRC streams can share the unit.
+  *         INIT is restored afterwards, other users keep seeing the default seed.
+  *         Pass CRC32_INIT_VALUE to start a new computation.
+  * @param  crc   Result of the previous call (or CRC32_INIT_VALUE)
+  * @param  data  Data to fold into the CRC
+  * @param  size  Number of bytes
+  * @retval Updated CRC32 value
+  */
+uint32_t crc32_continue(uint32_t crc, const void *data, uint32_t size)
+{
+  const uint8_t *bytes = (const uint8_t *)data;
+
+  hcrc.Instance->INIT = crc;
+  __HAL_CRC_DR_RESET(&hcrc);
+
+  /* The unit is configured for byte input: a byte-reversed word write is
+     processed exactly like its four bytes written in memory order. */
+  while (size >= 4U)
+  {
+    hcrc.Instance->DR = __REV(__UNALIGNED_UINT32_READ(bytes));
+    bytes += 4U;
+    size -= 4U;
+  }
+  while (size > 0U)
+  {
+    *(__IO uint8_t *)(__IO void *)(&hcrc.Instance->DR) = *bytes++;
+    size--;
+  }
+
+  crc = hcrc.Instance->DR;
+  hcrc.Instance->INIT = CRC32_INIT_VALUE;
+
+  return crc;
+}
+
+/**
+  * @brief  Same as crc32_continue(), the words being fed to the unit by GPDMA.
+  * @note   The core sleeps until each block completes. Small or unaligned
+  *         buffers, a busy channel or a DMA error fall back to the
+  *         synchronous path, so the result is always valid.
+  * @param  crc   Result of the previous call (or CRC32_INIT_VALUE)
+  * @param  data  Data to fold into the CRC (RAM or FLASH)
+  * @param  size  Number of bytes
+  * @retval Updated CRC32 value
+  */
+uint32_t crc32_continue_dma(uint32_t crc, const void *data, uint32_t size)
+{
+  uint32_t address = (uint32_t)data;
+  uint32_t words_size = size & ~3U;
+
+  if ((size < CRC_DMA_MIN_SIZE) || ((address & 3U) != 0U) ||
+      (crc_dma_handle.State != HAL_DMA_STATE_READY))
+  {
+    return crc32_continue(crc, data, size);
+  }
+
+  hcrc.Instance->INIT = crc;
+  __HAL_CRC_DR_RESET(&hcrc);
+  crc_dma_error = false;
+
+  for (uint32_t offset = 0; (offset < words_size) && !crc_dma_error; )
+  {
+    uint32_t block = words_size - offset;
+
+    if (block > CRC_DMA_MAX_BLOCK)
+    {
+      block = CRC_DMA_MAX_BLOCK;
+    }
+
+    crc_dma_busy = true;
+    if (HAL_DMA_Start_IT(&crc_dma_handle, address + offset, (uint32_t)&hcrc.Instance->DR, block) != HAL_OK)
+    {
+      crc_dma_busy = false;
+      crc_dma_error = true;
+      break;
+    }
+
+    /* PRIMASK is set around WFI so the completion cannot slip in between the
+       check and the sleep; a pending interrupt still wakes the core. */
+    __disable_irq();
+    while (crc_dma_busy)
+    {
+      __WFI();
+      __enable_irq();
+      __disable_irq();
+    }
+    __enable_irq();
+
+    offset += block;
+  }
+
+  if (crc_dma_error)
+  {
+    hcrc.Instance->INIT = CRC32_INIT_VALUE;
+    return crc32_continue(crc, data, size);
+  }
+
+  for (uint32_t i = words_size; i < size; i++)
+  {
+    *(__IO uint8_t *)(__IO void *)(&hcrc.Instance->DR) = ((const uint8_t *)data)[i];
+  }
+
+  crc = hcrc.Instance->DR;
+  hcrc.Instance->INIT = CRC32_INIT_VALUE;
+
+  return crc;
+}
+
+/**
+  * @brief  GPDMA1 channel 7 interrupt, called from GPDMA1_Channel7_IRQHandler().
+  */
+void crc_dma_irq_handler(void)
+{
+  HAL_DMA_IRQHandler(&crc_dma_handle);
+}
+
+static void crc_dma_complete_callback(DMA_HandleTypeDef *hdma)
+{
+  (void)hdma;
+  crc_dma_busy = false;
+}
+
+static void crc_dma_error_callback(DMA_HandleTypeDef *hdma)
+{
+  (void)hdma;
+  crc_dma_error = true;
+  crc_dma_busy = false;
+}
+
 /* USER CODE END 1 */
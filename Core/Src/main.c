@@ -30,9 +30,21 @@
 #include "sf_flash_hal.h"
 #include "sf_crc_hal.h"
 #include "mem.h"
+#include "mem_cache.h"
 #include "can_message_handler.h"
 #include "sf_timer_hal.h"
 #include "sf_charger_led_hal.h"
+#include "boot_cache.h"
+#include "boot_main.h"
+#include "boot_timeline.h"
+#include "boot_handoff.h"
+#include "event_loop.h"
+#include "scheduler.h"
+#include "timebase.h"
+#include "dlog.h"
+#ifdef BOOTLOADER_BENCHMARK
+#include "bench.h"
+#endif
 
 /* USER CODE END Includes */
 
@@ -95,9 +107,19 @@ const btea_key_t btea_key = {
 #error "BOARD needs to be defined"
 #endif
 
+/* A board accepting Ed25519 manifests defines its ed25519_public_key_t next to
+ * public_key and points BOOTLOADER_ED25519_PUBLIC_KEY at it */
+#ifndef BOOTLOADER_ED25519_PUBLIC_KEY
+#define BOOTLOADER_ED25519_PUBLIC_KEY       NULL
+#endif
+
 #define BOOTLOADER_LED_TIME_TOGGLE		1000
 
+/* Budget of the LED task, after the tasks of boot_main.h */
+#define TASK_LED_BUDGET_US				10U
+
 #define BOOT_MAGIC 						(0xDEADBEEFu)
+#define BOOT_VERIFY_MAGIC 				(0x5AFEC0DEu)
 
 /* USER CODE END PD */
 
@@ -109,6 +131,8 @@ const btea_key_t btea_key = {
 /* Private variables ---------------------------------------------------------*/
 
 /* USER CODE BEGIN PV */
+static uint32_t bootloader_crc32(const void *data, uint32_t size);
+
 static uint8_t btea_buffer[BOOTLOADER_BTEA_BUFFER_SIZE];
 
 const bootloader_config_t bootloader_config = {
@@ -121,9 +145,9 @@ const bootloader_config_t bootloader_config = {
     .btea_chunk_size = BOOTLOADER_BTEA_BUFFER_SIZE,
     .btea_key = &btea_key,
     .public_key = &public_key,
-    .jump_to_app_func = sf_bootloader_hal_jump_to_app,
-    .crc32_func = sf_bootloader_hal_crc32_func,
-    .log_func = sf_bootloader_hal_log_func,
+    .jump_to_app_func = boot_main_jump_to_app,
+    .crc32_func = bootloader_crc32,
+    .log_func = dlog_printf,
     .magic = BOOTLOADER_MAGIC,
     .mem_read_func = mem_read,
     .mem_write_func = mem_write,
@@ -168,6 +192,45 @@ static inline void clear_reset_flags(void)
     RCC->RSR |= RCC_RSR_RMVF;
 }
 
+/* Image CRCs of the core, the app slot check at boot included: same result as
+ * sf_bootloader_hal_crc32_func(), the CRC unit being fed by GPDMA */
+static uint32_t bootloader_crc32(const void *data, uint32_t size)
+{
+    return crc32_continue_dma(CRC32_INIT_VALUE, data, size);
+}
+
+static bool task_led(uint32_t budget_cycles)
+{
+    uint32_t time = sf_bootloader_hal_get_1ms_counter();
+
+    (void)budget_cycles;
+
+    if( (time - led_timer) >= BOOTLOADER_LED_TIME_TOGGLE)
+    {
+        led_timer = time;
+
+        if( gpio_get( LED1 ) == 0 ) {
+            gpio_set( LED1 );
+            gpio_clear( LED2 );
+        }
+        else
+        {
+            gpio_clear( LED1 );
+            gpio_set( LED2 );
+        }
+    }
+
+    return false;
+}
+
+/* The shared boot of boot_main.h, the LED after its tasks */
+static const boot_main_platform_t boot_main_platform = {
+    .ecu_id = BOOTLOADER_ECU_CODE_ID,
+    .version = BOOTLOADER_VERSION,
+    .before_jump = NULL,
+    .platform_task = { task_led, EVENT_LOOP_TICK, TASK_LED_BUDGET_US },
+};
+
 /* USER CODE END 0 */
 
 /**
@@ -178,7 +241,8 @@ int main(void)
 {
 
   /* USER CODE BEGIN 1 */
-
+  /* Boot phases are timed from here */
+  boot_timeline_start();
   /* USER CODE END 1 */
 
   /* MCU Configuration--------------------------------------------------------*/
@@ -200,14 +264,36 @@ int main(void)
   SystemClock_Config();
 
   /* USER CODE BEGIN SysInit */
+  boot_timeline_mark(BOOT_TIMELINE_CLOCK);
+
+  /* Cacheable region map and ICACHE, once FLASH runs with its final wait states */
+  mem_cache_init();
+
+  /* Microsecond timebase, the 1 ms counter follows it from here on */
+  timebase_init();
 
+  /* Deferred log, keeps the records of a run that ended in a reset */
+  dlog_init();
   /* USER CODE END SysInit */
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
-  MX_FDCAN1_Init();
   MX_CRC_Init();
   /* USER CODE BEGIN 2 */
+  boot_timeline_mark(BOOT_TIMELINE_PERIPHERALS);
+
+#ifdef BOOTLOADER_BENCHMARK
+  /* Benchmark builds report on the SWO, then boot normally */
+  bench_init();
+  (void)bench_btea();
+  (void)bench_ecdsa();
+  (void)bench_ed25519();
+  (void)bench_sha256();
+  (void)bench_image();
+  (void)bench_cache();
+  (void)bench_dlog();
+  (void)bench_profile_zone();
+#endif
 
   hardware_info.magic_number = 0xACABACAB;
   hardware_info.board_version = (BOARD | (HW_VERSION << 8));
@@ -221,33 +307,49 @@ int main(void)
 
   /* Write your local variable definition here */
   bool stay_in_bootloader = false;
+  bool verify_requested = false;
 
   if (is_software_reset() && (shared_variable == BOOT_MAGIC)) {
 	  stay_in_bootloader = true;
   }
 
+  /* The application can ask for a full verification on the next boot */
+  if (is_software_reset() && (shared_variable == BOOT_VERIFY_MAGIC)) {
+	  verify_requested = true;
+  }
+
+  boot_handoff_reason_e boot_reason = BOOT_HANDOFF_REASON_POWER_ON;
+  if (stay_in_bootloader) {
+	  boot_reason = BOOT_HANDOFF_REASON_STAY_REQUEST;
+  } else if (verify_requested) {
+	  boot_reason = BOOT_HANDOFF_REASON_VERIFY_REQUEST;
+  } else if (is_software_reset()) {
+	  boot_reason = BOOT_HANDOFF_REASON_SOFTWARE_RESET;
+  }
+  uint32_t reset_flags = RCC->RSR;
+
   /* Clear flags so the next reset cause is detectable */
   clear_reset_flags();
 
   shared_variable = 0u;
 
   mem_init();
+  boot_cache_init();
+  boot_handoff_begin(reset_flags, boot_reason);
+  boot_main_init(&boot_main_platform);
+
+  /* Nothing was written since the application was last verified: start it right away,
+   * with only the clocks, GPIO and CRC set up */
+  if (!stay_in_bootloader && !verify_requested) {
+	  boot_main_fast_boot();
+  }
 
-  can_message_handler_init();
-  sf_bootloader_hal_init();
-
-  const bootloader_sections_t bootloader_sections = {
-		  .app_info = {.address = MEM_APP_INFO_ADDRESS, .size = MEM_APP_INFO_END_ADDRESS - MEM_APP_INFO_ADDRESS },
-		  .app = {.address = MEM_APP_START_ADDRESS, .size = MEM_APP_END_ADDRESS - MEM_APP_START_ADDRESS },
-		  .upgrade_info = {.address = MEM_UPGRADE_INFO_ADDRESS, .size = MEM_UPGRADE_INFO_END_ADDRESS - MEM_UPGRADE_INFO_ADDRESS },
-		  .upgrade = {.address = MEM_UPGRADE_START_ADDRESS, .size = MEM_UPGRADE_END_ADDRESS - MEM_UPGRADE_START_ADDRESS },
-  };
-
-  bootloader_init(&bootloader_config, &bootloader_sections);
+  /* Update, recovery or first boot of a new image: bring up CAN and the bootloader core.
+   * FDCAN1 is set to "do not generate function call" in the .ioc for this reason. */
+  MX_FDCAN1_Init();
 
-  if (stay_in_bootloader) {
-	  bootloader_stay(true);
-  }
+  /* Bootloader core, manifest and main loop tasks */
+  boot_main_start(&bootloader_config, BOOTLOADER_ED25519_PUBLIC_KEY, stay_in_bootloader);
 
   /* USER CODE END 2 */
 
@@ -255,28 +357,10 @@ int main(void)
   /* USER CODE BEGIN WHILE */
   while (1)
   {
-	  uint8_t app_status = bootloader_app_status();
-
-	  can_message_handler_task(BOOTLOADER_ECU_CODE_ID, app_status, BOOTLOADER_VERSION);
-	  uint32_t time = sf_bootloader_hal_get_1ms_counter();
-	  bootloader_tick(time);
-
-
-	  if( (time - led_timer) >= BOOTLOADER_LED_TIME_TOGGLE)
-	  {
-		  led_timer = sf_bootloader_hal_get_1ms_counter();
-
-		  if( gpio_get( LED1 ) == 0 ) {
-			  gpio_set( LED1 );
-			  gpio_clear( LED2 );
-		  }
-		  else
-		  {
-			  gpio_clear( LED1 );
-			  gpio_set( LED2 );
-		  }
-	  }
+	  scheduler_run();
 
+	  /* Sleep until a CAN frame, the next 1 ms tick or any other interrupt */
+	  event_loop_wait();
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
@@ -22,6 +22,9 @@
 #include "stm32h5xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "event_loop.h"
+#include "can_message_handler.h"
+#include "crc.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -187,6 +190,7 @@ void SysTick_Handler(void)
   /* USER CODE END SysTick_IRQn 0 */
   HAL_IncTick();
   /* USER CODE BEGIN SysTick_IRQn 1 */
+  event_loop_post(EVENT_LOOP_TICK);
 
   /* USER CODE END SysTick_IRQn 1 */
 }
@@ -208,10 +212,22 @@ void FDCAN1_IT0_IRQHandler(void)
   /* USER CODE END FDCAN1_IT0_IRQn 0 */
   HAL_FDCAN_IRQHandler(&hfdcan1);
   /* USER CODE BEGIN FDCAN1_IT0_IRQn 1 */
+  can_message_handler_rx_irq();
+  event_loop_post(EVENT_LOOP_CAN_RX);
 
   /* USER CODE END FDCAN1_IT0_IRQn 1 */
 }
 
 /* USER CODE BEGIN 1 */
 
+/**
+  * @brief This function handles GPDMA1 Channel 7 global interrupt.
+  * @note  The channel feeds the CRC unit and is not configured in the .ioc,
+  *        the handler is kept here so that code generation leaves it alone.
+  */
+void GPDMA1_Channel7_IRQHandler(void)
+{
+  crc_dma_irq_handler();
+}
+
 /* USER CODE END 1 */
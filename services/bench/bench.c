@@ -0,0 +1,67 @@
+/**
+ * @file bench.c
+ * @brief Benchmark reporting shared by the target and host builds
+ * @date 19/10/2026
+ */
+
+#ifdef BOOTLOADER_BENCHMARK
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "bench.h"
+
+/* Public Functions -----------------------------------------------------------------*/
+#if defined(__arm__)
+/* printf() goes to the SWO, overriding the weak hook in syscalls.c */
+int __io_putchar(int ch)
+{
+	return (int)ITM_SendChar((uint32_t)ch);
+}
+#endif
+
+void bench_init(void)
+{
+	cycle_counter_init();
+	printf("clock,%lu\n", (unsigned long)cycle_counter_hz());
+}
+
+/**
+ * @brief Print the best time of a kernel over a buffer of the given size.
+ */
+void bench_report(const char *name, uint32_t bytes, uint32_t cycles)
+{
+	printf("bench,%s,%lu,%lu\n", name, (unsigned long)bytes, (unsigned long)cycles);
+}
+
+/**
+ * @brief Print the throughput of a streaming kernel: cycles per byte on target,
+ *        MB/s on the host (where the counter runs in nanoseconds).
+ */
+void bench_report_rate(const char *name, uint32_t bytes, uint32_t cycles)
+{
+	if (bytes == 0U || cycles == 0U) {
+		return;
+	}
+
+#if defined(__arm__)
+	uint32_t hundredths = (uint32_t)(((uint64_t)cycles * 100U) / bytes);
+	printf("rate,%s,%lu.%02lu,cycles/byte\n", name, (unsigned long)(hundredths / 100U), (unsigned long)(hundredths % 100U));
+#else
+	uint32_t hundredths = (uint32_t)(((uint64_t)bytes * 100000U) / cycles);
+	printf("rate,%s,%lu.%02lu,MB/s\n", name, (unsigned long)(hundredths / 100U), (unsigned long)(hundredths % 100U));
+#endif
+}
+
+/**
+ * @brief Print the outcome of a correctness check.
+ * @return passed
+ */
+bool bench_check(const char *name, bool passed)
+{
+	printf("check,%s,%s\n", name, passed ? "PASS" : "FAIL");
+	return passed;
+}
+
+#endif
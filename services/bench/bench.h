@@ -0,0 +1,38 @@
+/**
+ * @file bench.h
+ * @brief Benchmark reporting shared by the target and host builds
+ * @details Benchmarks are only built with BOOTLOADER_BENCHMARK defined. Each one
+ *          times its kernels with the cycle counter and checks their output against
+ *          a reference, and prints one line per result:
+ *            clock,<hz>
+ *            bench,<name>,<bytes>,<cycles>
+ *            rate,<name>,<value>,cycles/byte|MB/s
+ *            check,<name>,PASS|FAIL
+ *          On target the lines go to the SWO (ITM port 0) through printf.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "cycle_counter.h"
+
+/* General defines ------------------------------------------------------------------*/
+#define BENCH_ITERATIONS                    8U
+
+/* Public Functions ------------------------------------------------------------------*/
+void bench_init(void);
+void bench_report(const char *name, uint32_t bytes, uint32_t cycles);
+void bench_report_rate(const char *name, uint32_t bytes, uint32_t cycles);
+bool bench_check(const char *name, bool passed);
+
+int bench_btea(void);
+int bench_ecdsa(void);
+int bench_ed25519(void);
+int bench_sha256(void);
+int bench_image(void);
+int bench_cache(void);
+int bench_dlog(void);
+int bench_profile_zone(void);
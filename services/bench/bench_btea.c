@@ -0,0 +1,95 @@
+/**
+ * @file bench_btea.c
+ * @brief BTEA decryption: optimized kernel against the fw-utils implementation
+ * @details Checks that btea_fast_decrypt() matches btea() bit for bit, on the
+ *          chunk size used for updates and on short buffers that exercise every
+ *          entry point of the unrolled loop, then times both on one chunk.
+ * @date 19/10/2026
+ */
+
+#ifdef BOOTLOADER_BENCHMARK
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "bench.h"
+#include "btea.h"
+#include "btea_fast.h"
+
+/* Private defines ------------------------------------------------------------------*/
+#define BENCH_BTEA_WORDS                    (0x2000U / sizeof(uint32_t))    /* btea_chunk_size */
+
+/* On target btea() is wrapped, the generic implementation is __real_btea() */
+#if defined(__arm__)
+void __real_btea(uint32_t *v, int n, uint32_t const key[4]);
+#define btea_reference                      __real_btea
+#else
+#define btea_reference                      btea
+#endif
+
+/* Static Variables -----------------------------------------------------------------*/
+static const uint32_t bench_btea_key[4] = { 0x474657E4, 0x11AC1600, 0x4577F6F4, 0x56F4387D };
+static uint32_t bench_btea_plain[BENCH_BTEA_WORDS];
+static uint32_t bench_btea_reference[BENCH_BTEA_WORDS];
+static uint32_t bench_btea_fast[BENCH_BTEA_WORDS];
+
+/* Private Functions ----------------------------------------------------------------*/
+static void bench_btea_fill(uint32_t *words, uint32_t n, uint32_t seed)
+{
+	for (uint32_t i = 0; i < n; i++) {
+		seed = (seed * 1664525UL) + 1013904223UL;
+		words[i] = seed;
+	}
+}
+
+static bool bench_btea_compare(uint32_t n)
+{
+	bench_btea_fill(bench_btea_plain, n, n);
+	memcpy(bench_btea_reference, bench_btea_plain, n * sizeof(uint32_t));
+	btea_reference(bench_btea_reference, (int)n, bench_btea_key);
+	memcpy(bench_btea_fast, bench_btea_reference, n * sizeof(uint32_t));
+
+	btea_reference(bench_btea_reference, -(int)n, bench_btea_key);
+	btea_fast_decrypt(bench_btea_fast, n, bench_btea_key);
+
+	return (memcmp(bench_btea_fast, bench_btea_reference, n * sizeof(uint32_t)) == 0) &&
+			(memcmp(bench_btea_fast, bench_btea_plain, n * sizeof(uint32_t)) == 0);
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @return Number of failed checks
+ */
+int bench_btea(void)
+{
+	static const uint32_t sizes[] = { 2, 3, 4, 5, 6, 7, 8, 13, 64, 255, BENCH_BTEA_WORDS };
+	uint32_t best_reference = UINT32_MAX;
+	uint32_t best_fast = UINT32_MAX;
+	bool passed = true;
+	int failures = 0;
+
+	for (uint32_t i = 0; i < (sizeof(sizes) / sizeof(sizes[0])); i++) {
+		passed = bench_btea_compare(sizes[i]) && passed;
+	}
+	failures += bench_check("btea_fast_decrypt", passed) ? 0 : 1;
+
+	for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+		uint32_t start = cycle_counter_get();
+		btea_reference(bench_btea_reference, -(int)BENCH_BTEA_WORDS, bench_btea_key);
+		uint32_t elapsed = cycle_counter_get() - start;
+		best_reference = (elapsed < best_reference) ? elapsed : best_reference;
+
+		start = cycle_counter_get();
+		btea_fast_decrypt(bench_btea_fast, BENCH_BTEA_WORDS, bench_btea_key);
+		elapsed = cycle_counter_get() - start;
+		best_fast = (elapsed < best_fast) ? elapsed : best_fast;
+	}
+
+	bench_report("btea_decrypt", sizeof(bench_btea_reference), best_reference);
+	bench_report("btea_fast_decrypt", sizeof(bench_btea_fast), best_fast);
+
+	return failures;
+}
+
+#endif
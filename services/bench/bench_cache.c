@@ -0,0 +1,93 @@
+/**
+ * @file bench_cache.c
+ * @brief Hot loops run from FLASH with the instruction cache on and off
+ * @details Target only. Times the fw-utils BTEA decryption and the CRC32 of one
+ *          update chunk, and the CAN frame dispatch, each with the ICACHE disabled
+ *          then enabled; names are suffixed _icache_off / _icache_on. The cache is
+ *          left enabled. The dispatch is reported per frame count instead of
+ *          bytes.
+ * @date 19/10/2026
+ */
+
+#ifdef BOOTLOADER_BENCHMARK
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "bench.h"
+
+#if defined(__arm__)
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "can_message_handler.h"
+#include "mem.h"
+#include "mem_cache.h"
+#include "sf_bootloader_hal.h"
+
+/* Private defines ------------------------------------------------------------------*/
+#define BENCH_CACHE_CHUNK_BYTES             0x2000U     /* btea_chunk_size */
+#define BENCH_CACHE_DISPATCH_FRAMES         1000U
+#define BENCH_CACHE_DISPATCH_ID             0x0001F1FFU /* In no handler, goes through the whole dispatch */
+
+void __real_btea(uint32_t *v, int n, uint32_t const key[4]);
+
+/* Static Variables -----------------------------------------------------------------*/
+static const uint32_t bench_cache_key[4] = { 0x474657E4, 0x11AC1600, 0x4577F6F4, 0x56F4387D };
+static uint32_t bench_cache_chunk[BENCH_CACHE_CHUNK_BYTES / sizeof(uint32_t)];
+
+/* Private Functions ----------------------------------------------------------------*/
+static void bench_cache_report(const char *kernel, bool cached, uint32_t bytes, uint32_t cycles)
+{
+	char name[40];
+
+	(void)snprintf(name, sizeof(name), "%s_icache_%s", kernel, cached ? "on" : "off");
+	bench_report(name, bytes, cycles);
+}
+
+static void bench_cache_run(bool cached)
+{
+	uint8_t data[CAN_MSG_MAX_LENGTH] = { 0 };
+	can_message_rx_t frame = {
+		.identifier = BENCH_CACHE_DISPATCH_ID,
+		.identifier_type = SF_FDCAN_EXTENDED_ID,
+		.data_length = CAN_MSG_MAX_LENGTH,
+		.data = data,
+	};
+
+	mem_cache_enable(cached);
+
+	memcpy(bench_cache_chunk, (const void *)MEM_APP_START_ADDRESS, sizeof(bench_cache_chunk));
+	uint32_t start = cycle_counter_get();
+	__real_btea(bench_cache_chunk, -(int)(sizeof(bench_cache_chunk) / sizeof(uint32_t)), bench_cache_key);
+	bench_cache_report("btea_decrypt", cached, sizeof(bench_cache_chunk), cycle_counter_get() - start);
+
+	start = cycle_counter_get();
+	(void)sf_bootloader_hal_crc32_func(bench_cache_chunk, sizeof(bench_cache_chunk));
+	bench_cache_report("crc32", cached, sizeof(bench_cache_chunk), cycle_counter_get() - start);
+
+	start = cycle_counter_get();
+	for (uint32_t i = 0; i < BENCH_CACHE_DISPATCH_FRAMES; i++) {
+		can_message_handler_process_frame(&frame, data[CAN_MSG_ECU_CODE_BYTE_INDEX]);
+	}
+	bench_cache_report("can_dispatch", cached, BENCH_CACHE_DISPATCH_FRAMES, cycle_counter_get() - start);
+}
+
+#endif
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @return Number of failed checks
+ */
+int bench_cache(void)
+{
+#if defined(__arm__)
+	bench_cache_run(false);
+	bench_cache_run(true);
+#endif
+
+	return 0;
+}
+
+#endif
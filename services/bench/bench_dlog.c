@@ -0,0 +1,123 @@
+/**
+ * @file bench_dlog.c
+ * @brief Cost of a deferred log record
+ * @details Times DLOG() with no and two arguments and dlog_printf() with two,
+ *          reported per record count instead of bytes, and checks the records
+ *          written, the overwrite of the oldest ones and the drain bookkeeping.
+ *          The ring is restored afterwards, records of the previous run are kept.
+ * @date 19/10/2026
+ */
+
+#ifdef BOOTLOADER_BENCHMARK
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "bench.h"
+#include "dlog.h"
+
+/* Private defines ------------------------------------------------------------------*/
+#define BENCH_DLOG_RECORDS                  (DLOG_RECORD_COUNT * 4U)
+
+/* Static Variables -----------------------------------------------------------------*/
+static dlog_ring_t bench_dlog_saved;
+static const char bench_dlog_printf_fmt[] = "chunk %u at 0x%08x";
+
+/* Private Functions ----------------------------------------------------------------*/
+static void bench_dlog_reset(void)
+{
+	memset(&dlog_ring, 0, sizeof(dlog_ring));
+	dlog_init();
+}
+
+static uint32_t bench_dlog_time(uint32_t kind)
+{
+	uint32_t best = UINT32_MAX;
+
+	for (uint32_t iteration = 0; iteration < BENCH_ITERATIONS; iteration++) {
+		uint32_t start = cycle_counter_get();
+
+		for (uint32_t i = 0; i < BENCH_DLOG_RECORDS; i++) {
+			switch (kind) {
+				case 0:
+					DLOG("bench");
+					break;
+				case 1:
+					DLOG("bench %u %u", i, iteration);
+					break;
+				default:
+					dlog_printf(bench_dlog_printf_fmt, i, iteration);
+					break;
+			}
+		}
+
+		uint32_t cycles = cycle_counter_get() - start;
+		if (cycles < best) {
+			best = cycles;
+		}
+	}
+
+	return best;
+}
+
+static bool bench_dlog_check_records(void)
+{
+	dlog_record_t record;
+	bool passed = true;
+
+	bench_dlog_reset();
+	for (uint32_t i = 0; i < BENCH_DLOG_RECORDS; i++) {
+		DLOG("check %u %u %u", i, ~i, 0x5AU);
+	}
+
+	/* The boot record of dlog_init() and the oldest ones are overwritten */
+	uint32_t head = dlog_ring.head;
+	passed &= (head == BENCH_DLOG_RECORDS + 1U);
+	passed &= (dlog_pending() == DLOG_RECORD_COUNT);
+	passed &= !dlog_read(head - DLOG_RECORD_COUNT - 1U, &record);
+	passed &= !dlog_read(head, &record);
+
+	for (uint32_t index = dlog_first(); index != head; index++) {
+		uint32_t i = index - 1U;
+
+		passed &= dlog_read(index, &record);
+		passed &= ((record.id >> DLOG_ID_ARGC_SHIFT) == 3U);
+		passed &= (record.args[0] == i && record.args[1] == ~i && record.args[2] == 0x5AU);
+	}
+
+	/* dlog_printf() keeps the format address and its arguments */
+	dlog_printf(bench_dlog_printf_fmt, 7U, 0x08040000U);
+	passed &= dlog_read(head, &record);
+	passed &= (record.id == ((((uint32_t)(uintptr_t)bench_dlog_printf_fmt) & DLOG_ID_ADDRESS_MASK) | (2U << DLOG_ID_ARGC_SHIFT)));
+	passed &= (record.args[0] == 7U && record.args[1] == 0x08040000U);
+
+	/* Draining frees the records, a new one is pending again */
+	dlog_release(head);
+	passed &= (dlog_pending() == 0U);
+	DLOG("after drain");
+	passed &= (dlog_pending() == 1U && dlog_first() == head + 1U);
+
+	return passed;
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+int bench_dlog(void)
+{
+	int failures = 0;
+
+	memcpy(&bench_dlog_saved, &dlog_ring, sizeof(dlog_ring));
+	bench_dlog_reset();
+
+	bench_report("dlog_0_args", BENCH_DLOG_RECORDS, bench_dlog_time(0));
+	bench_report("dlog_2_args", BENCH_DLOG_RECORDS, bench_dlog_time(1));
+	bench_report("dlog_printf_2_args", BENCH_DLOG_RECORDS, bench_dlog_time(2));
+
+	failures += bench_check("dlog_records", bench_dlog_check_records()) ? 0 : 1;
+
+	memcpy(&dlog_ring, &bench_dlog_saved, sizeof(dlog_ring));
+
+	return failures;
+}
+
+#endif
@@ -0,0 +1,82 @@
+/**
+ * @file bench_ecdsa.c
+ * @brief ECDSA P-256 verification: fixed-key backend against tinycrypt
+ * @details Both backends must accept the test vector and reject it once the hash
+ *          or the signature is altered; then one verification of each is timed.
+ * @date 19/10/2026
+ */
+
+#ifdef BOOTLOADER_BENCHMARK
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include <tinycrypt/constants.h>
+#include <tinycrypt/ecc_dsa.h>
+#include "bench.h"
+#include "bench_ecdsa_vector.h"
+#include "p256_verify.h"
+
+/* On target uECC_verify() is wrapped, tinycrypt itself is __real_uECC_verify() */
+#if defined(__arm__)
+int __real_uECC_verify(const uint8_t *public_key, const uint8_t *message_hash, unsigned hash_size,
+		const uint8_t *signature, uECC_Curve curve);
+#define uecc_verify_reference               __real_uECC_verify
+#else
+#define uecc_verify_reference               uECC_verify
+#endif
+
+/* Private Functions ----------------------------------------------------------------*/
+static bool bench_ecdsa_tinycrypt(const uint8_t *hash, const uint8_t *signature)
+{
+	return uecc_verify_reference(bench_ecdsa_public_key, hash, 32U, signature, uECC_secp256r1()) == TC_CRYPTO_SUCCESS;
+}
+
+static bool bench_ecdsa_fixed(const uint8_t *hash, const uint8_t *signature)
+{
+	return p256_verify_fixed(bench_ecdsa_public_key, hash, signature) == P256_VERIFY_OK;
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @return Number of failed checks
+ */
+int bench_ecdsa(void)
+{
+	uint8_t hash[sizeof(bench_ecdsa_hash)];
+	uint8_t signature[sizeof(bench_ecdsa_signature)];
+	bool tinycrypt_passed = bench_ecdsa_tinycrypt(bench_ecdsa_hash, bench_ecdsa_signature);
+	bool fixed_passed = bench_ecdsa_fixed(bench_ecdsa_hash, bench_ecdsa_signature);
+	int failures = 0;
+
+	memcpy(hash, bench_ecdsa_hash, sizeof(hash));
+	hash[0] ^= 0x01U;
+	tinycrypt_passed = tinycrypt_passed && !bench_ecdsa_tinycrypt(hash, bench_ecdsa_signature);
+	fixed_passed = fixed_passed && !bench_ecdsa_fixed(hash, bench_ecdsa_signature);
+
+	memcpy(signature, bench_ecdsa_signature, sizeof(signature));
+	signature[63] ^= 0x80U;
+	tinycrypt_passed = tinycrypt_passed && !bench_ecdsa_tinycrypt(bench_ecdsa_hash, signature);
+	fixed_passed = fixed_passed && !bench_ecdsa_fixed(bench_ecdsa_hash, signature);
+
+	failures += bench_check("ecdsa_tinycrypt", tinycrypt_passed) ? 0 : 1;
+	failures += bench_check("ecdsa_p256_fixed", fixed_passed) ? 0 : 1;
+
+	uint32_t start = cycle_counter_get();
+	(void)bench_ecdsa_tinycrypt(bench_ecdsa_hash, bench_ecdsa_signature);
+	bench_report("ecdsa_verify_tinycrypt", sizeof(bench_ecdsa_hash), cycle_counter_get() - start);
+
+	uint32_t best = UINT32_MAX;
+	for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+		start = cycle_counter_get();
+		(void)bench_ecdsa_fixed(bench_ecdsa_hash, bench_ecdsa_signature);
+		uint32_t elapsed = cycle_counter_get() - start;
+		best = (elapsed < best) ? elapsed : best;
+	}
+	bench_report("ecdsa_verify_p256_fixed", sizeof(bench_ecdsa_hash), best);
+
+	return failures;
+}
+
+#endif
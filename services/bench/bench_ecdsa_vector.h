@@ -0,0 +1,31 @@
+/**
+ * @file bench_ecdsa_vector.h
+ * @brief P-256 signature made with the benchmark test key
+ * @details Generated by tools/p256_tables/gen_p256_tables.py, do not edit.
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Public Variables -----------------------------------------------------------------*/
+static const uint8_t bench_ecdsa_public_key[64] = {
+    0xab, 0x50, 0x08, 0x53, 0x77, 0xaf, 0x8d, 0xe5, 0x70, 0x7e, 0x6c, 0x52, 0xcc, 0xc6, 0x03, 0x9d,
+    0x07, 0xac, 0x56, 0xf1, 0x68, 0x61, 0x9a, 0xe9, 0xaa, 0xa8, 0xaf, 0x65, 0x5d, 0xba, 0x62, 0x49,
+    0xa6, 0x2a, 0x1e, 0xa6, 0xdf, 0x49, 0xd7, 0x8d, 0x78, 0xd2, 0xda, 0x69, 0x51, 0xa8, 0xfe, 0xdc,
+    0xef, 0x6a, 0x37, 0xb5, 0x2a, 0x30, 0x4b, 0xe8, 0x65, 0x9e, 0xca, 0x4d, 0x02, 0x96, 0x3c, 0x58,
+};
+
+/* SHA-256("varg bootloader p256 benchmark message") */
+static const uint8_t bench_ecdsa_hash[32] = {
+    0x40, 0x6c, 0x26, 0xe1, 0x04, 0x5c, 0x8d, 0xce, 0x79, 0x04, 0xc2, 0xde, 0xcc, 0xf5, 0x31, 0xbc,
+    0x0f, 0x50, 0xe3, 0x68, 0xb3, 0xa6, 0xfa, 0xbc, 0xbe, 0xef, 0x81, 0xf0, 0x20, 0xef, 0x83, 0x60,
+};
+
+static const uint8_t bench_ecdsa_signature[64] = {
+    0x6f, 0xb4, 0x89, 0x86, 0xdd, 0xc0, 0xff, 0x99, 0x21, 0x1d, 0xa9, 0x45, 0x20, 0xb0, 0xe0, 0x83,
+    0xa0, 0x67, 0xcb, 0x23, 0x2f, 0xd5, 0xc0, 0x02, 0xb3, 0x05, 0x74, 0xdd, 0xf2, 0xc0, 0x2f, 0x80,
+    0x27, 0x58, 0x91, 0x41, 0x8f, 0xbb, 0x4a, 0xfd, 0xea, 0xa1, 0x2b, 0x35, 0x6b, 0x58, 0x83, 0xad,
+    0xe9, 0xb9, 0x92, 0x3a, 0xb4, 0xa2, 0x47, 0xb0, 0x94, 0x4d, 0xce, 0xb8, 0x50, 0x11, 0x35, 0x09,
+};
@@ -0,0 +1,64 @@
+/**
+ * @file bench_ed25519.c
+ * @brief Ed25519 verification: RFC 8032 known answers and verify time
+ * @details Every test vector must verify, and must fail once R or S is altered.
+ * @date 19/10/2026
+ */
+
+#ifdef BOOTLOADER_BENCHMARK
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "bench.h"
+#include "bench_ed25519_vector.h"
+#include "ed25519.h"
+
+/* Private Functions ----------------------------------------------------------------*/
+static int bench_ed25519_verify(const bench_ed25519_vector_t *vector, const uint8_t *signature)
+{
+	ed25519_public_key_t key;
+
+	memcpy(key.key, vector->public_key, sizeof(key.key));
+	return ed25519_verify(&key, vector->message, vector->message_size, signature);
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @return Number of failed checks
+ */
+int bench_ed25519(void)
+{
+	uint8_t signature[ED25519_SIGNATURE_SIZE];
+	bool passed = true;
+
+	for (uint32_t i = 0; i < (sizeof(bench_ed25519_vectors) / sizeof(bench_ed25519_vectors[0])); i++) {
+		const bench_ed25519_vector_t *vector = &bench_ed25519_vectors[i];
+
+		passed = passed && (bench_ed25519_verify(vector, vector->signature) == ED25519_VERIFY_OK);
+
+		memcpy(signature, vector->signature, sizeof(signature));
+		signature[0] ^= 0x01U;
+		passed = passed && (bench_ed25519_verify(vector, signature) != ED25519_VERIFY_OK);
+
+		memcpy(signature, vector->signature, sizeof(signature));
+		signature[32] ^= 0x01U;
+		passed = passed && (bench_ed25519_verify(vector, signature) != ED25519_VERIFY_OK);
+	}
+
+	int failures = bench_check("ed25519_rfc8032", passed) ? 0 : 1;
+
+	uint32_t best = UINT32_MAX;
+	for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+		uint32_t start = cycle_counter_get();
+		(void)bench_ed25519_verify(&bench_ed25519_vectors[2], bench_ed25519_vectors[2].signature);
+		uint32_t elapsed = cycle_counter_get() - start;
+		best = (elapsed < best) ? elapsed : best;
+	}
+	bench_report("ed25519_verify", bench_ed25519_vectors[2].message_size, best);
+
+	return failures;
+}
+
+#endif
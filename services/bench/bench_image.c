@@ -0,0 +1,226 @@
+/**
+ * @file bench_image.c
+ * @brief Integrity and decryption kernels over update-sized buffers
+ * @details Times every kernel on one update chunk (8 KB) and on a whole
+ *          application slot (456 KB) so the results read directly as the cost of
+ *          a burst and of an image:
+ *            - crc32 (sf_bootloader_hal_crc32_func) and crc16
+ *              (sf_crc_compute_crc16_deadbeef), target only as both run on the CRC
+ *              peripheral through sf_hal_stm32h5; crc32_cpu and crc32_dma are the
+ *              words written by the core and fed by GPDMA (crc.c), the latter
+ *              being the image CRC of the core, with the rate of each over the
+ *              slot;
+ *            - BTEA decryption, chunk by chunk as the core does it, with the fw-utils
+ *              implementation and the optimized kernel;
+ *            - SHA-256 with tinycrypt and the optimized update;
+ *            - the image signature check, SHA-256 of the slot followed by ECDSA
+ *              P-256 verification, with tinycrypt and the fixed-key backend.
+ *          On target the slot is read from the application FLASH area, on the host
+ *          from a RAM buffer of the same size.
+ * @date 19/10/2026
+ */
+
+#ifdef BOOTLOADER_BENCHMARK
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include <tinycrypt/constants.h>
+#include <tinycrypt/ecc_dsa.h>
+#include <tinycrypt/sha256.h>
+#include "bench.h"
+#include "bench_ecdsa_vector.h"
+#include "btea.h"
+#include "btea_fast.h"
+#include "p256_verify.h"
+#include "sha256_fast.h"
+#if defined(__arm__)
+#include "mem.h"
+#include "sf_bootloader_hal.h"
+#include "sf_crc_hal.h"
+#include "crc.h"
+#endif
+
+/* Private defines ------------------------------------------------------------------*/
+#define BENCH_IMAGE_CHUNK_BYTES             0x2000U     /* btea_chunk_size */
+#define BENCH_IMAGE_BYTES                   0x72000U    /* MEM_APP_END_ADDRESS - MEM_APP_START_ADDRESS */
+#define BENCH_IMAGE_CHUNK_WORDS             (BENCH_IMAGE_CHUNK_BYTES / sizeof(uint32_t))
+
+/* On target the reference implementations are reached through __real_ */
+#if defined(__arm__)
+void __real_btea(uint32_t *v, int n, uint32_t const key[4]);
+int __real_tc_sha256_update(TCSha256State_t s, const uint8_t *data, size_t datalen);
+int __real_uECC_verify(const uint8_t *public_key, const uint8_t *message_hash, unsigned hash_size,
+		const uint8_t *signature, uECC_Curve curve);
+#define btea_reference                      __real_btea
+#define sha256_reference_update             __real_tc_sha256_update
+#define uecc_verify_reference               __real_uECC_verify
+#else
+#define btea_reference                      btea
+#define sha256_reference_update             tc_sha256_update
+#define uecc_verify_reference               uECC_verify
+#endif
+
+#if defined(__arm__)
+_Static_assert(BENCH_IMAGE_BYTES == (MEM_APP_END_ADDRESS - MEM_APP_START_ADDRESS), "Image size must match the application slot");
+#define bench_image_data                    ((const uint8_t *)MEM_APP_START_ADDRESS)
+#else
+static uint8_t bench_image_buffer[BENCH_IMAGE_BYTES];
+#define bench_image_data                    bench_image_buffer
+#endif
+
+/* Private Types --------------------------------------------------------------------*/
+typedef int (*bench_image_sha256_t)(TCSha256State_t s, const uint8_t *data, size_t datalen);
+
+/* Static Variables -----------------------------------------------------------------*/
+static const uint32_t bench_image_key[4] = { 0x474657E4, 0x11AC1600, 0x4577F6F4, 0x56F4387D };
+static uint32_t bench_image_chunk[BENCH_IMAGE_CHUNK_WORDS];
+
+/* Private Functions ----------------------------------------------------------------*/
+#if defined(__arm__)
+/**
+ * @brief A CRC must be repeatable and change when a single bit of the input does.
+ */
+static bool bench_image_crc_check(uint32_t (*crc)(const void *data, uint32_t size))
+{
+	uint8_t *bytes = (uint8_t *)bench_image_chunk;
+
+	memcpy(bench_image_chunk, bench_image_data, sizeof(bench_image_chunk));
+	uint32_t first = crc(bench_image_chunk, sizeof(bench_image_chunk));
+	uint32_t again = crc(bench_image_chunk, sizeof(bench_image_chunk));
+	bytes[sizeof(bench_image_chunk) / 2U] ^= 0x01U;
+	uint32_t flipped = crc(bench_image_chunk, sizeof(bench_image_chunk));
+
+	return (first == again) && (first != flipped);
+}
+
+static uint32_t bench_image_crc16(const void *data, uint32_t size)
+{
+	return sf_crc_compute_crc16_deadbeef(data, size);
+}
+
+static uint32_t bench_image_crc32(const void *data, uint32_t size)
+{
+	return sf_bootloader_hal_crc32_func(data, size);
+}
+
+static uint32_t bench_image_crc32_cpu(const void *data, uint32_t size)
+{
+	return crc32_continue(CRC32_INIT_VALUE, data, size);
+}
+
+static uint32_t bench_image_crc32_dma(const void *data, uint32_t size)
+{
+	return crc32_continue_dma(CRC32_INIT_VALUE, data, size);
+}
+
+/* Both paths over the CRC unit give the CRC of the HAL, on RAM and on FLASH */
+static bool bench_image_crc32_same(void)
+{
+	uint32_t reference = bench_image_crc32(bench_image_data, BENCH_IMAGE_BYTES);
+
+	memcpy(bench_image_chunk, bench_image_data, sizeof(bench_image_chunk));
+
+	return (bench_image_crc32_cpu(bench_image_data, BENCH_IMAGE_BYTES) == reference) &&
+			(bench_image_crc32_dma(bench_image_data, BENCH_IMAGE_BYTES) == reference) &&
+			(bench_image_crc32_dma(bench_image_chunk, sizeof(bench_image_chunk)) ==
+					bench_image_crc32(bench_image_chunk, sizeof(bench_image_chunk)));
+}
+
+static void bench_image_crc(const char *name, uint32_t (*crc)(const void *data, uint32_t size))
+{
+	uint32_t start = cycle_counter_get();
+	(void)crc(bench_image_chunk, sizeof(bench_image_chunk));
+	bench_report(name, sizeof(bench_image_chunk), cycle_counter_get() - start);
+
+	start = cycle_counter_get();
+	(void)crc(bench_image_data, BENCH_IMAGE_BYTES);
+	uint32_t cycles = cycle_counter_get() - start;
+	bench_report(name, BENCH_IMAGE_BYTES, cycles);
+	bench_report_rate(name, BENCH_IMAGE_BYTES, cycles);
+}
+#endif
+
+/**
+ * @brief Decrypt the slot chunk by chunk, as received, into the chunk buffer.
+ */
+static uint32_t bench_image_btea(bool fast)
+{
+	uint32_t start = cycle_counter_get();
+
+	for (uint32_t offset = 0; offset < BENCH_IMAGE_BYTES; offset += BENCH_IMAGE_CHUNK_BYTES) {
+		memcpy(bench_image_chunk, &bench_image_data[offset], BENCH_IMAGE_CHUNK_BYTES);
+		if (fast) {
+			btea_fast_decrypt(bench_image_chunk, BENCH_IMAGE_CHUNK_WORDS, bench_image_key);
+		} else {
+			btea_reference(bench_image_chunk, -(int)BENCH_IMAGE_CHUNK_WORDS, bench_image_key);
+		}
+	}
+
+	return cycle_counter_get() - start;
+}
+
+static void bench_image_sha256(bench_image_sha256_t update, uint8_t digest[TC_SHA256_DIGEST_SIZE])
+{
+	struct tc_sha256_state_struct state;
+
+	(void)tc_sha256_init(&state);
+	(void)update(&state, bench_image_data, BENCH_IMAGE_BYTES);
+	(void)tc_sha256_final(digest, &state);
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @return Number of failed checks
+ */
+int bench_image(void)
+{
+	uint8_t reference[TC_SHA256_DIGEST_SIZE];
+	uint8_t fast[TC_SHA256_DIGEST_SIZE];
+	int failures = 0;
+
+#if defined(__arm__)
+	failures += bench_check("crc32", bench_image_crc_check(bench_image_crc32)) ? 0 : 1;
+	failures += bench_check("crc16", bench_image_crc_check(bench_image_crc16)) ? 0 : 1;
+	failures += bench_check("crc32_dma", bench_image_crc32_same()) ? 0 : 1;
+	bench_image_crc("crc32", bench_image_crc32);
+	bench_image_crc("crc32_cpu", bench_image_crc32_cpu);
+	bench_image_crc("crc32_dma", bench_image_crc32_dma);
+	bench_image_crc("crc16", bench_image_crc16);
+#else
+	uint32_t seed = BENCH_IMAGE_BYTES;
+	for (uint32_t i = 0; i < BENCH_IMAGE_BYTES; i++) {
+		seed = (seed * 1664525UL) + 1013904223UL;
+		bench_image_buffer[i] = (uint8_t)(seed >> 24);
+	}
+#endif
+
+	bench_report("btea_decrypt", BENCH_IMAGE_BYTES, bench_image_btea(false));
+	bench_report("btea_fast_decrypt", BENCH_IMAGE_BYTES, bench_image_btea(true));
+
+	uint32_t start = cycle_counter_get();
+	bench_image_sha256(sha256_reference_update, reference);
+	bench_report("sha256_tinycrypt", BENCH_IMAGE_BYTES, cycle_counter_get() - start);
+
+	start = cycle_counter_get();
+	bench_image_sha256(sha256_fast_update, fast);
+	bench_report("sha256_fast", BENCH_IMAGE_BYTES, cycle_counter_get() - start);
+
+	failures += bench_check("sha256_image", memcmp(reference, fast, sizeof(fast)) == 0) ? 0 : 1;
+
+	/* The signature does not match this image, the verification runs to the end anyway */
+	start = cycle_counter_get();
+	bench_image_sha256(sha256_reference_update, reference);
+	(void)uecc_verify_reference(bench_ecdsa_public_key, reference, sizeof(reference), bench_ecdsa_signature, uECC_secp256r1());
+	bench_report("image_verify_tinycrypt", BENCH_IMAGE_BYTES, cycle_counter_get() - start);
+
+	start = cycle_counter_get();
+	bench_image_sha256(sha256_fast_update, fast);
+	(void)p256_verify_fixed(bench_ecdsa_public_key, fast, bench_ecdsa_signature);
+	bench_report("image_verify_p256_fixed", BENCH_IMAGE_BYTES, cycle_counter_get() - start);
+
+	return failures;
+}
+
+#endif
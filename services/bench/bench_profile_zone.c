@@ -0,0 +1,93 @@
+/**
+ * @file bench_profile_zone.c
+ * @brief Cost of a profiling zone
+ * @details Times an empty PROFILE_ZONE_BEGIN() / PROFILE_ZONE_END() pair, reported
+ *          per zone run instead of bytes, and checks the statistics kept for known
+ *          cycle counts. The table is restored afterwards. Nothing is run when
+ *          profiling is not built.
+ * @date 19/10/2026
+ */
+
+#ifdef BOOTLOADER_BENCHMARK
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "bench.h"
+#include "profile_zone.h"
+
+#if BOOTLOADER_PROFILING
+
+/* Private defines ------------------------------------------------------------------*/
+#define BENCH_PROFILE_ZONE_RUNS             256U
+
+/* Static Variables -----------------------------------------------------------------*/
+static profile_zone_stats_t bench_profile_zone_saved[PROFILE_ZONE_COUNT];
+
+/* Private Functions ----------------------------------------------------------------*/
+static uint32_t bench_profile_zone_time(void)
+{
+	uint32_t best = UINT32_MAX;
+
+	for (uint32_t iteration = 0; iteration < BENCH_ITERATIONS; iteration++) {
+		uint32_t start = cycle_counter_get();
+
+		for (uint32_t i = 0; i < BENCH_PROFILE_ZONE_RUNS; i++) {
+			PROFILE_ZONE_BEGIN(PROFILE_ZONE_CAN_FRAME);
+			__asm__ volatile("" ::: "memory");
+			PROFILE_ZONE_END(PROFILE_ZONE_CAN_FRAME);
+		}
+
+		uint32_t cycles = cycle_counter_get() - start;
+		if (cycles < best) {
+			best = cycles;
+		}
+	}
+
+	return best;
+}
+
+static bool bench_profile_zone_check_stats(void)
+{
+	uint32_t cycles_per_us = cycle_counter_hz() / 1000000U;
+	bool passed = true;
+
+	profile_zone_reset();
+	passed &= (profile_zone_get(PROFILE_ZONE_CRC, PROFILE_ZONE_VALUE_CALLS) == 0U);
+
+	profile_zone_record(PROFILE_ZONE_CRC, 20U * cycles_per_us);
+	profile_zone_record(PROFILE_ZONE_CRC, 10U * cycles_per_us);
+	profile_zone_record(PROFILE_ZONE_CRC, 30U * cycles_per_us);
+
+	passed &= (profile_zone_get(PROFILE_ZONE_CRC, PROFILE_ZONE_VALUE_CALLS) == 3U);
+	passed &= (profile_zone_get(PROFILE_ZONE_CRC, PROFILE_ZONE_VALUE_MIN_CYCLES) == 10U * cycles_per_us);
+	passed &= (profile_zone_get(PROFILE_ZONE_CRC, PROFILE_ZONE_VALUE_MAX_CYCLES) == 30U * cycles_per_us);
+	passed &= (profile_zone_get(PROFILE_ZONE_CRC, PROFILE_ZONE_VALUE_TOTAL_US) == 60U);
+
+	/* Other zones are left alone */
+	passed &= (profile_zone_get(PROFILE_ZONE_DECRYPT, PROFILE_ZONE_VALUE_CALLS) == 0U);
+
+	return passed;
+}
+
+#endif
+
+/* Public Functions -----------------------------------------------------------------*/
+int bench_profile_zone(void)
+{
+	int failures = 0;
+
+#if BOOTLOADER_PROFILING
+	memcpy(bench_profile_zone_saved, profile_zone_table, sizeof(profile_zone_table));
+
+	bench_report("profile_zone_pair", BENCH_PROFILE_ZONE_RUNS, bench_profile_zone_time());
+	failures += bench_check("profile_zone_stats", bench_profile_zone_check_stats()) ? 0 : 1;
+
+	memcpy(profile_zone_table, bench_profile_zone_saved, sizeof(profile_zone_table));
+#endif
+
+	return failures;
+}
+
+#endif
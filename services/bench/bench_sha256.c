@@ -0,0 +1,183 @@
+/**
+ * @file bench_sha256.c
+ * @brief SHA-256: optimized block function against tinycrypt
+ * @details Both implementations must reproduce the FIPS 180-2 example digests
+ *          (the million 'a' one is fed in 1000 byte pieces). The optimized one must
+ *          then match tinycrypt on random data split at random points, from aligned
+ *          and unaligned buffers. Both are timed on one update chunk.
+ * @date 19/10/2026
+ */
+
+#ifdef BOOTLOADER_BENCHMARK
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include <tinycrypt/constants.h>
+#include <tinycrypt/sha256.h>
+#include "bench.h"
+#include "sha256_fast.h"
+
+/* Private defines ------------------------------------------------------------------*/
+#define BENCH_SHA256_BYTES                  0x2000U    /* btea_chunk_size */
+#define BENCH_SHA256_MILLION_PIECE          1000U
+
+/* On target tc_sha256_update() is wrapped, tinycrypt itself is __real_tc_sha256_update() */
+#if defined(__arm__)
+int __real_tc_sha256_update(TCSha256State_t s, const uint8_t *data, size_t datalen);
+#define sha256_reference_update             __real_tc_sha256_update
+#else
+#define sha256_reference_update             tc_sha256_update
+#endif
+
+/* Private Types --------------------------------------------------------------------*/
+typedef int (*bench_sha256_update_t)(TCSha256State_t s, const uint8_t *data, size_t datalen);
+
+typedef struct {
+	const char *message;
+	uint32_t repeat;
+	uint8_t digest[TC_SHA256_DIGEST_SIZE];
+} bench_sha256_vector_t;
+
+/* Static Variables -----------------------------------------------------------------*/
+static const bench_sha256_vector_t bench_sha256_vectors[] = {
+	{ "", 1U, {
+		0xE3, 0xB0, 0xC4, 0x42, 0x98, 0xFC, 0x1C, 0x14, 0x9A, 0xFB, 0xF4, 0xC8, 0x99, 0x6F, 0xB9, 0x24,
+		0x27, 0xAE, 0x41, 0xE4, 0x64, 0x9B, 0x93, 0x4C, 0xA4, 0x95, 0x99, 0x1B, 0x78, 0x52, 0xB8, 0x55 } },
+	{ "abc", 1U, {
+		0xBA, 0x78, 0x16, 0xBF, 0x8F, 0x01, 0xCF, 0xEA, 0x41, 0x41, 0x40, 0xDE, 0x5D, 0xAE, 0x22, 0x23,
+		0xB0, 0x03, 0x61, 0xA3, 0x96, 0x17, 0x7A, 0x9C, 0xB4, 0x10, 0xFF, 0x61, 0xF2, 0x00, 0x15, 0xAD } },
+	{ "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 1U, {
+		0x24, 0x8D, 0x6A, 0x61, 0xD2, 0x06, 0x38, 0xB8, 0xE5, 0xC0, 0x26, 0x93, 0x0C, 0x3E, 0x60, 0x39,
+		0xA3, 0x3C, 0xE4, 0x59, 0x64, 0xFF, 0x21, 0x67, 0xF6, 0xEC, 0xED, 0xD4, 0x19, 0xDB, 0x06, 0xC1 } },
+	{ NULL, BENCH_SHA256_MILLION_PIECE, {    /* 1000000 x 'a' */
+		0xCD, 0xC7, 0x6E, 0x5C, 0x99, 0x14, 0xFB, 0x92, 0x81, 0xA1, 0xC7, 0xE2, 0x84, 0xD7, 0x3E, 0x67,
+		0xF1, 0x80, 0x9A, 0x48, 0xA4, 0x97, 0x20, 0x0E, 0x04, 0x6D, 0x39, 0xCC, 0xC7, 0x11, 0x2C, 0xD0 } },
+};
+
+/* Word aligned, one spare word for the unaligned runs */
+static uint32_t bench_sha256_buffer[(BENCH_SHA256_BYTES / sizeof(uint32_t)) + 1U];
+
+/* Private Functions ----------------------------------------------------------------*/
+static void bench_sha256_digest(bench_sha256_update_t update, const uint8_t *data, uint32_t size,
+		uint32_t repeat, uint8_t digest[TC_SHA256_DIGEST_SIZE])
+{
+	struct tc_sha256_state_struct state;
+
+	(void)tc_sha256_init(&state);
+	for (uint32_t i = 0; i < repeat; i++) {
+		(void)update(&state, data, size);
+	}
+	(void)tc_sha256_final(digest, &state);
+}
+
+static bool bench_sha256_vector(bench_sha256_update_t update, const bench_sha256_vector_t *vector)
+{
+	uint8_t *data = (uint8_t *)bench_sha256_buffer;
+	uint8_t digest[TC_SHA256_DIGEST_SIZE];
+	uint32_t size;
+
+	if (vector->message != NULL) {
+		size = (uint32_t)strlen(vector->message);
+		memcpy(data, vector->message, size);
+	} else {
+		size = BENCH_SHA256_MILLION_PIECE;
+		memset(data, 'a', size);
+	}
+
+	bench_sha256_digest(update, data, size, vector->repeat, digest);
+	return memcmp(digest, vector->digest, sizeof(digest)) == 0;
+}
+
+/**
+ * @brief Hash size bytes at the given offset in one go with tinycrypt and in pieces
+ *        of pseudo-random length with the optimized update, and compare.
+ */
+static bool bench_sha256_compare(uint32_t offset, uint32_t size, uint32_t seed)
+{
+	const uint8_t *data = (const uint8_t *)bench_sha256_buffer + offset;
+	struct tc_sha256_state_struct state;
+	uint8_t reference[TC_SHA256_DIGEST_SIZE];
+	uint8_t fast[TC_SHA256_DIGEST_SIZE];
+	uint32_t done = 0;
+
+	bench_sha256_digest(sha256_reference_update, data, size, 1U, reference);
+
+	(void)tc_sha256_init(&state);
+	while (done < size) {
+		seed = (seed * 1664525UL) + 1013904223UL;
+		uint32_t piece = (seed >> 16) % 200U;
+		piece = (piece > (size - done)) ? (size - done) : piece;
+		(void)sha256_fast_update(&state, &data[done], piece);
+		done += piece;
+	}
+	(void)tc_sha256_final(fast, &state);
+
+	return memcmp(fast, reference, sizeof(fast)) == 0;
+}
+
+static uint32_t bench_sha256_time(bench_sha256_update_t update, uint32_t offset)
+{
+	const uint8_t *data = (const uint8_t *)bench_sha256_buffer + offset;
+	struct tc_sha256_state_struct state;
+	uint32_t best = UINT32_MAX;
+
+	for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+		(void)tc_sha256_init(&state);
+		uint32_t start = cycle_counter_get();
+		(void)update(&state, data, BENCH_SHA256_BYTES);
+		uint32_t elapsed = cycle_counter_get() - start;
+		best = (elapsed < best) ? elapsed : best;
+	}
+
+	return best;
+}
+
+static void bench_sha256_report(const char *name, uint32_t cycles)
+{
+	bench_report(name, BENCH_SHA256_BYTES, cycles);
+	bench_report_rate(name, BENCH_SHA256_BYTES, cycles);
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @return Number of failed checks
+ */
+int bench_sha256(void)
+{
+	static const uint32_t sizes[] = { 0, 1, 55, 56, 63, 64, 65, 119, 120, 127, 128, 1000, BENCH_SHA256_BYTES };
+	bool reference_passed = true;
+	bool fast_passed = true;
+	int failures = 0;
+
+	for (uint32_t i = 0; i < (sizeof(bench_sha256_vectors) / sizeof(bench_sha256_vectors[0])); i++) {
+		reference_passed = bench_sha256_vector(sha256_reference_update, &bench_sha256_vectors[i]) && reference_passed;
+		fast_passed = bench_sha256_vector(sha256_fast_update, &bench_sha256_vectors[i]) && fast_passed;
+	}
+	failures += bench_check("sha256_tinycrypt_nist", reference_passed) ? 0 : 1;
+	failures += bench_check("sha256_fast_nist", fast_passed) ? 0 : 1;
+
+	uint32_t seed = 0x5EEDU;
+	uint8_t *bytes = (uint8_t *)bench_sha256_buffer;
+	for (uint32_t i = 0; i < sizeof(bench_sha256_buffer); i++) {
+		seed = (seed * 1664525UL) + 1013904223UL;
+		bytes[i] = (uint8_t)(seed >> 24);
+	}
+
+	fast_passed = true;
+	for (uint32_t offset = 0; offset < sizeof(uint32_t); offset++) {
+		for (uint32_t i = 0; i < (sizeof(sizes) / sizeof(sizes[0])); i++) {
+			fast_passed = bench_sha256_compare(offset, sizes[i], sizes[i] + offset) && fast_passed;
+		}
+	}
+	failures += bench_check("sha256_fast_tinycrypt", fast_passed) ? 0 : 1;
+
+	bench_sha256_report("sha256_tinycrypt", bench_sha256_time(sha256_reference_update, 0U));
+	bench_sha256_report("sha256_fast", bench_sha256_time(sha256_fast_update, 0U));
+	bench_sha256_report("sha256_fast_unaligned", bench_sha256_time(sha256_fast_update, 1U));
+
+	return failures;
+}
+
+#endif
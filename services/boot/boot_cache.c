@@ -0,0 +1,360 @@
+/**
+ * @file boot_cache.c
+ * @brief Cached application verification verdict
+ * @details Every record is one FLASH quad-word so it can be programmed on its own
+ *          into the erased part of the sector:
+ *            - GENERATION: the flash write generation was bumped
+ *            - IMAGE END:  end of the application image, for the verdict that follows
+ *            - VERDICT:    the application passed a full verification at a generation
+ *            - BOOT:       boots that reused the verdict, written once per power-on
+ *          The state is rebuilt at init by replaying the records in order.
+ *          The boots that reused the verdict are counted in .noinit RAM, kept over a
+ *          reset. When that count is lost (power-on, RAM reused by the application)
+ *          it is taken from the last BOOT record and the fast boot appends a new one,
+ *          so only the first fast boot after a power-on writes to FLASH.
+ * @date 19/10/2026
+ */
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "boot_cache.h"
+#include "crc.h"
+
+/* Private defines ------------------------------------------------------------------*/
+#define BOOT_CACHE_RECORD_GENERATION        0x314E4547U     /* "GEN1" */
+#define BOOT_CACHE_RECORD_VERDICT           0x31445256U     /* "VRD1" */
+#define BOOT_CACHE_RECORD_IMAGE_END         0x31444E45U     /* "END1" */
+#define BOOT_CACHE_RECORD_BOOT              0x31544F42U     /* "BOT1" */
+#define BOOT_CACHE_RECORD_ERASED            0xFFFFFFFFU
+#define BOOT_CACHE_ERASED_WORD              0xFFFFFFFFU
+
+#define BOOT_CACHE_BOOTS_MAGIC              0x53544F42U     /* "BOTS" */
+
+/* 16 system and 131 interrupt vectors of the STM32H563, up to a quad-word */
+#define BOOT_CACHE_VECTOR_TABLE_SIZE        0x250U
+
+/* Private types --------------------------------------------------------------------*/
+typedef struct {
+	uint32_t type;
+	uint32_t generation;
+	uint32_t value;
+	uint32_t check;
+} boot_cache_record_t;
+
+typedef struct {
+	uint32_t next_address;          /* First erased record slot */
+	uint32_t generation;            /* Current flash write generation */
+	uint32_t verdict_generation;    /* Generation at which the verdict was recorded */
+	uint32_t verdict_key;           /* Key of the application image at that time */
+	uint32_t verdict_image_end;     /* End of the application image at that time */
+	uint32_t image_end;             /* Last IMAGE END record replayed */
+	uint32_t fast_boots;            /* Boots that reused the verdict, as last written to FLASH */
+	bool verdict_valid;
+	bool generation_bumped;         /* The generation was already bumped during this boot */
+} boot_cache_state_t;
+
+/* Kept over a reset, only trusted for the verdict it was counted for */
+typedef struct {
+	uint32_t magic;
+	uint32_t generation;
+	uint32_t key;
+	uint32_t fast_boots;            /* Boots that reused the verdict since it was recorded */
+	uint32_t check;
+} boot_cache_boots_t;
+
+/* Static Variables -----------------------------------------------------------------*/
+static boot_cache_state_t boot_cache;
+__attribute__((section(".noinit"))) static boot_cache_boots_t boot_cache_boots;
+
+/* Private Functions ----------------------------------------------------------------*/
+static uint32_t boot_cache_record_check(const boot_cache_record_t *record)
+{
+	return ~(record->type ^ record->generation ^ record->value);
+}
+
+static uint32_t boot_cache_boots_check(const boot_cache_boots_t *boots)
+{
+	return ~(boots->magic ^ boots->generation ^ boots->key ^ boots->fast_boots);
+}
+
+static void boot_cache_boots_set(uint32_t fast_boots)
+{
+	boot_cache_boots.magic = BOOT_CACHE_BOOTS_MAGIC;
+	boot_cache_boots.generation = boot_cache.verdict_generation;
+	boot_cache_boots.key = boot_cache.verdict_key;
+	boot_cache_boots.fast_boots = fast_boots;
+	boot_cache_boots.check = boot_cache_boots_check(&boot_cache_boots);
+}
+
+/* The RAM count was kept over a reset and belongs to the current verdict */
+static bool boot_cache_boots_valid(void)
+{
+	return boot_cache_boots.magic == BOOT_CACHE_BOOTS_MAGIC && boot_cache_boots.check == boot_cache_boots_check(&boot_cache_boots) &&
+			boot_cache_boots.generation == boot_cache.verdict_generation && boot_cache_boots.key == boot_cache.verdict_key;
+}
+
+/* Boots that reused the current verdict, from FLASH when the RAM count was lost */
+static uint32_t boot_cache_boots_get(void)
+{
+	return boot_cache_boots_valid() ? boot_cache_boots.fast_boots : boot_cache.fast_boots;
+}
+
+/* End of the last quad-word programmed in the application area */
+static uint32_t boot_cache_find_image_end(void)
+{
+	uint32_t words[MEM_FLASH_QUAD_WORD_SIZE / sizeof(uint32_t)];
+
+	for (uint32_t address = MEM_APP_END_ADDRESS; address > MEM_APP_START_ADDRESS + BOOT_CACHE_VECTOR_TABLE_SIZE;
+			address -= MEM_FLASH_QUAD_WORD_SIZE) {
+		if (mem_read(address - MEM_FLASH_QUAD_WORD_SIZE, words, sizeof(words)) != MEM_STATUS_OK) {
+			break;
+		}
+
+		for (uint32_t i = 0; i < (sizeof(words) / sizeof(words[0])); i++) {
+			if (words[i] != BOOT_CACHE_ERASED_WORD) {
+				return address;
+			}
+		}
+	}
+
+	return MEM_APP_START_ADDRESS + BOOT_CACHE_VECTOR_TABLE_SIZE;
+}
+
+/**
+ * @brief Cheap key of the application: CRC32 of the application info area, of the
+ *        vector table, and of the last programmed quad-word with the erased one after
+ *        it, which catches an image that was rewritten or extended behind the hooks.
+ */
+static uint32_t boot_cache_app_key(uint32_t image_end)
+{
+	uint32_t crc = crc32_continue_dma(CRC32_INIT_VALUE, (const void *)MEM_APP_INFO_ADDRESS, MEM_APP_INFO_END_ADDRESS - MEM_APP_INFO_ADDRESS);
+	uint32_t marker = image_end - MEM_FLASH_QUAD_WORD_SIZE;
+	uint32_t marker_size = (image_end < MEM_APP_END_ADDRESS) ? (2U * MEM_FLASH_QUAD_WORD_SIZE) : MEM_FLASH_QUAD_WORD_SIZE;
+
+	crc = crc32_continue_dma(crc, (const void *)MEM_APP_START_ADDRESS, BOOT_CACHE_VECTOR_TABLE_SIZE);
+
+	return crc32_continue_dma(crc, (const void *)marker, marker_size);
+}
+
+static bool boot_cache_image_end_valid(uint32_t image_end)
+{
+	return image_end >= (MEM_APP_START_ADDRESS + BOOT_CACHE_VECTOR_TABLE_SIZE) && image_end <= MEM_APP_END_ADDRESS &&
+			(image_end % MEM_FLASH_QUAD_WORD_SIZE) == 0U;
+}
+
+static void boot_cache_apply(const boot_cache_record_t *record)
+{
+	switch (record->type) {
+		case BOOT_CACHE_RECORD_GENERATION:
+			boot_cache.generation = record->generation;
+			break;
+
+		case BOOT_CACHE_RECORD_IMAGE_END:
+			boot_cache.image_end = record->value;
+			break;
+
+		case BOOT_CACHE_RECORD_VERDICT:
+			boot_cache.verdict_valid = boot_cache_image_end_valid(boot_cache.image_end);
+			boot_cache.verdict_generation = record->generation;
+			boot_cache.verdict_key = record->value;
+			boot_cache.verdict_image_end = boot_cache.image_end;
+			boot_cache.fast_boots = 0;
+			break;
+
+		case BOOT_CACHE_RECORD_BOOT:
+			if (record->generation == boot_cache.verdict_generation) {
+				boot_cache.fast_boots = record->value;
+			}
+			break;
+
+		default:
+			break;
+	}
+}
+
+/* Erase the sector and keep only what is needed to rebuild the current state */
+static void boot_cache_compact(void)
+{
+	boot_cache_record_t records[4];
+	uint32_t count = 0;
+
+	records[count].type = BOOT_CACHE_RECORD_GENERATION;
+	records[count].generation = boot_cache.generation;
+	records[count].value = 0;
+	records[count].check = boot_cache_record_check(&records[count]);
+	count++;
+
+	if (boot_cache.verdict_valid && boot_cache.verdict_generation == boot_cache.generation) {
+		records[count].type = BOOT_CACHE_RECORD_IMAGE_END;
+		records[count].generation = boot_cache.verdict_generation;
+		records[count].value = boot_cache.verdict_image_end;
+		records[count].check = boot_cache_record_check(&records[count]);
+		count++;
+
+		records[count].type = BOOT_CACHE_RECORD_VERDICT;
+		records[count].generation = boot_cache.verdict_generation;
+		records[count].value = boot_cache.verdict_key;
+		records[count].check = boot_cache_record_check(&records[count]);
+		count++;
+
+		if (boot_cache.fast_boots != 0U) {
+			records[count].type = BOOT_CACHE_RECORD_BOOT;
+			records[count].generation = boot_cache.verdict_generation;
+			records[count].value = boot_cache.fast_boots;
+			records[count].check = boot_cache_record_check(&records[count]);
+			count++;
+		}
+	}
+
+	boot_cache.next_address = BOOT_CACHE_START_ADDRESS;
+
+	if (mem_write(BOOT_CACHE_START_ADDRESS, records, count * sizeof(boot_cache_record_t)) == MEM_STATUS_OK) {
+		boot_cache.next_address += count * sizeof(boot_cache_record_t);
+	}
+}
+
+static void boot_cache_append(uint32_t type, uint32_t generation, uint32_t value)
+{
+	boot_cache_record_t record = {
+		.type = type,
+		.generation = generation,
+		.value = value,
+	};
+	record.check = boot_cache_record_check(&record);
+
+	if (boot_cache.next_address + sizeof(record) > BOOT_CACHE_END_ADDRESS) {
+		boot_cache_compact();
+	}
+
+	if (mem_program(boot_cache.next_address, &record, sizeof(record)) == MEM_STATUS_OK) {
+		boot_cache_apply(&record);
+	}
+
+	/* Never program the same slot twice, even if the write failed */
+	boot_cache.next_address += sizeof(record);
+}
+
+/* Bump the generation once per boot, before the first write into the application */
+static int boot_cache_write_hook(uint32_t address, const void *data, uint32_t size)
+{
+	(void)data;
+
+	if (boot_cache.generation_bumped || (address + size) <= MEM_APP_INFO_ADDRESS || address >= MEM_APP_END_ADDRESS) {
+		return MEM_WRITE_HOOK_PROCEED;
+	}
+
+	boot_cache.generation_bumped = true;
+	boot_cache_append(BOOT_CACHE_RECORD_GENERATION, boot_cache.generation + 1U, 0);
+
+	return MEM_WRITE_HOOK_PROCEED;
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @brief Rebuild the cached state from FLASH and start tracking application writes.
+ * @note  mem_init() must have been called.
+ */
+void boot_cache_init(void)
+{
+	boot_cache_record_t record;
+
+	memset(&boot_cache, 0, sizeof(boot_cache));
+	boot_cache.next_address = BOOT_CACHE_END_ADDRESS;
+
+	for (uint32_t address = BOOT_CACHE_START_ADDRESS; address < BOOT_CACHE_END_ADDRESS; address += sizeof(record)) {
+		if (mem_read(address, &record, sizeof(record)) != MEM_STATUS_OK) {
+			break;
+		}
+
+		if (record.type == BOOT_CACHE_RECORD_ERASED) {
+			boot_cache.next_address = address;
+			break;
+		}
+
+		/* Skip records torn by a reset in the middle of programming */
+		if (record.check == boot_cache_record_check(&record)) {
+			boot_cache_apply(&record);
+		}
+	}
+
+	(void)mem_add_write_hook(boot_cache_write_hook);
+}
+
+/**
+ * @brief Check whether the application can be started without a full verification.
+ * @details True when a verdict was recorded at the current generation, the key of
+ *          the application image is unchanged and the verdict has not been reused
+ *          more than BOOT_CACHE_FULL_CHECK_PERIOD times. The reuse is counted in RAM
+ *          over resets and written to FLASH by the first fast boot after the RAM
+ *          count was lost, so power cycling does not start it over.
+ */
+bool boot_cache_app_verified(void)
+{
+	if (!boot_cache.verdict_valid || boot_cache.verdict_generation != boot_cache.generation) {
+		return false;
+	}
+
+	bool counted_in_ram = boot_cache_boots_valid();
+	uint32_t fast_boots = boot_cache_boots_get();
+
+	if (fast_boots >= BOOT_CACHE_FULL_CHECK_PERIOD) {
+		return false;
+	}
+
+	if (boot_cache_app_key(boot_cache.verdict_image_end) != boot_cache.verdict_key) {
+		return false;
+	}
+
+	fast_boots++;
+
+	/* One FLASH write per power-on, the resets after it are counted in RAM */
+	if (!counted_in_ram) {
+		boot_cache_append(BOOT_CACHE_RECORD_BOOT, boot_cache.verdict_generation, fast_boots);
+	}
+
+	boot_cache_boots_set(fast_boots);
+
+	return true;
+}
+
+/**
+ * @brief Record that the application passed a full verification.
+ * @note  Must only be called once the bootloader core accepted the application,
+ *        i.e. right before it jumps to it.
+ */
+void boot_cache_store_verdict(void)
+{
+	uint32_t image_end = boot_cache_find_image_end();
+
+	/* The verdict must follow its image end, not a compaction in between */
+	if (boot_cache.next_address + (2U * sizeof(boot_cache_record_t)) > BOOT_CACHE_END_ADDRESS) {
+		boot_cache_compact();
+	}
+
+	boot_cache_append(BOOT_CACHE_RECORD_IMAGE_END, boot_cache.generation, image_end);
+	boot_cache_append(BOOT_CACHE_RECORD_VERDICT, boot_cache.generation, boot_cache_app_key(image_end));
+	boot_cache_boots_set(0);
+}
+
+uint32_t boot_cache_get_generation(void)
+{
+	return boot_cache.generation;
+}
+
+/**
+ * @return Boots that may still start the application on the recorded verdict,
+ *         0 if the next boot runs a full verification
+ */
+uint32_t boot_cache_get_fast_boots_left(void)
+{
+	uint32_t fast_boots = boot_cache_boots_get();
+
+	if (!boot_cache.verdict_valid || boot_cache.verdict_generation != boot_cache.generation ||
+			fast_boots >= BOOT_CACHE_FULL_CHECK_PERIOD) {
+		return 0;
+	}
+
+	return BOOT_CACHE_FULL_CHECK_PERIOD - fast_boots;
+}
@@ -0,0 +1,38 @@
+/**
+ * @file boot_cache.h
+ * @brief Cached application verification verdict
+ * @details The verdict of the last full verification of the application is kept
+ *          in FLASH together with a flash write generation counter. The counter
+ *          is bumped before anything is programmed into the application info or
+ *          application areas, so a verdict is only trusted while nothing has been
+ *          written since it was recorded. Writes that bypass the hooks (a debugger,
+ *          the application itself) are caught by a key of the image checked at every
+ *          boot: the application info area, the vector table and the end of the image.
+ *          Records are appended to a dedicated sector of the reserved area and the
+ *          sector is only erased when it is full.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "mem.h"
+
+/* General defines ------------------------------------------------------------------*/
+#define BOOT_CACHE_START_ADDRESS            MEM_RESERVED_START_ADDRESS
+#define BOOT_CACHE_END_ADDRESS              (MEM_RESERVED_START_ADDRESS + MEM_FLASH_SECTOR_SIZE)
+
+/**
+ * @brief Number of boots that may reuse a verdict before a full verification is forced
+ * @note  Counted in RAM kept over a reset and written to FLASH once per power-on
+ */
+#define BOOT_CACHE_FULL_CHECK_PERIOD        32U
+
+/* Public Functions ------------------------------------------------------------------*/
+void boot_cache_init(void);
+bool boot_cache_app_verified(void);
+void boot_cache_store_verdict(void);
+uint32_t boot_cache_get_generation(void);
+uint32_t boot_cache_get_fast_boots_left(void);
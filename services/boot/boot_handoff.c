@@ -0,0 +1,156 @@
+/**
+ * @file boot_handoff.c
+ * @brief Versioned boot handoff block shared with the application
+ * @date 19/10/2026
+ */
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "boot_handoff.h"
+#include "boot_cache.h"
+#include "crc.h"
+#include "mem.h"
+#include "sf_bootloader_hal.h"
+#include "dlog.h"
+
+/* Public Variables -----------------------------------------------------------------*/
+__attribute__((section(".shared_ram.handoff"), used)) boot_handoff_t boot_handoff;
+
+/* Static Variables -----------------------------------------------------------------*/
+static uint32_t update_start_ms;
+static bool update_started;             /* An update was started by this boot */
+
+/* Private Functions ----------------------------------------------------------------*/
+static uint32_t boot_handoff_crc(void)
+{
+	return crc32_continue(CRC32_INIT_VALUE, &boot_handoff, offsetof(boot_handoff_t, crc));
+}
+
+static bool boot_handoff_valid(void)
+{
+	return boot_handoff.magic == BOOT_HANDOFF_MAGIC && boot_handoff.version == BOOT_HANDOFF_VERSION &&
+			boot_handoff.size == sizeof(boot_handoff_t) && boot_handoff.crc == boot_handoff_crc();
+}
+
+static void boot_handoff_seal(void)
+{
+	boot_handoff.crc = boot_handoff_crc();
+}
+
+static void boot_handoff_update_end(boot_handoff_update_e result)
+{
+	boot_handoff.update_result = (uint8_t)result;
+	boot_handoff.update_duration_ms = sf_bootloader_hal_get_1ms_counter() - update_start_ms;
+	boot_handoff_seal();
+}
+
+/*
+ * Count what is programmed into the upgrade slot, the first write starts an update.
+ * A write after a rejection is the tester retrying the same update.
+ */
+static int boot_handoff_write_hook(uint32_t address, const void *data, uint32_t size)
+{
+	(void)data;
+
+	if ((address + size) <= MEM_UPGRADE_START_ADDRESS || address >= MEM_UPGRADE_END_ADDRESS) {
+		return MEM_WRITE_HOOK_PROCEED;
+	}
+
+	if (!update_started || boot_handoff.update_result == BOOT_HANDOFF_UPDATE_SUCCESS) {
+		boot_handoff.update_duration_ms = 0;
+		boot_handoff.update_bytes = 0;
+		boot_handoff.update_writes = 0;
+		update_start_ms = sf_bootloader_hal_get_1ms_counter();
+		update_started = true;
+		DLOG("update started at 0x%08x", address);
+	}
+
+	boot_handoff.update_result = BOOT_HANDOFF_UPDATE_IN_PROGRESS;
+
+	boot_handoff.update_bytes += size;
+	boot_handoff.update_writes++;
+	boot_handoff_seal();
+
+	return MEM_WRITE_HOOK_PROCEED;
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @brief Start the block for this boot, keeping the last update of a valid previous one.
+ * @note  mem_init() and boot_cache_init() must have been called.
+ */
+void boot_handoff_begin(uint32_t reset_flags, boot_handoff_reason_e reason)
+{
+	if (!boot_handoff_valid()) {
+		boot_handoff.update_result = BOOT_HANDOFF_UPDATE_NONE;
+		boot_handoff.update_duration_ms = 0;
+		boot_handoff.update_bytes = 0;
+		boot_handoff.update_writes = 0;
+	} else if (boot_handoff.update_result == BOOT_HANDOFF_UPDATE_IN_PROGRESS) {
+		boot_handoff.update_result = BOOT_HANDOFF_UPDATE_INTERRUPTED;
+	}
+
+	boot_handoff.magic = BOOT_HANDOFF_MAGIC;
+	boot_handoff.version = BOOT_HANDOFF_VERSION;
+	boot_handoff.size = sizeof(boot_handoff_t);
+	boot_handoff.reset_flags = reset_flags;
+	boot_handoff.boot_reason = (uint8_t)reason;
+	boot_handoff.verdict = BOOT_HANDOFF_VERDICT_NONE;
+	boot_handoff.reserved = 0;
+	boot_handoff.flash_generation = boot_cache_get_generation();
+	boot_handoff.fast_boots_left = boot_cache_get_fast_boots_left();
+	boot_handoff_seal();
+
+	(void)mem_add_write_hook(boot_handoff_write_hook);
+}
+
+/**
+ * @brief Record how the application was accepted.
+ */
+void boot_handoff_set_verdict(boot_handoff_verdict_e verdict)
+{
+	boot_handoff.verdict = (uint8_t)verdict;
+	boot_handoff_seal();
+}
+
+/**
+ * @brief Complete the block right before the jump to the application.
+ * @details An update still in progress was not copied into the application slot
+ *          with matching digests: the application that starts is the old one.
+ * @note  Call after the verdict has been stored, so the next boot hint is current.
+ */
+void boot_handoff_finish(void)
+{
+	if (boot_handoff.update_result == BOOT_HANDOFF_UPDATE_IN_PROGRESS) {
+		boot_handoff_update_end(BOOT_HANDOFF_UPDATE_FAILED);
+	}
+
+	boot_handoff.flash_generation = boot_cache_get_generation();
+	boot_handoff.fast_boots_left = boot_cache_get_fast_boots_left();
+	boot_handoff_seal();
+}
+
+/**
+ * @brief The image of the upgrade slot was copied into the application slot and
+ *        the digests of both slots match.
+ */
+void boot_handoff_update_installed(void)
+{
+	if (update_started && boot_handoff.update_result == BOOT_HANDOFF_UPDATE_IN_PROGRESS) {
+		boot_handoff_update_end(BOOT_HANDOFF_UPDATE_SUCCESS);
+	}
+}
+
+/**
+ * @brief The image of the update was rejected: bad signature, rejected segment or
+ *        a copy that does not match the upgrade slot.
+ */
+void boot_handoff_update_failed(void)
+{
+	if (update_started && boot_handoff.update_result != BOOT_HANDOFF_UPDATE_FAILED) {
+		DLOG("update failed");
+		boot_handoff_update_end(BOOT_HANDOFF_UPDATE_FAILED);
+	}
+}
@@ -0,0 +1,74 @@
+/**
+ * @file boot_handoff.h
+ * @brief Versioned boot handoff block shared with the application
+ * @details Everything the bootloader learnt during a boot, so the application
+ *          does not have to probe or verify it again: reset cause, why the
+ *          bootloader ran, how the image was accepted, what the next boot will do,
+ *          and the result and statistics of the last update. The block sits at
+ *          BOOT_HANDOFF_ADDRESS in the shared RAM (SHARED_RAM_HANDOFF_OFFSET in the
+ *          linker script), next to the existing shared_variable and hardware_info.
+ *
+ *          The application must check magic, version, size and crc (CRC32 of the
+ *          bytes before it, as computed by crc32_continue() from CRC32_INIT_VALUE)
+ *          before using any field. The last update fields survive resets that keep
+ *          the RAM powered, an update cut by a reset reads INTERRUPTED. An update
+ *          only reads SUCCESS once the copy into the application slot matched the
+ *          digest of the upgrade slot, a rejected image reads FAILED.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* General defines ------------------------------------------------------------------*/
+#define BOOT_HANDOFF_MAGIC                  0x46464F48U     /* "HOFF" */
+#define BOOT_HANDOFF_VERSION                2U
+#define BOOT_HANDOFF_ADDRESS                0x2009FF00U
+
+/* Public Types ---------------------------------------------------------------------*/
+typedef enum {
+	BOOT_HANDOFF_REASON_POWER_ON = 0,       /* Any reset but a software one */
+	BOOT_HANDOFF_REASON_SOFTWARE_RESET,     /* Software reset without request */
+	BOOT_HANDOFF_REASON_STAY_REQUEST,       /* Application asked to stay in the bootloader */
+	BOOT_HANDOFF_REASON_VERIFY_REQUEST,     /* Application asked for a full verification */
+} boot_handoff_reason_e;
+
+typedef enum {
+	BOOT_HANDOFF_VERDICT_NONE = 0,          /* Application not started by this boot yet */
+	BOOT_HANDOFF_VERDICT_CACHED,            /* Started on the recorded verdict (boot_cache) */
+	BOOT_HANDOFF_VERDICT_FULL,              /* Started after a full verification by the core */
+} boot_handoff_verdict_e;
+
+typedef enum {
+	BOOT_HANDOFF_UPDATE_NONE = 0,           /* No update since the RAM was last powered */
+	BOOT_HANDOFF_UPDATE_IN_PROGRESS,
+	BOOT_HANDOFF_UPDATE_SUCCESS,            /* The image was copied into the application slot and checked */
+	BOOT_HANDOFF_UPDATE_INTERRUPTED,        /* Reset before the image was copied into the application slot */
+	BOOT_HANDOFF_UPDATE_FAILED,             /* The image was rejected, the application slot was not updated */
+} boot_handoff_update_e;
+
+typedef struct {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t size;                          /* sizeof(boot_handoff_t) */
+	uint32_t reset_flags;                   /* RCC->RSR at boot */
+	uint8_t boot_reason;                    /* boot_handoff_reason_e */
+	uint8_t verdict;                        /* boot_handoff_verdict_e */
+	uint8_t update_result;                  /* boot_handoff_update_e */
+	uint8_t reserved;
+	uint32_t flash_generation;              /* Flash write generation the verdict applies to */
+	uint32_t fast_boots_left;               /* Boots that may reuse the verdict, 0: next one verifies fully */
+	uint32_t update_duration_ms;            /* First write into the upgrade slot to the end of the copy or the rejection */
+	uint32_t update_bytes;                  /* Bytes programmed into the upgrade slot */
+	uint32_t update_writes;                 /* Writes into the upgrade slot */
+	uint32_t crc;
+} boot_handoff_t;
+
+/* Public Functions ------------------------------------------------------------------*/
+void boot_handoff_begin(uint32_t reset_flags, boot_handoff_reason_e reason);
+void boot_handoff_set_verdict(boot_handoff_verdict_e verdict);
+void boot_handoff_finish(void);
+void boot_handoff_update_installed(void);
+void boot_handoff_update_failed(void);
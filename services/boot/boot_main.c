@@ -0,0 +1,174 @@
+/**
+ * @file boot_main.c
+ * @brief Boot sequence and main loop tasks shared by the target and the virtual ECU
+ * @date 19/10/2026
+ */
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "boot_main.h"
+#include "sf_bootloader_hal.h"
+#include "mem.h"
+#include "mem_cache.h"
+#include "can_message_handler.h"
+#include "boot_cache.h"
+#include "boot_handoff.h"
+#include "boot_timeline.h"
+#include "fw_manifest.h"
+#include "listen_window.h"
+#include "event_loop.h"
+#include "timebase.h"
+
+/* Private defines ------------------------------------------------------------------*/
+#define BOOT_MAIN_SHARED_TASKS              4U
+
+/* Static Variables -----------------------------------------------------------------*/
+static const boot_main_platform_t *boot_main_platform;
+
+/* Running digests of the data programmed into the upgrade and application slots */
+static mem_digest_t upgrade_digest;
+static mem_digest_t app_digest;
+
+static scheduler_task_t boot_main_tasks[BOOT_MAIN_SHARED_TASKS + 1U];
+
+/* Kept by the bootloader core */
+static const bootloader_sections_t boot_main_sections = {
+	.app_info = { .address = MEM_APP_INFO_ADDRESS, .size = MEM_APP_INFO_END_ADDRESS - MEM_APP_INFO_ADDRESS },
+	.app = { .address = MEM_APP_START_ADDRESS, .size = MEM_APP_END_ADDRESS - MEM_APP_START_ADDRESS },
+	.upgrade_info = { .address = MEM_UPGRADE_INFO_ADDRESS, .size = MEM_UPGRADE_INFO_END_ADDRESS - MEM_UPGRADE_INFO_ADDRESS },
+	.upgrade = { .address = MEM_UPGRADE_START_ADDRESS, .size = MEM_UPGRADE_END_ADDRESS - MEM_UPGRADE_START_ADDRESS },
+};
+
+/* Private Functions ----------------------------------------------------------------*/
+/* Record the boot time and leave the cache and the timebase as after reset */
+static void boot_main_handover(uint32_t address)
+{
+	boot_timeline_mark(BOOT_TIMELINE_JUMP);
+	boot_handoff_finish();
+
+	if (boot_main_platform->before_jump != NULL) {
+		boot_main_platform->before_jump();
+	}
+
+	mem_cache_deinit();
+	timebase_deinit();
+	sf_bootloader_hal_jump_to_app(address);
+}
+
+static bool boot_main_task_can_drain(uint32_t budget_cycles)
+{
+	return can_message_handler_drain(boot_main_platform->ecu_id, budget_cycles);
+}
+
+/* bootloader_tick() cannot be split, its budget is only checked */
+static bool boot_main_task_transfer(uint32_t budget_cycles)
+{
+	uint32_t time = sf_bootloader_hal_get_1ms_counter();
+
+	(void)budget_cycles;
+	bootloader_tick(time);
+
+	/* No tester on the bus, no need to wait for the whole jump delay */
+	if (listen_window_expired(time)) {
+		bootloader_start_app(true);
+	}
+
+	return false;
+}
+
+static bool boot_main_task_heartbeat(uint32_t budget_cycles)
+{
+	(void)budget_cycles;
+	can_message_handler_heartbeat(boot_main_platform->ecu_id, bootloader_app_status(), boot_main_platform->version);
+
+	return false;
+}
+
+static bool boot_main_task_manifest_scan(uint32_t budget_cycles)
+{
+	return can_message_handler_manifest_scan(boot_main_platform->ecu_id, budget_cycles);
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @brief Set the platform the boot runs on.
+ * @note  The platform must stay valid until the jump to the application.
+ */
+void boot_main_init(const boot_main_platform_t *platform)
+{
+	boot_main_platform = platform;
+}
+
+/**
+ * @brief Start the application right away if nothing was written since it was
+ *        last verified, with only what the caller brought up so far.
+ * @note  mem_init(), boot_cache_init() and boot_handoff_begin() must have been called.
+ *        Returns only when the application needs a full boot.
+ */
+void boot_main_fast_boot(void)
+{
+	if (boot_cache_app_verified()) {
+		boot_timeline_mark(BOOT_TIMELINE_IMAGE_CHECK);
+		boot_handoff_set_verdict(BOOT_HANDOFF_VERDICT_CACHED);
+		boot_main_handover(MEM_APP_START_ADDRESS);
+	}
+}
+
+/**
+ * @brief Bring up the bootloader core and the main loop tasks, once CAN is up.
+ * @param config      Configuration of the core, kept by it: must stay valid. Its
+ *                    jump_to_app_func is boot_main_jump_to_app()
+ * @param ed25519_key Key of the Ed25519 manifests, NULL if the board has none
+ * @param stay        Stay in the bootloader, as asked by the application
+ */
+void boot_main_start(const bootloader_config_t *config, const ed25519_public_key_t *ed25519_key, bool stay)
+{
+	mem_digest_attach(&upgrade_digest, MEM_UPGRADE_START_ADDRESS, MEM_UPGRADE_END_ADDRESS);
+	mem_digest_attach(&app_digest, MEM_APP_START_ADDRESS, MEM_APP_END_ADDRESS);
+
+	fw_manifest_init(config->public_key, ed25519_key, config->btea_chunk_size);
+
+	can_message_handler_init();
+	sf_bootloader_hal_init();
+	boot_timeline_mark(BOOT_TIMELINE_CAN);
+
+	bootloader_init(config, &boot_main_sections);
+	boot_timeline_mark(BOOT_TIMELINE_BOOTLOADER_INIT);
+
+	if (stay) {
+		bootloader_stay(true);
+	} else {
+		listen_window_open(sf_bootloader_hal_get_1ms_counter(), config->jump_delay);
+	}
+
+	/*
+	 * Highest priority first. A FLASH write keeps the transfer running, a received
+	 * frame is drained before it continues.
+	 */
+	uint32_t task_count = 0;
+
+	boot_main_tasks[task_count++] = (scheduler_task_t){ boot_main_task_can_drain, EVENT_LOOP_CAN_RX, BOOT_MAIN_CAN_DRAIN_BUDGET_US };
+	boot_main_tasks[task_count++] = (scheduler_task_t){ boot_main_task_transfer,
+			EVENT_LOOP_CAN_RX | EVENT_LOOP_FLASH | EVENT_LOOP_TICK, BOOT_MAIN_TRANSFER_BUDGET_US };
+	boot_main_tasks[task_count++] = (scheduler_task_t){ boot_main_task_heartbeat,
+			EVENT_LOOP_CAN_RX | EVENT_LOOP_TICK, BOOT_MAIN_HEARTBEAT_BUDGET_US };
+	boot_main_tasks[task_count++] = (scheduler_task_t){ boot_main_task_manifest_scan, EVENT_LOOP_CAN_RX, BOOT_MAIN_MANIFEST_SCAN_BUDGET_US };
+
+	if (boot_main_platform->platform_task.func != NULL) {
+		boot_main_tasks[task_count++] = boot_main_platform->platform_task;
+	}
+
+	event_loop_init();
+	(void)scheduler_init(boot_main_tasks, task_count);
+}
+
+/**
+ * @brief jump_to_app_func of the core, which only hands over to an application it
+ *        has fully verified.
+ */
+void boot_main_jump_to_app(uint32_t address)
+{
+	boot_timeline_mark(BOOT_TIMELINE_IMAGE_CHECK);
+	boot_handoff_set_verdict(BOOT_HANDOFF_VERDICT_FULL);
+	boot_cache_store_verdict();
+	boot_main_handover(address);
+}
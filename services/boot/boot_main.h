@@ -0,0 +1,45 @@
+/**
+ * @file boot_main.h
+ * @brief Boot sequence and main loop tasks shared by the target and the virtual ECU
+ * @details Core/Src/main.c and tools/vecu/vecu_main.c bring up their own clocks,
+ *          CAN and FLASH, then run the same boot:
+ *            - boot_main_fast_boot(): start the application on the recorded verdict
+ *              when nothing was written since it was last verified;
+ *            - boot_main_start(): the digests of both slots, the manifest, the CAN
+ *              message handler, the bootloader core, the listen window and the main
+ *              loop tasks;
+ *            - scheduler_run() and event_loop_wait() in the super-loop of the caller.
+ *          The bootloader core hands over through boot_main_jump_to_app(), set as
+ *          jump_to_app_func of its configuration.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "bootloader.h"
+#include "ed25519.h"
+#include "scheduler.h"
+
+/* General defines ------------------------------------------------------------------*/
+/* Main loop task budgets, see scheduler.h */
+#define BOOT_MAIN_CAN_DRAIN_BUDGET_US       100U
+#define BOOT_MAIN_TRANSFER_BUDGET_US        500U
+#define BOOT_MAIN_HEARTBEAT_BUDGET_US       50U
+#define BOOT_MAIN_MANIFEST_SCAN_BUDGET_US   1000U   /* SHA-256 of one segment */
+
+/* Public Types ---------------------------------------------------------------------*/
+typedef struct {
+	uint8_t ecu_id;                         /* ECU code of the CAN protocol */
+	uint8_t version;                        /* Bootloader version reported in the heartbeat */
+	void (*before_jump)(void);              /* Teardown of the platform right before the jump, NULL if none */
+	scheduler_task_t platform_task;         /* Run after the shared tasks (LED), func NULL if none */
+} boot_main_platform_t;
+
+/* Public Functions ------------------------------------------------------------------*/
+void boot_main_init(const boot_main_platform_t *platform);
+void boot_main_fast_boot(void);
+void boot_main_start(const bootloader_config_t *config, const ed25519_public_key_t *ed25519_key, bool stay);
+void boot_main_jump_to_app(uint32_t address);
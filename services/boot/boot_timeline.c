@@ -0,0 +1,76 @@
+/**
+ * @file boot_timeline.c
+ * @brief Timestamps of the boot phases, handed over to the application
+ * @date 19/10/2026
+ */
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "boot_timeline.h"
+#include "cycle_counter.h"
+
+/* Public Variables -----------------------------------------------------------------*/
+__attribute__((section(".shared_ram.timeline"), used)) volatile boot_timeline_t boot_timeline;
+
+/* Static Variables -----------------------------------------------------------------*/
+/* Count at boot_timeline_start(), the counter may be running from before the reset */
+static uint32_t boot_timeline_base;
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @brief Start the cycle counter and clear the record; call first thing in main().
+ */
+void boot_timeline_start(void)
+{
+	cycle_counter_init();
+	boot_timeline_base = cycle_counter_get();
+
+	boot_timeline.magic = BOOT_TIMELINE_MAGIC;
+	boot_timeline.version = BOOT_TIMELINE_VERSION;
+	boot_timeline.phase_count = BOOT_TIMELINE_PHASE_COUNT;
+	boot_timeline.clock_hz = 0;
+	boot_timeline.reset_clock_hz = cycle_counter_hz();
+	for (uint32_t i = 0; i < BOOT_TIMELINE_PHASE_COUNT; i++) {
+		boot_timeline.cycles[i] = 0;
+	}
+}
+
+/**
+ * @brief Stamp the end of a phase.
+ */
+void boot_timeline_mark(boot_timeline_phase_e phase)
+{
+	if (phase >= BOOT_TIMELINE_PHASE_COUNT) {
+		return;
+	}
+
+	boot_timeline.cycles[phase] = cycle_counter_get() - boot_timeline_base;
+	boot_timeline.clock_hz = cycle_counter_hz();
+}
+
+static uint32_t boot_timeline_cycles_to_us(uint32_t cycles, uint32_t clock_hz)
+{
+	uint32_t cycles_per_us = clock_hz / 1000000U;
+
+	return (cycles_per_us == 0U) ? 0U : (cycles / cycles_per_us);
+}
+
+/**
+ * @return Time from main() to the end of the phase in microseconds, 0 if not reached
+ */
+uint32_t boot_timeline_get_us(boot_timeline_phase_e phase)
+{
+	uint32_t clock_cycles = boot_timeline.cycles[BOOT_TIMELINE_CLOCK];
+
+	if (phase >= BOOT_TIMELINE_PHASE_COUNT || boot_timeline.cycles[phase] == 0U) {
+		return 0;
+	}
+
+	/* Up to the CLOCK phase at the reset clock, from there at the final one */
+	uint32_t clock_us = boot_timeline_cycles_to_us(clock_cycles, boot_timeline.reset_clock_hz);
+
+	if (phase == BOOT_TIMELINE_CLOCK || clock_cycles == 0U) {
+		return boot_timeline_cycles_to_us(boot_timeline.cycles[phase], boot_timeline.reset_clock_hz);
+	}
+
+	return clock_us + boot_timeline_cycles_to_us(boot_timeline.cycles[phase] - clock_cycles, boot_timeline.clock_hz);
+}
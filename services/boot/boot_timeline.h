@@ -0,0 +1,58 @@
+/**
+ * @file boot_timeline.h
+ * @brief Timestamps of the boot phases, handed over to the application
+ * @details The DWT cycle counter is started at the top of main() and the end of
+ *          each boot phase is stamped into a versioned record in .shared_ram,
+ *          where the application can read it after the jump. Phases that were not
+ *          reached in this boot (CAN and bootloader_init on the fast path, image
+ *          check and jump while the bootloader stays) read 0. The same timestamps
+ *          are returned on the CAN boot timeline request.
+ *
+ *          The record sits at BOOT_TIMELINE_ADDRESS (SHARED_RAM_TIMELINE_OFFSET in
+ *          the linker script).
+ *
+ *          The time to the application is the JUMP timestamp. The verdict of the
+ *          boot handoff block tells the path it was taken on: CACHED for the fast
+ *          path of a cached verdict, FULL after a full verification.
+ *
+ *          Timestamps are in cycles from boot_timeline_start(): the DWT counter is
+ *          not reset by a system reset, the count at the start is subtracted. The
+ *          CLOCK phase runs on the reset clock (reset_clock_hz, HSI), the later
+ *          phases on the final core clock (clock_hz).
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* General defines ------------------------------------------------------------------*/
+#define BOOT_TIMELINE_MAGIC                 0x4C4D4954U     /* "TIML" */
+#define BOOT_TIMELINE_VERSION               2U
+#define BOOT_TIMELINE_ADDRESS               0x2009FF80U
+
+/* Public Types ---------------------------------------------------------------------*/
+typedef enum {
+	BOOT_TIMELINE_CLOCK = 0,            /* SystemClock_Config() */
+	BOOT_TIMELINE_PERIPHERALS,          /* Cache, GPIO and CRC */
+	BOOT_TIMELINE_CAN,                  /* FDCAN and the CAN message handler */
+	BOOT_TIMELINE_BOOTLOADER_INIT,      /* bootloader_init() */
+	BOOT_TIMELINE_IMAGE_CHECK,          /* Application accepted, cached verdict or full verification */
+	BOOT_TIMELINE_JUMP,                 /* Jump to the application */
+	BOOT_TIMELINE_PHASE_COUNT
+} boot_timeline_phase_e;
+
+typedef struct {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t phase_count;
+	uint32_t clock_hz;                      /* Core clock after SystemClock_Config() */
+	uint32_t cycles[BOOT_TIMELINE_PHASE_COUNT];
+	uint32_t reset_clock_hz;                /* Core clock at main(), up to the CLOCK phase */
+} boot_timeline_t;
+
+/* Public Functions ------------------------------------------------------------------*/
+void boot_timeline_start(void);
+void boot_timeline_mark(boot_timeline_phase_e phase);
+uint32_t boot_timeline_get_us(boot_timeline_phase_e phase);
@@ -0,0 +1,134 @@
+/**
+ * @file event_loop.c
+ * @brief Pending-event flags and WFI sleep for the bootloader main loop
+ * @details The sleep ratio is derived from the cycles the loop spends awake, so it
+ *          does not depend on the cycle counter running while the core sleeps.
+ * @date 19/10/2026
+ */
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "event_loop.h"
+#include "cycle_counter.h"
+#include "mem.h"
+#include "sf_bootloader_hal.h"
+
+/* Private types --------------------------------------------------------------------*/
+typedef struct {
+	uint32_t iterations;
+	uint32_t sleeps;
+	uint64_t awake_cycles;
+	uint32_t awake_since;                   /* Cycle counter when the core last woke up */
+	uint32_t start_ms;
+} event_loop_t;
+
+/* Static Variables -----------------------------------------------------------------*/
+static volatile uint32_t event_loop_pending;
+static event_loop_t event_loop;
+
+/* Private Functions ----------------------------------------------------------------*/
+/* Every write is followed by the next chunk of the transfer, do not sleep in between */
+static int event_loop_write_hook(uint32_t address, const void *data, uint32_t size)
+{
+	(void)address;
+	(void)data;
+	(void)size;
+
+	event_loop_post(EVENT_LOOP_FLASH);
+
+	return MEM_WRITE_HOOK_PROCEED;
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @brief Reset the statistics and watch FLASH writes.
+ * @note  mem_init() must have been called.
+ */
+void event_loop_init(void)
+{
+	event_loop.iterations = 0;
+	event_loop.sleeps = 0;
+	event_loop.awake_cycles = 0;
+	event_loop.awake_since = cycle_counter_get();
+	event_loop.start_ms = sf_bootloader_hal_get_1ms_counter();
+
+	(void)mem_add_write_hook(event_loop_write_hook);
+}
+
+/**
+ * @brief Mark events as pending, callable from any interrupt.
+ */
+void event_loop_post(uint32_t events)
+{
+	(void)__atomic_fetch_or(&event_loop_pending, events, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Start a loop iteration.
+ * @return Events posted since the previous call
+ */
+uint32_t event_loop_take(void)
+{
+	event_loop.iterations++;
+
+	return event_loop_poll();
+}
+
+/**
+ * @brief Collect events posted since the last take or poll, within an iteration.
+ */
+uint32_t event_loop_poll(void)
+{
+	return __atomic_exchange_n(&event_loop_pending, 0U, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief End a loop iteration, sleeping until the next interrupt unless an event
+ *        was posted since event_loop_take().
+ * @details Interrupts are masked between the check and WFI, a pending interrupt
+ *          still ends WFI and is taken once they are unmasked.
+ */
+void event_loop_wait(void)
+{
+#if defined(__arm__)
+	__disable_irq();
+
+	if (event_loop_pending == 0U) {
+		event_loop.awake_cycles += cycle_counter_get() - event_loop.awake_since;
+		event_loop.sleeps++;
+
+		__DSB();
+		__WFI();
+
+		event_loop.awake_since = cycle_counter_get();
+	}
+
+	__enable_irq();
+#else
+	if (event_loop_pending == 0U) {
+		event_loop.awake_cycles += cycle_counter_get() - event_loop.awake_since;
+		event_loop.sleeps++;
+
+		event_loop_host_sleep();
+
+		event_loop.awake_since = cycle_counter_get();
+	}
+#endif
+}
+
+/**
+ * @brief Loop iterations and time spent asleep.
+ */
+void event_loop_get_stats(event_loop_stats_t *stats)
+{
+	uint32_t elapsed_ms = sf_bootloader_hal_get_1ms_counter() - event_loop.start_ms;
+	uint64_t elapsed_cycles = (uint64_t)elapsed_ms * (cycle_counter_hz() / 1000U);
+	uint64_t awake_cycles = event_loop.awake_cycles + (cycle_counter_get() - event_loop.awake_since);
+
+	stats->iterations = event_loop.iterations;
+	stats->sleeps = event_loop.sleeps;
+	stats->sleep_permille = 0;
+
+	if (elapsed_cycles > awake_cycles) {
+		stats->sleep_permille = (uint16_t)(((elapsed_cycles - awake_cycles) * 1000U) / elapsed_cycles);
+	}
+}
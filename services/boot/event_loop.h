@@ -0,0 +1,43 @@
+/**
+ * @file event_loop.h
+ * @brief Pending-event flags and WFI sleep for the bootloader main loop
+ * @details Interrupts post what woke the core (a CAN frame in the RX FIFO, the 1 ms
+ *          tick, a FLASH write) and the main loop goes back to sleep once an
+ *          iteration ran without a new event being posted. The 1 ms tick wakes the
+ *          core at least once per millisecond for the timers of the bootloader core,
+ *          a received CAN frame is served within the wake-up and interrupt latency.
+ *
+ *          The loop is free to run its whole body on every wake-up, the events only
+ *          decide whether it may sleep.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* General defines ------------------------------------------------------------------*/
+#define EVENT_LOOP_CAN_RX                   (1UL << 0)      /* Frame in the RX FIFO */
+#define EVENT_LOOP_TICK                     (1UL << 1)      /* 1 ms tick */
+#define EVENT_LOOP_FLASH                    (1UL << 2)      /* FLASH programmed, more may follow */
+
+/* Public Types ---------------------------------------------------------------------*/
+typedef struct {
+	uint32_t iterations;                    /* Main loop iterations */
+	uint32_t sleeps;                        /* WFI entries */
+	uint16_t sleep_permille;                /* Time asleep since event_loop_init() */
+} event_loop_stats_t;
+
+/* Public Functions ------------------------------------------------------------------*/
+void event_loop_init(void);
+void event_loop_post(uint32_t events);
+uint32_t event_loop_take(void);
+uint32_t event_loop_poll(void);
+void event_loop_wait(void);
+void event_loop_get_stats(event_loop_stats_t *stats);
+
+#if !defined(__arm__)
+/* Provided by the host build: returns once an event may have been posted */
+void event_loop_host_sleep(void);
+#endif
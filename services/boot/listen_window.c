@@ -0,0 +1,95 @@
+/**
+ * @file listen_window.c
+ * @brief Window for catching the ECU before the application starts, held by bootloader traffic
+ * @date 19/10/2026
+ */
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "listen_window.h"
+
+/* Private types --------------------------------------------------------------------*/
+typedef enum {
+	LISTEN_WINDOW_CLOSED = 0,
+	LISTEN_WINDOW_QUIET,            /* No frame seen yet */
+	LISTEN_WINDOW_EXTENDED,         /* The bus is not silent, a tester may be about to talk */
+} listen_window_state_e;
+
+typedef struct {
+	listen_window_state_e state;
+	uint32_t start_ms;
+	uint32_t max_ms;
+} listen_window_t;
+
+/* Static Variables -----------------------------------------------------------------*/
+static listen_window_t listen_window;
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @brief Start listening for a tester.
+ * @param max_ms Longest window, the bootloader jump_delay
+ */
+void listen_window_open(uint32_t now_ms, uint32_t max_ms)
+{
+	listen_window.state = LISTEN_WINDOW_QUIET;
+	listen_window.start_ms = now_ms;
+	listen_window.max_ms = max_ms;
+}
+
+/**
+ * @brief Leave the decision to the bootloader core.
+ */
+void listen_window_close(void)
+{
+	listen_window.state = LISTEN_WINDOW_CLOSED;
+}
+
+/**
+ * @brief A run-mode or prepare request was received.
+ */
+void listen_window_request_seen(bool for_this_ecu)
+{
+	if (listen_window.state == LISTEN_WINDOW_CLOSED) {
+		return;
+	}
+
+	listen_window.state = for_this_ecu ? LISTEN_WINDOW_CLOSED : LISTEN_WINDOW_EXTENDED;
+}
+
+/**
+ * @brief A bootloader protocol frame was received, for any ECU.
+ */
+void listen_window_bus_active(void)
+{
+	if (listen_window.state == LISTEN_WINDOW_QUIET) {
+		listen_window.state = LISTEN_WINDOW_EXTENDED;
+	}
+}
+
+/**
+ * @brief Check whether the application should be started now.
+ * @return true once, when the window ends without a request for this ECU
+ */
+bool listen_window_expired(uint32_t now_ms)
+{
+	uint32_t elapsed = now_ms - listen_window.start_ms;
+
+	switch (listen_window.state) {
+		case LISTEN_WINDOW_QUIET:
+			if (elapsed < LISTEN_WINDOW_QUIET_MS) {
+				return false;
+			}
+			break;
+
+		case LISTEN_WINDOW_EXTENDED:
+			if (elapsed < listen_window.max_ms) {
+				return false;
+			}
+			break;
+
+		default:
+			return false;
+	}
+
+	listen_window.state = LISTEN_WINDOW_CLOSED;
+	return true;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file listen_window.h
+ * @brief Window for catching the ECU before the application starts, held by bootloader traffic
+ * @details The bootloader core waits jump_delay milliseconds before it starts a
+ *          valid application, in case a tester wants to keep the ECU in the
+ *          bootloader. The window is only closed early without bootloader traffic:
+ *            - no bootloader frame within LISTEN_WINDOW_QUIET_MS: the application is
+ *              started right away;
+ *            - any other frame taken by the RX filter, i.e. in the identifier range
+ *              of the bootloader protocol (listen_window_bus_active()): a tester may
+ *              be about to talk, the window lasts the full jump_delay, as before;
+ *            - a run-mode or prepare request for this ECU: the window is handed
+ *              over to the core, which stays or starts the application as
+ *              requested.
+ *          The quiet time covers one request period of a legacy tester, so a tester
+ *          that catches the ECU within jump_delay today still does. Vehicle traffic
+ *          outside of that range does not hold the boot.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+/* General defines ------------------------------------------------------------------*/
+/**
+ * @brief Time to wait for a frame before starting the application: one 50 ms
+ *        PREPARE_REQUEST period of a legacy tester, with margin for its jitter.
+ */
+#ifndef LISTEN_WINDOW_QUIET_MS
+#define LISTEN_WINDOW_QUIET_MS              60U
+#endif
+
+/* Public Functions ------------------------------------------------------------------*/
+void listen_window_open(uint32_t now_ms, uint32_t max_ms);
+void listen_window_close(void);
+void listen_window_request_seen(bool for_this_ecu);
+void listen_window_bus_active(void);
+bool listen_window_expired(uint32_t now_ms);
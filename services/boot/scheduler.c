@@ -0,0 +1,171 @@
+/**
+ * @file scheduler.c
+ * @brief Cooperative, strictly prioritized scheduler for the bootloader main loop
+ * @date 19/10/2026
+ */
+
+/* Private Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "scheduler.h"
+#include "event_loop.h"
+#include "cycle_counter.h"
+#include "dlog.h"
+
+/* Private types --------------------------------------------------------------------*/
+typedef struct {
+	bool ready;
+	uint32_t ready_since;                   /* Cycle counter when the task became ready */
+	uint32_t budget_cycles;
+	uint32_t runs;
+	uint32_t overruns;
+	uint32_t max_runtime_cycles;
+	uint32_t max_latency_cycles;
+	uint64_t total_runtime_cycles;
+} scheduler_slot_t;
+
+/* Static Variables -----------------------------------------------------------------*/
+static const scheduler_task_t *scheduler_tasks;
+static uint32_t scheduler_task_count;
+static scheduler_slot_t scheduler_slots[SCHEDULER_MAX_TASKS];
+static uint32_t scheduler_max_stall_cycles;     /* Longest task run of any task since the last reset */
+
+/* Private Functions ----------------------------------------------------------------*/
+static uint32_t scheduler_cycles_to_us(uint64_t cycles)
+{
+	return (uint32_t)((cycles * 1000000ULL) / cycle_counter_hz());
+}
+
+static void scheduler_mark_ready(uint32_t events)
+{
+	uint32_t now = cycle_counter_get();
+
+	for (uint32_t i = 0; i < scheduler_task_count; i++) {
+		if ((scheduler_tasks[i].events & events) != 0U && !scheduler_slots[i].ready) {
+			scheduler_slots[i].ready = true;
+			scheduler_slots[i].ready_since = now;
+		}
+	}
+}
+
+static void scheduler_dispatch(uint32_t task)
+{
+	scheduler_slot_t *slot = &scheduler_slots[task];
+	uint32_t start = cycle_counter_get();
+	uint32_t latency = start - slot->ready_since;
+
+	slot->ready = false;
+
+	bool more = scheduler_tasks[task].func(slot->budget_cycles);
+	uint32_t end = cycle_counter_get();
+	uint32_t runtime = end - start;
+
+	slot->runs++;
+	slot->total_runtime_cycles += runtime;
+	if (runtime > slot->max_runtime_cycles) {
+		slot->max_runtime_cycles = runtime;
+	}
+	if (runtime > scheduler_max_stall_cycles) {
+		scheduler_max_stall_cycles = runtime;
+	}
+	if (latency > slot->max_latency_cycles) {
+		slot->max_latency_cycles = latency;
+	}
+	if (runtime > slot->budget_cycles) {
+		slot->overruns++;
+		DLOG("task %u overran its budget: %u cycles", task, runtime);
+	}
+
+	if (more) {
+		slot->ready = true;
+		slot->ready_since = end;
+	}
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @brief Install the task table, highest priority first.
+ * @param tasks Kept by reference, must stay valid
+ * @return 0, or -1 if there are more than SCHEDULER_MAX_TASKS tasks
+ */
+int scheduler_init(const scheduler_task_t *tasks, uint32_t task_count)
+{
+	if (task_count > SCHEDULER_MAX_TASKS) {
+		return -1;
+	}
+
+	scheduler_tasks = tasks;
+	scheduler_task_count = task_count;
+
+	for (uint32_t i = 0; i < task_count; i++) {
+		scheduler_slots[i] = (scheduler_slot_t){
+			.ready = true,
+			.ready_since = cycle_counter_get(),
+			.budget_cycles = (uint32_t)(((uint64_t)tasks[i].budget_us * cycle_counter_hz()) / 1000000ULL),
+		};
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Run ready tasks by priority until none is left.
+ * @details Events posted while a task runs are picked up before the next pick.
+ */
+void scheduler_run(void)
+{
+	uint32_t events = event_loop_take();
+
+	for (;;) {
+		scheduler_mark_ready(events);
+
+		uint32_t task = 0;
+		while (task < scheduler_task_count && !scheduler_slots[task].ready) {
+			task++;
+		}
+
+		if (task == scheduler_task_count) {
+			return;
+		}
+
+		scheduler_dispatch(task);
+		events = event_loop_poll();
+	}
+}
+
+/**
+ * @brief Runtime and latency of a task since scheduler_init().
+ * @return false if there is no such task
+ */
+bool scheduler_get_stats(uint32_t task, scheduler_task_stats_t *stats)
+{
+	if (task >= scheduler_task_count) {
+		return false;
+	}
+
+	const scheduler_slot_t *slot = &scheduler_slots[task];
+
+	stats->runs = slot->runs;
+	stats->overruns = slot->overruns;
+	stats->max_runtime_us = scheduler_cycles_to_us(slot->max_runtime_cycles);
+	stats->max_latency_us = scheduler_cycles_to_us(slot->max_latency_cycles);
+	stats->total_runtime_us = slot->total_runtime_cycles / (cycle_counter_hz() / 1000000U);
+
+	return true;
+}
+
+/**
+ * @brief Restart the measurement of the longest task run.
+ */
+void scheduler_reset_max_stall(void)
+{
+	scheduler_max_stall_cycles = 0;
+}
+
+/**
+ * @brief Longest run of any task since scheduler_reset_max_stall(), the longest the
+ *        main loop could not serve anything else.
+ */
+uint32_t scheduler_get_max_stall_us(void)
+{
+	return scheduler_cycles_to_us(scheduler_max_stall_cycles);
+}
@@ -0,0 +1,54 @@
+/**
+ * @file scheduler.h
+ * @brief Cooperative, strictly prioritized scheduler for the bootloader main loop
+ * @details Tasks are listed in priority order. A task becomes ready when one of its
+ *          event_loop events is posted, or when its last run reported more work.
+ *          After every task run the scheduler picks the highest-priority ready task
+ *          again, so a higher-priority task never waits for more than the run of one
+ *          lower-priority task.
+ *
+ *          The budget is passed to the task, which is expected to stop and report
+ *          more work once it is spent. Tasks that cannot be split (bootloader_tick)
+ *          are only measured: a run longer than its budget is counted as an overrun.
+ *          Runtime and latency (from the pass that found the task ready to its start)
+ *          are measured with the cycle counter.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+/* General defines ------------------------------------------------------------------*/
+#define SCHEDULER_MAX_TASKS                 8U
+
+/* Public Types ---------------------------------------------------------------------*/
+/**
+ * @brief Task entry point.
+ * @param budget_cycles Cycles the task may run for before yielding
+ * @return true when work is left, to be run again as soon as higher-priority tasks allow
+ */
+typedef bool (*scheduler_task_func_t)(uint32_t budget_cycles);
+
+typedef struct {
+	scheduler_task_func_t func;
+	uint32_t events;                        /* EVENT_LOOP_* making the task ready */
+	uint32_t budget_us;
+} scheduler_task_t;
+
+typedef struct {
+	uint32_t runs;
+	uint32_t overruns;                      /* Runs longer than the budget */
+	uint32_t max_runtime_us;
+	uint32_t max_latency_us;                /* Worst wait from ready to start */
+	uint64_t total_runtime_us;
+} scheduler_task_stats_t;
+
+/* Public Functions ------------------------------------------------------------------*/
+int scheduler_init(const scheduler_task_t *tasks, uint32_t task_count);
+void scheduler_run(void);
+bool scheduler_get_stats(uint32_t task, scheduler_task_stats_t *stats);
+void scheduler_reset_max_stall(void);
+uint32_t scheduler_get_max_stall_us(void);
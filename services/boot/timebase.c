@@ -0,0 +1,146 @@
+/**
+ * @file timebase.c
+ * @brief Free-running 32-bit microsecond timebase
+ * @details TIM2 is driven through its registers, the TIM HAL driver is not part of
+ *          this project. The millisecond count is carried forward from the last
+ *          reading, so it keeps the full 32-bit range of the SysTick count it
+ *          replaces instead of wrapping with the microsecond counter. It needs to be
+ *          read once per wrap of TIM2, which the main loop does every millisecond.
+ * @date 19/10/2026
+ */
+
+/* Private Includes ------------------------------------------------------------------*/
+#if defined(__arm__)
+#include "main.h"
+#endif
+#include "timebase.h"
+#include "sf_bootloader_hal.h"
+
+/* Private types --------------------------------------------------------------------*/
+typedef struct {
+	bool running;
+	uint32_t ms;                            /* Count at last_us */
+	uint32_t last_us;                       /* Reading the count was last carried to */
+} timebase_t;
+
+/* Public Variables -----------------------------------------------------------------*/
+#if !defined(__arm__) && defined(TIMEBASE_SIMULATED)
+uint32_t timebase_simulated_us;
+#endif
+
+/* Static Variables -----------------------------------------------------------------*/
+static timebase_t timebase;
+
+#if defined(__arm__)
+uint32_t __real_sf_bootloader_hal_get_1ms_counter(void);
+
+/* Private Functions ----------------------------------------------------------------*/
+/* APB1 timer kernel clock, RM0481 "Timers clock" */
+static uint32_t timebase_timer_clock_hz(void)
+{
+	uint32_t pclk1 = HAL_RCC_GetPCLK1Freq();
+	uint32_t ppre1 = (RCC->CFGR2 & RCC_CFGR2_PPRE1_Msk) >> RCC_CFGR2_PPRE1_Pos;
+
+	/* PPRE1 below 4 is a division by 1 */
+	if (ppre1 < 4U) {
+		return pclk1;
+	}
+
+	if ((RCC->CFGR1 & RCC_CFGR1_TIMPRE_Msk) == 0U) {
+		return pclk1 * 2U;
+	}
+
+	/* TIMPRE set: HCLK up to a division by 4, 4 x PCLK1 above */
+	return (ppre1 <= 5U) ? HAL_RCC_GetHCLKFreq() : pclk1 * 4U;
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @brief Start TIM2 at 1 MHz.
+ * @note  Call after SystemClock_Config(), the prescaler follows the final clock.
+ */
+void timebase_init(void)
+{
+	RCC->APB1LENR |= RCC_APB1LENR_TIM2EN;
+	(void)RCC->APB1LENR;
+
+	TIMEBASE_TIM->CR1 = 0;
+	TIMEBASE_TIM->PSC = (timebase_timer_clock_hz() / 1000000U) - 1U;
+	TIMEBASE_TIM->ARR = 0xFFFFFFFFU;
+	TIMEBASE_TIM->CNT = 0;
+	TIMEBASE_TIM->EGR = TIM_EGR_UG;             /* Load the prescaler */
+	TIMEBASE_TIM->SR = 0;
+	TIMEBASE_TIM->CR1 = TIM_CR1_CEN;
+
+	timebase.ms = __real_sf_bootloader_hal_get_1ms_counter();
+	timebase.last_us = 0;
+	timebase.running = true;
+}
+
+/**
+ * @brief Leave TIM2 as after reset, before the jump to the application.
+ */
+void timebase_deinit(void)
+{
+	timebase.running = false;
+
+	RCC->APB1LRSTR |= RCC_APB1LRSTR_TIM2RST;
+	RCC->APB1LRSTR &= ~RCC_APB1LRSTR_TIM2RST;
+	RCC->APB1LENR &= ~RCC_APB1LENR_TIM2EN;
+}
+
+/**
+ * @brief The bootloader millisecond counter, from TIM2 once it runs.
+ */
+uint32_t __wrap_sf_bootloader_hal_get_1ms_counter(void)
+{
+	if (!timebase.running) {
+		return __real_sf_bootloader_hal_get_1ms_counter();
+	}
+
+	return timebase_ms();
+}
+
+#else
+
+/* Public Functions -----------------------------------------------------------------*/
+void timebase_init(void)
+{
+	timebase.ms = 0;
+	timebase.last_us = timebase_us();
+	timebase.running = true;
+}
+
+void timebase_deinit(void)
+{
+	timebase.running = false;
+}
+
+#endif
+
+/**
+ * @brief Milliseconds since timebase_init(), or since reset once
+ *        sf_bootloader_hal_get_1ms_counter() is derived from it.
+ * @details Callable from interrupts: the carry is done with interrupts masked.
+ */
+uint32_t timebase_ms(void)
+{
+#if defined(__arm__)
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+#endif
+
+	uint32_t now = timebase_us();
+	uint32_t elapsed_ms = (now - timebase.last_us) / 1000U;
+
+	timebase.ms += elapsed_ms;
+	timebase.last_us += elapsed_ms * 1000U;
+
+	uint32_t ms = timebase.ms;
+
+#if defined(__arm__)
+	__set_PRIMASK(primask);
+#endif
+
+	return ms;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file timebase.h
+ * @brief Free-running 32-bit microsecond timebase
+ * @details On target this is TIM2, a 32-bit timer prescaled to 1 MHz, which wraps
+ *          every 71.6 minutes. Differences of two readings are correct across the
+ *          wrap as long as they are shorter than that, so time is always compared
+ *          with the helpers below, never with < on raw readings.
+ *
+ *          Once timebase_init() has run, sf_bootloader_hal_get_1ms_counter() is
+ *          derived from it (linked with --wrap), continuing from the SysTick count.
+ *          On the host the same API counts microseconds of the monotonic clock, or
+ *          of a simulated clock in builds with TIMEBASE_SIMULATED, which the code
+ *          driving the simulation advances.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(__arm__)
+#include "stm32h5xx.h"
+
+#define TIMEBASE_TIM                        TIM2
+
+/* Public Functions ------------------------------------------------------------------*/
+static inline uint32_t timebase_us(void)
+{
+	return TIMEBASE_TIM->CNT;
+}
+
+#elif defined(TIMEBASE_SIMULATED)
+
+/* Public Variables ------------------------------------------------------------------*/
+extern uint32_t timebase_simulated_us;
+
+/* Public Functions ------------------------------------------------------------------*/
+static inline uint32_t timebase_us(void)
+{
+	return timebase_simulated_us;
+}
+
+#else
+#include <time.h>
+
+/* Public Functions ------------------------------------------------------------------*/
+static inline uint32_t timebase_us(void)
+{
+	struct timespec now;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint32_t)(((uint64_t)now.tv_sec * 1000000ULL) + ((uint64_t)now.tv_nsec / 1000ULL));
+}
+
+#endif
+
+/* Microseconds since a reading */
+static inline uint32_t timebase_elapsed_us(uint32_t since_us)
+{
+	return timebase_us() - since_us;
+}
+
+/* Whether reading a is later than reading b */
+static inline bool timebase_after(uint32_t a_us, uint32_t b_us)
+{
+	return (int32_t)(a_us - b_us) > 0;
+}
+
+/* Whether a deadline computed as timebase_us() + timeout has passed */
+static inline bool timebase_expired(uint32_t deadline_us)
+{
+	return (int32_t)(timebase_us() - deadline_us) >= 0;
+}
+
+void timebase_init(void);
+void timebase_deinit(void);
+uint32_t timebase_ms(void);
@@ -0,0 +1,233 @@
+/**
+ * @file update_report.c
+ * @brief Performance metrics of an update session
+ * @details Retransmissions are counted from the burst requests on the bus: a request
+ *          for packets before the highest one already requested asks for them again.
+ *          The packets of a burst follow its request in order, so a packet before the
+ *          highest one already received is a retransmission and is left out of the
+ *          image bytes and the throughput.
+ *          Outgoing frames are seen through a --wrap of sf_can_send_message(), the
+ *          erase time through a --wrap of HAL_FLASHEx_Erase().
+ * @date 19/10/2026
+ */
+
+/* Private Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include "update_report.h"
+#include "can_message_handler.h"
+#include "cycle_counter.h"
+#include "scheduler.h"
+#include "sf_bootloader_hal.h"
+#include "dlog.h"
+
+/* Private defines ------------------------------------------------------------------*/
+#define UPDATE_REPORT_STAGE_DEPTH           4U
+
+/* Private types --------------------------------------------------------------------*/
+typedef struct {
+	update_report_state_e state;
+	uint32_t start_ms;
+	uint32_t duration_ms;
+	uint32_t bytes_received;                /* Each packet counted once */
+	uint32_t raw_bytes_received;
+	uint32_t retransmitted_packets;
+	uint32_t next_packet;                   /* One past the highest packet requested */
+	uint32_t burst_packet;                  /* Packet expected next in the current burst */
+	uint32_t received_end;                  /* One past the highest packet received */
+	uint32_t max_stall_us;
+	uint64_t stage_cycles[UPDATE_REPORT_STAGE_COUNT];
+
+	/* Stages in progress, innermost last */
+	update_report_stage_e stages[UPDATE_REPORT_STAGE_DEPTH];
+	uint32_t stage_depth;
+	uint32_t stage_mark;                    /* Cycle counter when the innermost stage was last charged */
+} update_report_t;
+
+/* Static Variables -----------------------------------------------------------------*/
+static update_report_t update_report;
+
+/* Private Functions ----------------------------------------------------------------*/
+static uint32_t update_report_cycles_to_us(uint64_t cycles)
+{
+	return (uint32_t)(cycles / (cycle_counter_hz() / 1000000U));
+}
+
+/* Charge the time since the last mark to the innermost stage */
+static void update_report_charge(uint32_t now)
+{
+	uint32_t depth = update_report.stage_depth;
+
+	if (depth > UPDATE_REPORT_STAGE_DEPTH) {
+		depth = UPDATE_REPORT_STAGE_DEPTH;
+	}
+	if (depth != 0U && update_report.state == UPDATE_REPORT_STATE_RUNNING) {
+		update_report.stage_cycles[update_report.stages[depth - 1U]] += now - update_report.stage_mark;
+	}
+
+	update_report.stage_mark = now;
+}
+
+static void update_report_start(void)
+{
+	update_report.state = UPDATE_REPORT_STATE_RUNNING;
+	update_report.start_ms = sf_bootloader_hal_get_1ms_counter();
+	update_report.duration_ms = 0;
+	update_report.bytes_received = 0;
+	update_report.raw_bytes_received = 0;
+	update_report.retransmitted_packets = 0;
+	update_report.next_packet = 0;
+	update_report.burst_packet = 0;
+	update_report.received_end = 0;
+	update_report.max_stall_us = 0;
+	for (uint32_t i = 0; i < UPDATE_REPORT_STAGE_COUNT; i++) {
+		update_report.stage_cycles[i] = 0;
+	}
+	update_report.stage_mark = cycle_counter_get();
+
+	scheduler_reset_max_stall();
+}
+
+static void update_report_finish(void)
+{
+	update_report.duration_ms = sf_bootloader_hal_get_1ms_counter() - update_report.start_ms;
+	update_report.max_stall_us = scheduler_get_max_stall_us();
+	update_report.state = UPDATE_REPORT_STATE_FINISHED;
+
+	DLOG("update finished in %u ms, %u bytes, %u received, %u packets again", update_report.duration_ms,
+			update_report.bytes_received, update_report.raw_bytes_received, update_report.retransmitted_packets);
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @brief A bootloader protocol message was received from the tester.
+ * @param size Payload size, ECU code excluded
+ */
+void update_report_rx(data_comm_msg_type_t type, uint16_t size)
+{
+	if (type == DATA_COMM_MSG_TYPE_INFO) {
+		update_report_start();
+	} else if (type == DATA_COMM_MSG_TYPE_BURST_PACKET && update_report.state == UPDATE_REPORT_STATE_RUNNING) {
+		update_report.raw_bytes_received += size;
+
+		if (update_report.burst_packet >= update_report.received_end) {
+			update_report.bytes_received += size;
+			update_report.received_end = update_report.burst_packet + 1U;
+		}
+		update_report.burst_packet++;
+	}
+}
+
+/**
+ * @brief A frame is sent on the bus.
+ */
+void update_report_tx(uint32_t identifier, const uint8_t *data, uint32_t length)
+{
+	if (update_report.state != UPDATE_REPORT_STATE_RUNNING) {
+		return;
+	}
+
+	if (identifier == CAN_MSG_SEND_BURST_REQUEST_ID && length >= CAN_MSG_SEND_PACKET_REQUEST_LENGTH) {
+		uint32_t first = (uint32_t)data[CAN_MSG_SEND_PACKET_REQ_SEQUENCE_NUM_BYTE_0_INDEX] |
+				((uint32_t)data[CAN_MSG_SEND_PACKET_REQ_SEQUENCE_NUM_BYTE_1_INDEX] << 8) |
+				((uint32_t)data[CAN_MSG_SEND_PACKET_REQ_SEQUENCE_NUM_BYTE_2_INDEX] << 16);
+		uint32_t end = first + data[CAN_MSG_SEND_PACKET_REQ_PACKETS_NUM_BYTE_INDEX];
+
+		if (first < update_report.next_packet) {
+			update_report.retransmitted_packets += ((end < update_report.next_packet) ? end : update_report.next_packet) - first;
+		}
+		if (end > update_report.next_packet) {
+			update_report.next_packet = end;
+		}
+		update_report.burst_packet = first;
+	} else if (identifier == CAN_MSG_SEND_FINISH_REPORT_ID) {
+		update_report_finish();
+	}
+}
+
+/**
+ * @brief Enter a stage, pausing the current one. Calls nest, each is closed
+ *        with update_report_stage_end().
+ */
+void update_report_stage_begin(update_report_stage_e stage)
+{
+	update_report_charge(cycle_counter_get());
+
+	if (update_report.stage_depth < UPDATE_REPORT_STAGE_DEPTH) {
+		update_report.stages[update_report.stage_depth] = stage;
+	}
+	update_report.stage_depth++;
+}
+
+void update_report_stage_end(void)
+{
+	update_report_charge(cycle_counter_get());
+
+	if (update_report.stage_depth != 0U) {
+		update_report.stage_depth--;
+	}
+}
+
+/**
+ * @brief Value of a metric, for the running session or the last finished one.
+ */
+uint32_t update_report_get(update_report_metric_e metric)
+{
+	uint32_t duration_ms = update_report.duration_ms;
+	uint32_t max_stall_us = update_report.max_stall_us;
+
+	if (update_report.state == UPDATE_REPORT_STATE_RUNNING) {
+		duration_ms = sf_bootloader_hal_get_1ms_counter() - update_report.start_ms;
+		max_stall_us = scheduler_get_max_stall_us();
+	}
+
+	switch (metric) {
+		case UPDATE_REPORT_STATE:
+			return (uint32_t)update_report.state;
+		case UPDATE_REPORT_DURATION_MS:
+			return duration_ms;
+		case UPDATE_REPORT_BYTES_RECEIVED:
+			return update_report.bytes_received;
+		case UPDATE_REPORT_THROUGHPUT_BPS:
+			return (duration_ms != 0U) ? (uint32_t)(((uint64_t)update_report.bytes_received * 1000U) / duration_ms) : 0U;
+		case UPDATE_REPORT_RETRANSMITTED_PACKETS:
+			return update_report.retransmitted_packets;
+		case UPDATE_REPORT_ERASE_US:
+		case UPDATE_REPORT_PROGRAM_US:
+		case UPDATE_REPORT_DECRYPT_US:
+		case UPDATE_REPORT_HASH_US:
+		case UPDATE_REPORT_VERIFY_US:
+			return update_report_cycles_to_us(update_report.stage_cycles[metric - UPDATE_REPORT_ERASE_US]);
+		case UPDATE_REPORT_MAX_STALL_US:
+			return max_stall_us;
+		case UPDATE_REPORT_RAW_BYTES_RECEIVED:
+			return update_report.raw_bytes_received;
+		default:
+			return 0U;
+	}
+}
+
+#if defined(__arm__)
+#include "stm32h5xx_hal.h"
+
+int __real_sf_can_send_message(uint8_t peripheral, can_message_tx_t frame);
+int __wrap_sf_can_send_message(uint8_t peripheral, can_message_tx_t frame);
+HAL_StatusTypeDef __real_HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError);
+HAL_StatusTypeDef __wrap_HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError);
+
+int __wrap_sf_can_send_message(uint8_t peripheral, can_message_tx_t frame)
+{
+	update_report_tx(frame.identifier, frame.data, frame.data_length);
+
+	return __real_sf_can_send_message(peripheral, frame);
+}
+
+HAL_StatusTypeDef __wrap_HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError)
+{
+	update_report_stage_begin(UPDATE_REPORT_STAGE_ERASE);
+	HAL_StatusTypeDef status = __real_HAL_FLASHEx_Erase(pEraseInit, SectorError);
+	update_report_stage_end();
+
+	return status;
+}
+
+#endif
@@ -0,0 +1,62 @@
+/**
+ * @file update_report.h
+ * @brief Performance metrics of an update session
+ * @details A session starts with the info message of the tester and ends with the
+ *          finish report of the bootloader core. In between, the image bytes
+ *          received, the burst bytes received, the packets requested again, the time spent in each stage and the longest
+ *          scheduler task run are recorded. The metrics are returned on the CAN
+ *          update report request, one frame per metric, and stay readable until the
+ *          next session starts.
+ *
+ *          Stage times are exclusive: a stage started inside another one (an erase
+ *          while programming, the digest of programmed data) pauses the outer one.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "bootloader.h"
+
+/* General defines ------------------------------------------------------------------*/
+#define UPDATE_REPORT_VERSION               2U
+
+/* Public Types ---------------------------------------------------------------------*/
+typedef enum {
+	UPDATE_REPORT_STAGE_ERASE = 0,      /* FLASH sector erase */
+	UPDATE_REPORT_STAGE_PROGRAM,        /* FLASH programming */
+	UPDATE_REPORT_STAGE_DECRYPT,        /* BTEA */
+	UPDATE_REPORT_STAGE_HASH,           /* SHA-256 and CRC32 of programmed data */
+	UPDATE_REPORT_STAGE_VERIFY,         /* Signatures and read back */
+	UPDATE_REPORT_STAGE_COUNT
+} update_report_stage_e;
+
+typedef enum {
+	UPDATE_REPORT_STATE = 0,            /* update_report_state_e */
+	UPDATE_REPORT_DURATION_MS,
+	UPDATE_REPORT_BYTES_RECEIVED,       /* Image payload, each packet counted once */
+	UPDATE_REPORT_THROUGHPUT_BPS,       /* Image bytes received per second */
+	UPDATE_REPORT_RETRANSMITTED_PACKETS,
+	UPDATE_REPORT_ERASE_US,
+	UPDATE_REPORT_PROGRAM_US,
+	UPDATE_REPORT_DECRYPT_US,
+	UPDATE_REPORT_HASH_US,
+	UPDATE_REPORT_VERIFY_US,
+	UPDATE_REPORT_MAX_STALL_US,         /* Longest scheduler task run */
+	UPDATE_REPORT_RAW_BYTES_RECEIVED,   /* Burst payload, retransmissions included */
+	UPDATE_REPORT_METRIC_COUNT
+} update_report_metric_e;
+
+typedef enum {
+	UPDATE_REPORT_STATE_NONE = 0,
+	UPDATE_REPORT_STATE_RUNNING,
+	UPDATE_REPORT_STATE_FINISHED,
+} update_report_state_e;
+
+/* Public Functions ------------------------------------------------------------------*/
+void update_report_rx(data_comm_msg_type_t type, uint16_t size);
+void update_report_tx(uint32_t identifier, const uint8_t *data, uint32_t length);
+void update_report_stage_begin(update_report_stage_e stage);
+void update_report_stage_end(void);
+uint32_t update_report_get(update_report_metric_e metric);
@@ -15,12 +15,60 @@
 #include "sf_bootloader_hal.h"
 #include "sf_can_hal.h"
 #include "sf_timer_hal.h"
+#include "fw_manifest.h"
+#include "listen_window.h"
+#include "boot_timeline.h"
+#include "event_loop.h"
+#include "cycle_counter.h"
+#include "timebase.h"
+#include "dlog.h"
+#include "update_report.h"
+#include "profile_zone.h"
 
 
 #define FDCAN_PERIPHERAL 1
 
 /* Forward declaration */
 static void can_message_handler_ECU_status_periodic(uint8_t ecu_id, uint8_t status, uint8_t boot_version);
+static void can_message_handler_manifest_status(uint8_t ecu_id, fw_manifest_status_e status);
+static void can_message_handler_boot_timeline(uint8_t ecu_id);
+static void can_message_handler_loop_stats(uint8_t ecu_id);
+static void can_message_handler_dlog(uint8_t ecu_id);
+static void can_message_handler_update_report(uint8_t ecu_id);
+#if BOOTLOADER_PROFILING
+static void can_message_handler_profile_zones(uint8_t ecu_id);
+#endif
+
+/* Next boot timeline phase to send, BOOT_TIMELINE_PHASE_COUNT when none was requested */
+static uint32_t boot_timeline_next_phase = BOOT_TIMELINE_PHASE_COUNT;
+
+/* Next update report metric to send, UPDATE_REPORT_METRIC_COUNT when none was requested */
+static uint32_t update_report_next_metric = UPDATE_REPORT_METRIC_COUNT;
+
+#if BOOTLOADER_PROFILING
+/* Next profiling zone value to send, zone * PROFILE_ZONE_VALUE_COUNT + value */
+static uint32_t profile_zone_next_value = PROFILE_ZONE_COUNT * PROFILE_ZONE_VALUE_COUNT;
+#endif
+
+/* A validated manifest whose status is reported once the upgrade slot is scanned */
+static bool manifest_scan_pending = false;
+
+/* First reception interrupt not yet served, and the worst time it took to serve one */
+static volatile bool rx_irq_pending = false;
+static volatile uint32_t rx_irq_us = 0U;
+static uint32_t rx_latency_max_us = 0U;
+
+/* Deferred log drain in progress */
+static struct {
+    bool active;
+    bool header_sent;
+    uint32_t index;                 /* Record being sent */
+    uint32_t end;                   /* Head of the ring when the drain was requested */
+    uint32_t part;                  /* Next frame of the record */
+    uint8_t record[CAN_MSG_SEND_DLOG_PARTS * CAN_MSG_SEND_DLOG_PART_SIZE];
+} dlog_drain;
+
+_Static_assert(sizeof(dlog_record_t) == sizeof(dlog_drain.record), "A log record must fill the drain frames");
 
 void can_message_handler_init(void) {
     can_filter_message_t can_filter_message = {0};
@@ -42,7 +90,7 @@ void can_message_handler_init(void) {
       .filter_type = SF_FDCAN_FILTER_RANGE,
       .filter_config = SF_FDCAN_FILTER_TO_RXFIFO0,
       .filter_id1 = CAN_MSG_RECV_REQUEST_RUN_MODE_ID,
-      .filter_id2 = CAN_MSG_RECV_DATABURST_COMPLETE_MESSAGE_ID,
+      .filter_id2 = CAN_MSG_RECV_PROFILE_ZONE_REQUEST_ID,
   };
 
 //   Configure CAN ID filtering
@@ -71,6 +119,14 @@ void can_message_handler_init(void) {
  */
 void can_message_handler_process_frame(const can_message_rx_t *frame, uint8_t ecu_id)
 {
+    /* Any bootloader frame keeps the listen window open, a request for this ECU hands it over to the core */
+    if (frame->identifier_type != SF_FDCAN_STANDARD_ID &&
+        (frame->identifier == CAN_MSG_RECV_REQUEST_RUN_MODE_ID || frame->identifier == CAN_MSG_RECV_PREPARE_REQUEST_ID)) {
+        listen_window_request_seen(ecu_id == frame->data[CAN_MSG_ECU_CODE_BYTE_INDEX]);
+    } else {
+        listen_window_bus_active();
+    }
+
     if (ecu_id != frame->data[CAN_MSG_ECU_CODE_BYTE_INDEX] || frame->identifier_type==SF_FDCAN_STANDARD_ID){
         return;
     }
@@ -108,10 +164,57 @@ void can_message_handler_process_frame(const can_message_rx_t *frame, uint8_t ec
                 type = DATA_COMM_MSG_TYPE_BURST_COMPLETION;
             }
 
+            update_report_rx(type, size);
+            PROFILE_ZONE_BEGIN(PROFILE_ZONE_BOOTLOADER_RX);
             bootloader_rx_message_received((uint32_t) sf_bootloader_hal_get_1ms_counter(), type, ecu_id, relevant_data_pointer, size);
+            PROFILE_ZONE_END(PROFILE_ZONE_BOOTLOADER_RX);
             break;
         }
 
+        case CAN_MSG_RECV_MANIFEST_DATA_ID: {
+            if (frame->data_length <= CAN_MSG_RECV_MANIFEST_DATA_INDEX) {
+                break;
+            }
+
+            uint16_t offset = (uint16_t)frame->data[CAN_MSG_RECV_MANIFEST_OFFSET_BYTE_0_INDEX] |
+                              ((uint16_t)frame->data[CAN_MSG_RECV_MANIFEST_OFFSET_BYTE_1_INDEX] << 8);
+            fw_manifest_status_e status = fw_manifest_rx(offset, &(frame->data[CAN_MSG_RECV_MANIFEST_DATA_INDEX]),
+                                                         frame->data_length - CAN_MSG_RECV_MANIFEST_DATA_INDEX);
+
+            /* Report once the manifest has been refused, or accepted and the slot scanned */
+            manifest_scan_pending = (status == FW_MANIFEST_STATUS_SCANNING);
+            if (status != FW_MANIFEST_STATUS_SCANNING && status != FW_MANIFEST_STATUS_RECEIVING) {
+                can_message_handler_manifest_status(ecu_id, status);
+            }
+            break;
+        }
+
+        case CAN_MSG_RECV_BOOT_TIMELINE_REQUEST_ID:
+            boot_timeline_next_phase = 0U;
+            break;
+
+        case CAN_MSG_RECV_LOOP_STATS_REQUEST_ID:
+            can_message_handler_loop_stats(ecu_id);
+            break;
+
+        case CAN_MSG_RECV_DLOG_REQUEST_ID:
+            dlog_drain.active = true;
+            dlog_drain.header_sent = false;
+            dlog_drain.index = dlog_first();
+            dlog_drain.end = dlog_ring.head;
+            dlog_drain.part = 0U;
+            break;
+
+        case CAN_MSG_RECV_UPDATE_REPORT_REQUEST_ID:
+            update_report_next_metric = 0U;
+            break;
+
+#if BOOTLOADER_PROFILING
+        case CAN_MSG_RECV_PROFILE_ZONE_REQUEST_ID:
+            profile_zone_next_value = 0U;
+            break;
+#endif
+
         default:
             break;
     }
@@ -148,16 +251,303 @@ static void can_message_handler_ECU_status_periodic(uint8_t ecu_id, uint8_t app_
     }
 }
 
-void can_message_handler_task(uint8_t ecu_id, uint8_t app_status, uint8_t boot_version)
+static void can_message_handler_manifest_status(uint8_t ecu_id, fw_manifest_status_e status)
+{
+    can_message_tx_t status_frame = {0};
+    uint32_t verified_segments = fw_manifest_get_verified_segments();
+    uint32_t segment_count = fw_manifest_get_segment_count();
+
+    status_frame.identifier = CAN_MSG_SEND_MANIFEST_STATUS_ID;
+    status_frame.data_length = CAN_MSG_SEND_MANIFEST_STATUS_LENGTH;
+    status_frame.identifier_type = SF_FDCAN_EXTENDED_ID;
+    status_frame.tx_frame_type = SF_FDCAN_DATA_FRAME;
+
+    status_frame.data[CAN_MSG_ECU_CODE_BYTE_INDEX] = ecu_id;
+    status_frame.data[CAN_MSG_SEND_MANIFEST_STATUS_BYTE_INDEX] = (uint8_t)status;
+    status_frame.data[CAN_MSG_SEND_MANIFEST_VERIFIED_SEGMENTS_BYTE_0_INDEX] = (uint8_t)(verified_segments & 0xFF);
+    status_frame.data[CAN_MSG_SEND_MANIFEST_VERIFIED_SEGMENTS_BYTE_1_INDEX] = (uint8_t)((verified_segments >> 8) & 0xFF);
+    status_frame.data[CAN_MSG_SEND_MANIFEST_SEGMENT_COUNT_BYTE_0_INDEX] = (uint8_t)(segment_count & 0xFF);
+    status_frame.data[CAN_MSG_SEND_MANIFEST_SEGMENT_COUNT_BYTE_1_INDEX] = (uint8_t)((segment_count >> 8) & 0xFF);
+
+    sf_can_send_message(FDCAN_PERIPHERAL, status_frame);
+}
+
+/* One frame per phase and per task call, so the TX FIFO is never flooded */
+static void can_message_handler_boot_timeline(uint8_t ecu_id)
+{
+    if (boot_timeline_next_phase < BOOT_TIMELINE_PHASE_COUNT) {
+        uint32_t phase = boot_timeline_next_phase++;
+        can_message_tx_t timeline_frame = {0};
+        uint32_t time_us = boot_timeline_get_us((boot_timeline_phase_e)phase);
+
+        timeline_frame.identifier = CAN_MSG_SEND_BOOT_TIMELINE_ID;
+        timeline_frame.data_length = CAN_MSG_SEND_BOOT_TIMELINE_LENGTH;
+        timeline_frame.identifier_type = SF_FDCAN_EXTENDED_ID;
+        timeline_frame.tx_frame_type = SF_FDCAN_DATA_FRAME;
+
+        timeline_frame.data[CAN_MSG_ECU_CODE_BYTE_INDEX] = ecu_id;
+        timeline_frame.data[CAN_MSG_SEND_BOOT_TIMELINE_PHASE_BYTE_INDEX] = (uint8_t)phase;
+        timeline_frame.data[CAN_MSG_SEND_BOOT_TIMELINE_US_BYTE_0_INDEX] = (uint8_t)(time_us & 0xFF);
+        timeline_frame.data[CAN_MSG_SEND_BOOT_TIMELINE_US_BYTE_1_INDEX] = (uint8_t)((time_us >> 8) & 0xFF);
+        timeline_frame.data[CAN_MSG_SEND_BOOT_TIMELINE_US_BYTE_2_INDEX] = (uint8_t)((time_us >> 16) & 0xFF);
+        timeline_frame.data[CAN_MSG_SEND_BOOT_TIMELINE_US_BYTE_3_INDEX] = (uint8_t)((time_us >> 24) & 0xFF);
+        timeline_frame.data[CAN_MSG_SEND_BOOT_TIMELINE_VERSION_BYTE_INDEX] = BOOT_TIMELINE_VERSION;
+        timeline_frame.data[CAN_MSG_SEND_BOOT_TIMELINE_PHASE_COUNT_BYTE_INDEX] = BOOT_TIMELINE_PHASE_COUNT;
+
+        sf_can_send_message(FDCAN_PERIPHERAL, timeline_frame);
+    }
+}
+
+static void can_message_handler_loop_stats(uint8_t ecu_id)
+{
+    can_message_tx_t stats_frame = {0};
+    event_loop_stats_t stats;
+
+    event_loop_get_stats(&stats);
+
+    stats_frame.identifier = CAN_MSG_SEND_LOOP_STATS_ID;
+    stats_frame.data_length = CAN_MSG_SEND_LOOP_STATS_LENGTH;
+    stats_frame.identifier_type = SF_FDCAN_EXTENDED_ID;
+    stats_frame.tx_frame_type = SF_FDCAN_DATA_FRAME;
+
+    stats_frame.data[CAN_MSG_ECU_CODE_BYTE_INDEX] = ecu_id;
+    stats_frame.data[CAN_MSG_SEND_LOOP_STATS_ITERATIONS_BYTE_0_INDEX] = (uint8_t)(stats.iterations & 0xFF);
+    stats_frame.data[CAN_MSG_SEND_LOOP_STATS_ITERATIONS_BYTE_1_INDEX] = (uint8_t)((stats.iterations >> 8) & 0xFF);
+    stats_frame.data[CAN_MSG_SEND_LOOP_STATS_ITERATIONS_BYTE_2_INDEX] = (uint8_t)((stats.iterations >> 16) & 0xFF);
+    stats_frame.data[CAN_MSG_SEND_LOOP_STATS_ITERATIONS_BYTE_3_INDEX] = (uint8_t)((stats.iterations >> 24) & 0xFF);
+    stats_frame.data[CAN_MSG_SEND_LOOP_STATS_SLEEP_PERMILLE_BYTE_0_INDEX] = (uint8_t)(stats.sleep_permille & 0xFF);
+    stats_frame.data[CAN_MSG_SEND_LOOP_STATS_SLEEP_PERMILLE_BYTE_1_INDEX] = (uint8_t)((stats.sleep_permille >> 8) & 0xFF);
+    stats_frame.data[CAN_MSG_SEND_LOOP_STATS_RX_LATENCY_BYTE_INDEX] = (uint8_t)((rx_latency_max_us > 0xFFU) ? 0xFFU : rx_latency_max_us);
+
+    sf_can_send_message(FDCAN_PERIPHERAL, stats_frame);
+}
+
+/* One frame per metric and per task call, like the boot timeline */
+static void can_message_handler_update_report(uint8_t ecu_id)
+{
+    if (update_report_next_metric < UPDATE_REPORT_METRIC_COUNT) {
+        uint32_t metric = update_report_next_metric++;
+        can_message_tx_t report_frame = {0};
+        uint32_t value = update_report_get((update_report_metric_e)metric);
+
+        report_frame.identifier = CAN_MSG_SEND_UPDATE_REPORT_ID;
+        report_frame.data_length = CAN_MSG_SEND_UPDATE_REPORT_LENGTH;
+        report_frame.identifier_type = SF_FDCAN_EXTENDED_ID;
+        report_frame.tx_frame_type = SF_FDCAN_DATA_FRAME;
+
+        report_frame.data[CAN_MSG_ECU_CODE_BYTE_INDEX] = ecu_id;
+        report_frame.data[CAN_MSG_SEND_UPDATE_REPORT_METRIC_BYTE_INDEX] = (uint8_t)metric;
+        report_frame.data[CAN_MSG_SEND_UPDATE_REPORT_VALUE_BYTE_0_INDEX] = (uint8_t)(value & 0xFF);
+        report_frame.data[CAN_MSG_SEND_UPDATE_REPORT_VALUE_BYTE_1_INDEX] = (uint8_t)((value >> 8) & 0xFF);
+        report_frame.data[CAN_MSG_SEND_UPDATE_REPORT_VALUE_BYTE_2_INDEX] = (uint8_t)((value >> 16) & 0xFF);
+        report_frame.data[CAN_MSG_SEND_UPDATE_REPORT_VALUE_BYTE_3_INDEX] = (uint8_t)((value >> 24) & 0xFF);
+        report_frame.data[CAN_MSG_SEND_UPDATE_REPORT_VERSION_BYTE_INDEX] = UPDATE_REPORT_VERSION;
+        report_frame.data[CAN_MSG_SEND_UPDATE_REPORT_METRIC_COUNT_BYTE_INDEX] = UPDATE_REPORT_METRIC_COUNT;
+
+        sf_can_send_message(FDCAN_PERIPHERAL, report_frame);
+    }
+}
+
+#if BOOTLOADER_PROFILING
+/* One frame per zone value and per task call, like the boot timeline */
+static void can_message_handler_profile_zones(uint8_t ecu_id)
+{
+    if (profile_zone_next_value < (PROFILE_ZONE_COUNT * PROFILE_ZONE_VALUE_COUNT)) {
+        uint32_t zone = profile_zone_next_value / PROFILE_ZONE_VALUE_COUNT;
+        uint32_t kind = profile_zone_next_value % PROFILE_ZONE_VALUE_COUNT;
+        can_message_tx_t zone_frame = {0};
+        uint32_t value = profile_zone_get((profile_zone_e)zone, (profile_zone_value_e)kind);
+
+        profile_zone_next_value++;
+
+        zone_frame.identifier = CAN_MSG_SEND_PROFILE_ZONE_ID;
+        zone_frame.data_length = CAN_MSG_SEND_PROFILE_ZONE_LENGTH;
+        zone_frame.identifier_type = SF_FDCAN_EXTENDED_ID;
+        zone_frame.tx_frame_type = SF_FDCAN_DATA_FRAME;
+
+        zone_frame.data[CAN_MSG_ECU_CODE_BYTE_INDEX] = ecu_id;
+        zone_frame.data[CAN_MSG_SEND_PROFILE_ZONE_SELECTOR_BYTE_INDEX] = (uint8_t)((zone << CAN_MSG_SEND_PROFILE_ZONE_SELECTOR_ZONE_SHIFT) | kind);
+        zone_frame.data[CAN_MSG_SEND_PROFILE_ZONE_VALUE_BYTE_0_INDEX] = (uint8_t)(value & 0xFF);
+        zone_frame.data[CAN_MSG_SEND_PROFILE_ZONE_VALUE_BYTE_1_INDEX] = (uint8_t)((value >> 8) & 0xFF);
+        zone_frame.data[CAN_MSG_SEND_PROFILE_ZONE_VALUE_BYTE_2_INDEX] = (uint8_t)((value >> 16) & 0xFF);
+        zone_frame.data[CAN_MSG_SEND_PROFILE_ZONE_VALUE_BYTE_3_INDEX] = (uint8_t)((value >> 24) & 0xFF);
+        zone_frame.data[CAN_MSG_SEND_PROFILE_ZONE_VERSION_BYTE_INDEX] = PROFILE_ZONE_VERSION;
+        zone_frame.data[CAN_MSG_SEND_PROFILE_ZONE_ZONE_COUNT_BYTE_INDEX] = PROFILE_ZONE_COUNT;
+
+        sf_can_send_message(FDCAN_PERIPHERAL, zone_frame);
+    }
+}
+#endif
+
+/* One frame per task call, like the boot timeline. Records overwritten while the
+ * drain runs are skipped, the decoder sees the gap in the record index. */
+static void can_message_handler_dlog(uint8_t ecu_id)
+{
+    if (!dlog_drain.active) {
+        return;
+    }
+
+    can_message_tx_t dlog_frame = {0};
+
+    dlog_frame.identifier = CAN_MSG_SEND_DLOG_ID;
+    dlog_frame.data_length = CAN_MSG_SEND_DLOG_LENGTH;
+    dlog_frame.identifier_type = SF_FDCAN_EXTENDED_ID;
+    dlog_frame.tx_frame_type = SF_FDCAN_DATA_FRAME;
+    dlog_frame.data[CAN_MSG_ECU_CODE_BYTE_INDEX] = ecu_id;
+
+    if (!dlog_drain.header_sent) {
+        uint32_t count = dlog_drain.end - dlog_drain.index;
+
+        dlog_frame.data[CAN_MSG_SEND_DLOG_SEQUENCE_BYTE_INDEX] = CAN_MSG_SEND_DLOG_SEQUENCE_HEADER;
+        dlog_frame.data[CAN_MSG_SEND_DLOG_HEADER_FIRST_BYTE_0_INDEX] = (uint8_t)(dlog_drain.index & 0xFF);
+        dlog_frame.data[CAN_MSG_SEND_DLOG_HEADER_FIRST_BYTE_1_INDEX] = (uint8_t)((dlog_drain.index >> 8) & 0xFF);
+        dlog_frame.data[CAN_MSG_SEND_DLOG_HEADER_FIRST_BYTE_2_INDEX] = (uint8_t)((dlog_drain.index >> 16) & 0xFF);
+        dlog_frame.data[CAN_MSG_SEND_DLOG_HEADER_FIRST_BYTE_3_INDEX] = (uint8_t)((dlog_drain.index >> 24) & 0xFF);
+        dlog_frame.data[CAN_MSG_SEND_DLOG_HEADER_COUNT_BYTE_INDEX] = (uint8_t)count;
+        dlog_frame.data[CAN_MSG_SEND_DLOG_HEADER_VERSION_BYTE_INDEX] = DLOG_VERSION;
+
+        sf_can_send_message(FDCAN_PERIPHERAL, dlog_frame);
+        dlog_drain.header_sent = true;
+        dlog_drain.active = (count != 0U);
+        return;
+    }
+
+    if (dlog_drain.part == 0U) {
+        dlog_record_t record;
+
+        while (!dlog_read(dlog_drain.index, &record)) {
+            if (++dlog_drain.index == dlog_drain.end) {
+                dlog_drain.active = false;
+                return;
+            }
+        }
+        memcpy(dlog_drain.record, &record, sizeof(dlog_drain.record));
+    }
+
+    dlog_frame.data[CAN_MSG_SEND_DLOG_SEQUENCE_BYTE_INDEX] = (uint8_t)(((dlog_drain.index & 0x1F) << 2) | dlog_drain.part);
+    memcpy(&dlog_frame.data[CAN_MSG_SEND_DLOG_DATA_INDEX], &dlog_drain.record[dlog_drain.part * CAN_MSG_SEND_DLOG_PART_SIZE],
+           CAN_MSG_SEND_DLOG_PART_SIZE);
+    sf_can_send_message(FDCAN_PERIPHERAL, dlog_frame);
+
+    if (++dlog_drain.part == CAN_MSG_SEND_DLOG_PARTS) {
+        dlog_release(dlog_drain.index);
+        dlog_drain.part = 0U;
+        dlog_drain.active = (++dlog_drain.index != dlog_drain.end);
+    }
+}
+
+/*!
+ ****************************************************************************
+ * @brief Processes the received frames until none is left or the budget is spent.
+ *
+ * @param[in] budget_cycles Cycle counter budget, checked after each frame.
+ * @return true if the budget ran out, frames may be left.
+ ****************************************************************************
+ */
+bool can_message_handler_drain(uint8_t ecu_id, uint32_t budget_cycles)
 {
     can_message_rx_t new_msg;
     uint8_t can_msg_rcv_data[MAX_DATA_LENGTH];
     new_msg.data = &can_msg_rcv_data[0];
+    uint32_t start = cycle_counter_get();
+
+    if (rx_irq_pending) {
+        uint32_t latency_us = timebase_elapsed_us(rx_irq_us);
+
+        rx_irq_pending = false;
+        if (latency_us > rx_latency_max_us) {
+            rx_latency_max_us = latency_us;
+        }
+    }
 
     /* Get lastest message received */
     while(sf_can_get_last_rx_filtered_message(&new_msg) == CAN_STATUS_OK) {
+        PROFILE_ZONE_BEGIN(PROFILE_ZONE_CAN_FRAME);
         can_message_handler_process_frame(&new_msg, ecu_id);
+        PROFILE_ZONE_END(PROFILE_ZONE_CAN_FRAME);
+
+        if ((cycle_counter_get() - start) >= budget_cycles) {
+            return true;
+        }
     }
 
+    return false;
+}
+
+/*!
+ ****************************************************************************
+ * @brief Scans one segment of the upgrade slot against a manifest just validated.
+ *
+ * The manifest status is sent once the scan is over, with the number of
+ * segments found. A SHA-256 of one segment is not split, the budget is only
+ * checked by the scheduler.
+ *
+ * @return true while segments are left to scan
+ ****************************************************************************
+ */
+bool can_message_handler_manifest_scan(uint8_t ecu_id, uint32_t budget_cycles)
+{
+    (void)budget_cycles;
+
+    if (!manifest_scan_pending) {
+        return false;
+    }
+
+    if (fw_manifest_scan()) {
+        return true;
+    }
+
+    manifest_scan_pending = false;
+    can_message_handler_manifest_status(ecu_id, fw_manifest_get_status());
+
+    return false;
+}
+
+/*!
+ ****************************************************************************
+ * @brief Stamps a reception, called from the FDCAN interrupt.
+ *
+ * Only the first interrupt before the next drain is stamped, the latency is
+ * the time until the drain starts.
+ ****************************************************************************
+ */
+void can_message_handler_rx_irq(void)
+{
+    if (!rx_irq_pending) {
+        rx_irq_us = timebase_us();
+        rx_irq_pending = true;
+    }
+}
+
+/*!
+ ****************************************************************************
+ * @brief Worst time from a reception interrupt to the start of its drain.
+ ****************************************************************************
+ */
+uint32_t can_message_handler_get_max_rx_latency_us(void)
+{
+    return rx_latency_max_us;
+}
+
+/*!
+ ****************************************************************************
+ * @brief Sends the periodic ECU status and the pending boot timeline frame.
+ ****************************************************************************
+ */
+void can_message_handler_heartbeat(uint8_t ecu_id, uint8_t app_status, uint8_t boot_version)
+{
     can_message_handler_ECU_status_periodic(ecu_id, app_status, boot_version);
+    can_message_handler_boot_timeline(ecu_id);
+    can_message_handler_dlog(ecu_id);
+    can_message_handler_update_report(ecu_id);
+#if BOOTLOADER_PROFILING
+    can_message_handler_profile_zones(ecu_id);
+#endif
+}
+
+void can_message_handler_task(uint8_t ecu_id, uint8_t app_status, uint8_t boot_version)
+{
+    (void)can_message_handler_drain(ecu_id, UINT32_MAX);
+    (void)can_message_handler_manifest_scan(ecu_id, UINT32_MAX);
+    can_message_handler_heartbeat(ecu_id, app_status, boot_version);
 }
@@ -24,6 +24,12 @@
 #define CAN_MSG_SEND_COMPLETION_MESSAGE_LENGTH                      8U
 #define CAN_MSG_SEND_ECU_STATUS_RESPONSE_LENGTH                     8U
 #define CAN_MSG_SEND_ERROR_MESSAGE_LENGTH                           8U
+#define CAN_MSG_SEND_MANIFEST_STATUS_LENGTH                         6U
+#define CAN_MSG_SEND_BOOT_TIMELINE_LENGTH                           8U
+#define CAN_MSG_SEND_LOOP_STATS_LENGTH                              8U
+#define CAN_MSG_SEND_DLOG_LENGTH                                    8U
+#define CAN_MSG_SEND_UPDATE_REPORT_LENGTH                           8U
+#define CAN_MSG_SEND_PROFILE_ZONE_LENGTH                            8U
 
 /* Start ACK message */
 #define CAN_MSG_SEND_START_ACK_BUFF_MAX_SIZE_BYTE_0_INDEX           1U
@@ -47,6 +53,68 @@
 #define CAN_MSG_RECV_PACKET_CRC_BYTE_0_INDEX                        1U
 #define CAN_MSG_RECV_PACKET_CRC_BYTE_1_INDEX                        2U
 
+/* Manifest data from VCU */
+#define CAN_MSG_RECV_MANIFEST_OFFSET_BYTE_0_INDEX                   1U
+#define CAN_MSG_RECV_MANIFEST_OFFSET_BYTE_1_INDEX                   2U
+#define CAN_MSG_RECV_MANIFEST_DATA_INDEX                            3U
+
+/* Manifest status message */
+#define CAN_MSG_SEND_MANIFEST_STATUS_BYTE_INDEX                     1U
+#define CAN_MSG_SEND_MANIFEST_VERIFIED_SEGMENTS_BYTE_0_INDEX        2U
+#define CAN_MSG_SEND_MANIFEST_VERIFIED_SEGMENTS_BYTE_1_INDEX        3U
+#define CAN_MSG_SEND_MANIFEST_SEGMENT_COUNT_BYTE_0_INDEX            4U
+#define CAN_MSG_SEND_MANIFEST_SEGMENT_COUNT_BYTE_1_INDEX            5U
+
+/* Boot timeline message, one per phase */
+#define CAN_MSG_SEND_BOOT_TIMELINE_PHASE_BYTE_INDEX                 1U
+#define CAN_MSG_SEND_BOOT_TIMELINE_US_BYTE_0_INDEX                  2U
+#define CAN_MSG_SEND_BOOT_TIMELINE_US_BYTE_1_INDEX                  3U
+#define CAN_MSG_SEND_BOOT_TIMELINE_US_BYTE_2_INDEX                  4U
+#define CAN_MSG_SEND_BOOT_TIMELINE_US_BYTE_3_INDEX                  5U
+#define CAN_MSG_SEND_BOOT_TIMELINE_VERSION_BYTE_INDEX               6U
+#define CAN_MSG_SEND_BOOT_TIMELINE_PHASE_COUNT_BYTE_INDEX           7U
+
+/* Main loop statistics message */
+#define CAN_MSG_SEND_LOOP_STATS_ITERATIONS_BYTE_0_INDEX             1U
+#define CAN_MSG_SEND_LOOP_STATS_ITERATIONS_BYTE_1_INDEX             2U
+#define CAN_MSG_SEND_LOOP_STATS_ITERATIONS_BYTE_2_INDEX             3U
+#define CAN_MSG_SEND_LOOP_STATS_ITERATIONS_BYTE_3_INDEX             4U
+#define CAN_MSG_SEND_LOOP_STATS_SLEEP_PERMILLE_BYTE_0_INDEX         5U
+#define CAN_MSG_SEND_LOOP_STATS_SLEEP_PERMILLE_BYTE_1_INDEX         6U
+#define CAN_MSG_SEND_LOOP_STATS_RX_LATENCY_BYTE_INDEX               7U
+
+/* Deferred log drain: a header frame, then each record in CAN_MSG_SEND_DLOG_PARTS frames */
+#define CAN_MSG_SEND_DLOG_SEQUENCE_BYTE_INDEX                       1U
+#define CAN_MSG_SEND_DLOG_DATA_INDEX                                2U
+#define CAN_MSG_SEND_DLOG_PART_SIZE                                 6U
+#define CAN_MSG_SEND_DLOG_PARTS                                     4U      /* sizeof(dlog_record_t) / CAN_MSG_SEND_DLOG_PART_SIZE */
+#define CAN_MSG_SEND_DLOG_SEQUENCE_HEADER                           0xFFU   /* Record frames: (index & 0x1F) << 2 | part */
+#define CAN_MSG_SEND_DLOG_HEADER_FIRST_BYTE_0_INDEX                 2U
+#define CAN_MSG_SEND_DLOG_HEADER_FIRST_BYTE_1_INDEX                 3U
+#define CAN_MSG_SEND_DLOG_HEADER_FIRST_BYTE_2_INDEX                 4U
+#define CAN_MSG_SEND_DLOG_HEADER_FIRST_BYTE_3_INDEX                 5U
+#define CAN_MSG_SEND_DLOG_HEADER_COUNT_BYTE_INDEX                   6U
+#define CAN_MSG_SEND_DLOG_HEADER_VERSION_BYTE_INDEX                 7U
+
+/* Update session report, one message per metric */
+#define CAN_MSG_SEND_UPDATE_REPORT_METRIC_BYTE_INDEX                1U
+#define CAN_MSG_SEND_UPDATE_REPORT_VALUE_BYTE_0_INDEX               2U
+#define CAN_MSG_SEND_UPDATE_REPORT_VALUE_BYTE_1_INDEX               3U
+#define CAN_MSG_SEND_UPDATE_REPORT_VALUE_BYTE_2_INDEX               4U
+#define CAN_MSG_SEND_UPDATE_REPORT_VALUE_BYTE_3_INDEX               5U
+#define CAN_MSG_SEND_UPDATE_REPORT_VERSION_BYTE_INDEX               6U
+#define CAN_MSG_SEND_UPDATE_REPORT_METRIC_COUNT_BYTE_INDEX          7U
+
+/* Profiling zones, one message per zone and value */
+#define CAN_MSG_SEND_PROFILE_ZONE_SELECTOR_BYTE_INDEX               1U      /* zone << 2 | value */
+#define CAN_MSG_SEND_PROFILE_ZONE_SELECTOR_ZONE_SHIFT               2U
+#define CAN_MSG_SEND_PROFILE_ZONE_VALUE_BYTE_0_INDEX                2U
+#define CAN_MSG_SEND_PROFILE_ZONE_VALUE_BYTE_1_INDEX                3U
+#define CAN_MSG_SEND_PROFILE_ZONE_VALUE_BYTE_2_INDEX                4U
+#define CAN_MSG_SEND_PROFILE_ZONE_VALUE_BYTE_3_INDEX                5U
+#define CAN_MSG_SEND_PROFILE_ZONE_VERSION_BYTE_INDEX                6U
+#define CAN_MSG_SEND_PROFILE_ZONE_ZONE_COUNT_BYTE_INDEX             7U
+
 
 
 #define CAN_MSG_ECU_CODE_BYTE_INDEX                     0U
@@ -73,7 +141,13 @@ typedef enum {
     CAN_MSG_RECV_INFO_MESSAGE_ID                        = 0x0001F102,
     CAN_MSG_RECV_BURST_CRC_ID                           = 0x0001F104,
     CAN_MSG_RECV_BURST_DATA_ID                          = 0x0001F105,
-    CAN_MSG_RECV_DATABURST_COMPLETE_MESSAGE_ID          = 0x0001F106
+    CAN_MSG_RECV_DATABURST_COMPLETE_MESSAGE_ID          = 0x0001F106,
+    CAN_MSG_RECV_MANIFEST_DATA_ID                       = 0x0001F10A,
+    CAN_MSG_RECV_BOOT_TIMELINE_REQUEST_ID               = 0x0001F10C,
+    CAN_MSG_RECV_LOOP_STATS_REQUEST_ID                  = 0x0001F10E,
+    CAN_MSG_RECV_DLOG_REQUEST_ID                        = 0x0001F110,
+    CAN_MSG_RECV_UPDATE_REPORT_REQUEST_ID               = 0x0001F112,
+    CAN_MSG_RECV_PROFILE_ZONE_REQUEST_ID                = 0x0001F114
 } can_recv_msg_ids_e;
 
 typedef enum {
@@ -94,7 +168,13 @@ typedef enum {
     CAN_MSG_SEND_BURST_REQUEST_ID 						= 0x0001F103,
 	CAN_MSG_SEND_COMPLETION_MESSAGE_ID					= 0x0001F107,
     CAN_MSG_SEND_ERROR_MESSAGE_ID 						= 0x0001F108,
-    CAN_MSG_SEND_FINISH_REPORT_ID                       = 0x0001F109
+    CAN_MSG_SEND_FINISH_REPORT_ID                       = 0x0001F109,
+    CAN_MSG_SEND_MANIFEST_STATUS_ID                     = 0x0001F10B,
+    CAN_MSG_SEND_BOOT_TIMELINE_ID                       = 0x0001F10D,
+    CAN_MSG_SEND_LOOP_STATS_ID                          = 0x0001F10F,
+    CAN_MSG_SEND_DLOG_ID                                = 0x0001F111,
+    CAN_MSG_SEND_UPDATE_REPORT_ID                       = 0x0001F113,
+    CAN_MSG_SEND_PROFILE_ZONE_ID                        = 0x0001F115
 } can_send_msg_ids_e;
 
 /*!
@@ -111,6 +191,11 @@ typedef enum {
 void can_message_handler_init(void);
 void can_message_handler_process_frame(const can_message_rx_t *frame, uint8_t ecu_id);
 void can_message_handler_task(uint8_t ecu_id, uint8_t app_status, uint8_t boot_version);
+bool can_message_handler_drain(uint8_t ecu_id, uint32_t budget_cycles);
+bool can_message_handler_manifest_scan(uint8_t ecu_id, uint32_t budget_cycles);
+void can_message_handler_heartbeat(uint8_t ecu_id, uint8_t app_status, uint8_t boot_version);
+void can_message_handler_rx_irq(void);
+uint32_t can_message_handler_get_max_rx_latency_us(void);
 int can_message_handler_send_bootloader_message(data_comm_msg_type_t type, uint8_t id, const uint8_t* header, uint16_t header_size, const uint8_t* data, uint16_t data_size, void *context);
 
 #endif // CAN_MESSAGE_PROCESSOR_H
@@ -0,0 +1,80 @@
+/**
+ * @file btea_fast.c
+ * @brief XXTEA (BTEA) decryption kernel tuned for the Cortex-M33
+ * @date 19/10/2026
+ */
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "btea_fast.h"
+
+/* The project is built for size, this kernel is worth the extra bytes */
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize ("O2")
+#endif
+
+/* Private defines ------------------------------------------------------------------*/
+#define BTEA_DELTA                          0x9E3779B9UL
+
+/* Private Functions ----------------------------------------------------------------*/
+static inline uint32_t btea_mx(uint32_t y, uint32_t z, uint32_t sum, uint32_t k)
+{
+	return (((z >> 5) ^ (y << 2)) + ((y >> 3) ^ (z << 4))) ^ ((sum ^ y) + (k ^ z));
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @brief Decrypt n words in place.
+ * @param n Number of words, at least 2 (shorter buffers are left untouched like btea())
+ */
+BTEA_FAST_SECTION void btea_fast_decrypt(uint32_t *v, uint32_t n, const uint32_t key[4])
+{
+	if (n < 2U) {
+		return;
+	}
+
+	uint32_t rounds = 6U + (52U / n);
+	uint32_t sum = rounds * BTEA_DELTA;
+	uint32_t y = v[0];
+	uint32_t z;
+
+	do {
+		uint32_t e = (sum >> 2) & 3U;
+		uint32_t k0 = key[e];
+		uint32_t k1 = key[e ^ 1U];
+		uint32_t k2 = key[e ^ 2U];
+		uint32_t k3 = key[e ^ 3U];
+		uint32_t *w = &v[n - 1U];
+
+		/* Words n-1 down to 1, four per iteration; the key index is (p & 3) ^ e */
+		switch ((n - 1U) & 3U) {
+			for (;;) {
+		case 3:
+				z = w[-1];
+				y = (*w -= btea_mx(y, z, sum, k3));
+				w--;
+				/* fall through */
+		case 2:
+				z = w[-1];
+				y = (*w -= btea_mx(y, z, sum, k2));
+				w--;
+				/* fall through */
+		case 1:
+				z = w[-1];
+				y = (*w -= btea_mx(y, z, sum, k1));
+				w--;
+				/* fall through */
+		case 0:
+				if (w == v) {
+					break;
+				}
+				z = w[-1];
+				y = (*w -= btea_mx(y, z, sum, k0));
+				w--;
+			}
+		}
+
+		z = v[n - 1U];
+		y = (v[0] -= btea_mx(y, z, sum, k0));
+		sum -= BTEA_DELTA;
+	} while (--rounds != 0U);
+}
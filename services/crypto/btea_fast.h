@@ -0,0 +1,31 @@
+/**
+ * @file btea_fast.h
+ * @brief XXTEA (BTEA) decryption kernel tuned for the Cortex-M33
+ * @details Produces the same output as btea(v, -n, key) from fw-utils. The inner
+ *          loop is unrolled by four so the key schedule of a round stays in
+ *          registers, and the buffer is decrypted in place. The kernel runs from
+ *          RAM unless BTEA_FAST_IN_RAM is defined to 0.
+ *
+ *          On target, btea() is redirected here for decryption by linking with
+ *          -Wl,--wrap=btea (see btea_wrap.c).
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* General defines ------------------------------------------------------------------*/
+#ifndef BTEA_FAST_IN_RAM
+#define BTEA_FAST_IN_RAM                    1
+#endif
+
+#if BTEA_FAST_IN_RAM && defined(__arm__)
+#define BTEA_FAST_SECTION                   __attribute__((section(".RamFunc")))
+#else
+#define BTEA_FAST_SECTION
+#endif
+
+/* Public Functions ------------------------------------------------------------------*/
+void btea_fast_decrypt(uint32_t *v, uint32_t n, const uint32_t key[4]);
@@ -0,0 +1,35 @@
+/**
+ * @file btea_wrap.c
+ * @brief Routes btea() decryption to the optimized kernel
+ * @details Linked with -Wl,--wrap=btea: calls to btea() from the bootloader core
+ *          land here, decryption goes to btea_fast_decrypt() and encryption to the
+ *          generic implementation (__real_btea).
+ * @date 19/10/2026
+ */
+
+#if defined(__arm__)
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "btea.h"
+#include "btea_fast.h"
+#include "update_report.h"
+#include "profile_zone.h"
+
+/* Public Functions -----------------------------------------------------------------*/
+void __real_btea(uint32_t *v, int n, uint32_t const key[4]);
+void __wrap_btea(uint32_t *v, int n, uint32_t const key[4]);
+
+void __wrap_btea(uint32_t *v, int n, uint32_t const key[4])
+{
+	if (n < -1) {
+		update_report_stage_begin(UPDATE_REPORT_STAGE_DECRYPT);
+		PROFILE_ZONE_BEGIN(PROFILE_ZONE_DECRYPT);
+		btea_fast_decrypt(v, (uint32_t)(-n), key);
+		PROFILE_ZONE_END(PROFILE_ZONE_DECRYPT);
+		update_report_stage_end();
+	} else {
+		__real_btea(v, n, key);
+	}
+}
+
+#endif
@@ -0,0 +1,57 @@
+/**
+ * @file ecdsa_backend.c
+ * @brief Routes uECC_verify() to the selected ECDSA backend
+ * @date 19/10/2026
+ */
+
+#if defined(__arm__)
+
+/* Private Includes ------------------------------------------------------------------*/
+#include <tinycrypt/constants.h>
+#include <tinycrypt/ecc_dsa.h>
+#include "ecdsa_backend.h"
+#include "p256_verify.h"
+#include "update_report.h"
+#include "boot_handoff.h"
+#include "profile_zone.h"
+
+/* Public Functions -----------------------------------------------------------------*/
+int __real_uECC_verify(const uint8_t *public_key, const uint8_t *message_hash, unsigned hash_size,
+		const uint8_t *signature, uECC_Curve curve);
+int __wrap_uECC_verify(const uint8_t *public_key, const uint8_t *message_hash, unsigned hash_size,
+		const uint8_t *signature, uECC_Curve curve);
+
+static int ecdsa_backend_verify(const uint8_t *public_key, const uint8_t *message_hash, unsigned hash_size,
+		const uint8_t *signature, uECC_Curve curve)
+{
+#if ECDSA_BACKEND == ECDSA_BACKEND_P256_FIXED
+	if (hash_size == 32U && curve == uECC_secp256r1()) {
+		int result = p256_verify_fixed(public_key, message_hash, signature);
+
+		if (result != P256_VERIFY_UNKNOWN_KEY) {
+			return (result == P256_VERIFY_OK) ? TC_CRYPTO_SUCCESS : TC_CRYPTO_FAIL;
+		}
+	}
+#endif
+
+	return __real_uECC_verify(public_key, message_hash, hash_size, signature, curve);
+}
+
+int __wrap_uECC_verify(const uint8_t *public_key, const uint8_t *message_hash, unsigned hash_size,
+		const uint8_t *signature, uECC_Curve curve)
+{
+	update_report_stage_begin(UPDATE_REPORT_STAGE_VERIFY);
+	PROFILE_ZONE_BEGIN(PROFILE_ZONE_ECDSA_VERIFY);
+	int result = ecdsa_backend_verify(public_key, message_hash, hash_size, signature, curve);
+	PROFILE_ZONE_END(PROFILE_ZONE_ECDSA_VERIFY);
+	update_report_stage_end();
+
+	/* Only acts once this boot started an update: the image was refused */
+	if (result != TC_CRYPTO_SUCCESS) {
+		boot_handoff_update_failed();
+	}
+
+	return result;
+}
+
+#endif
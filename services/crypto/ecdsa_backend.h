@@ -0,0 +1,21 @@
+/**
+ * @file ecdsa_backend.h
+ * @brief Selection of the ECDSA P-256 verification backend
+ * @details ECDSA_BACKEND_TINYCRYPT:  uECC_verify() from tinycrypt, for any key.
+ *          ECDSA_BACKEND_P256_FIXED: p256_verify_fixed() for the keys tables were
+ *                                    generated for, tinycrypt for any other key.
+ *
+ *          The project links with -Wl,--wrap=uECC_verify so the bootloader core and
+ *          the manifest check go through ecdsa_backend.c whatever the backend.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* General defines ------------------------------------------------------------------*/
+#define ECDSA_BACKEND_TINYCRYPT             0
+#define ECDSA_BACKEND_P256_FIXED            1
+
+#ifndef ECDSA_BACKEND
+#define ECDSA_BACKEND                       ECDSA_BACKEND_P256_FIXED
+#endif
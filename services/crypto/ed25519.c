@@ -0,0 +1,465 @@
+/**
+ * @file ed25519.c
+ * @brief Ed25519 signature verification (RFC 8032)
+ * @details Field elements are 8 little endian 32-bit words modulo p = 2^255 - 19,
+ *          kept below 2^256 and only made canonical when compared or encoded
+ *          (2^256 = 38 mod p). Points use extended coordinates (X, Y, Z, T).
+ * @date 19/10/2026
+ */
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <string.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "ed25519.h"
+#include "ed25519_tables.h"
+#include "sha512.h"
+#include "umaal.h"
+
+/* The project is built for size, this kernel is worth the extra bytes */
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize ("O2")
+#endif
+
+/* Private types --------------------------------------------------------------------*/
+typedef uint32_t fe_t[ED25519_WORDS];
+
+typedef struct {
+	fe_t x;
+	fe_t y;
+	fe_t z;
+	fe_t t;
+} ed25519_point_t;
+
+/* Static Variables -----------------------------------------------------------------*/
+static const fe_t fe_p = { 0xFFFFFFED, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x7FFFFFFF };
+static const fe_t fe_d = { 0x135978A3, 0x75EB4DCA, 0x4141D8AB, 0x00700A4D, 0x7779E898, 0x8CC74079, 0x2B6FFE73, 0x52036CEE };
+static const fe_t fe_2d = { 0x26B2F159, 0xEBD69B94, 0x8283B156, 0x00E0149A, 0xEEF3D130, 0x198E80F2, 0x56DFFCE7, 0x2406D9DC };
+static const fe_t fe_sqrt_m1 = { 0x4A0EA0B0, 0xC4EE1B27, 0xAD2FE478, 0x2F431806, 0x3DFBD7A7, 0x2B4D0099, 0x4FC1DF0B, 0x2B832480 };
+static const fe_t fe_one = { 1 };
+static const fe_t fe_zero = { 0 };
+
+/* Exponents: p - 2 (inversion) and (p - 5) / 8 (square root) */
+static const fe_t fe_p_minus_2 = { 0xFFFFFFEB, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x7FFFFFFF };
+static const fe_t fe_p_minus_5_div_8 = { 0xFFFFFFFD, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x0FFFFFFF };
+
+/* Group order L, little endian bytes */
+static const uint8_t ed25519_l[32] = {
+	0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58, 0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10,
+};
+
+/* Comb of -A, rebuilt for every verification */
+static ed25519_cached_t ed25519_key_table[ED25519_COMB_TABLE_SIZE];
+
+/* Private Functions ----------------------------------------------------------------*/
+/* r += carry * 2^256, folded as carry * 38 until nothing is left above 2^256 */
+static void fe_fold(fe_t r, uint32_t carry)
+{
+	while (carry != 0) {
+		uint64_t sum = (uint64_t)carry * 38U;
+
+		for (uint32_t i = 0; i < ED25519_WORDS; i++) {
+			sum += r[i];
+			r[i] = (uint32_t)sum;
+			sum >>= 32;
+		}
+		carry = (uint32_t)sum;
+	}
+}
+
+static void fe_add(fe_t r, const fe_t a, const fe_t b)
+{
+	uint64_t sum = 0;
+
+	for (uint32_t i = 0; i < ED25519_WORDS; i++) {
+		sum += (uint64_t)a[i] + b[i];
+		r[i] = (uint32_t)sum;
+		sum >>= 32;
+	}
+
+	fe_fold(r, (uint32_t)sum);
+}
+
+static void fe_sub(fe_t r, const fe_t a, const fe_t b)
+{
+	int64_t borrow = 0;
+
+	for (uint32_t i = 0; i < ED25519_WORDS; i++) {
+		borrow += (int64_t)a[i] - b[i];
+		r[i] = (uint32_t)borrow;
+		borrow >>= 32;
+	}
+
+	/* Wrapped by 2^256: take 38 back until no borrow is left */
+	while (borrow != 0) {
+		borrow = -38;
+		for (uint32_t i = 0; i < ED25519_WORDS; i++) {
+			borrow += r[i];
+			r[i] = (uint32_t)borrow;
+			borrow >>= 32;
+		}
+	}
+}
+
+static void fe_mul(fe_t r, const fe_t a, const fe_t b)
+{
+	uint32_t t[2U * ED25519_WORDS] = { 0 };
+	uint64_t sum = 0;
+
+	for (uint32_t i = 0; i < ED25519_WORDS; i++) {
+		uint32_t carry = 0;
+
+		for (uint32_t j = 0; j < ED25519_WORDS; j++) {
+			umaal(&t[i + j], &carry, a[j], b[i]);
+		}
+		t[i + ED25519_WORDS] = carry;
+	}
+
+	for (uint32_t i = 0; i < ED25519_WORDS; i++) {
+		sum += (uint64_t)t[i] + ((uint64_t)t[i + ED25519_WORDS] * 38U);
+		r[i] = (uint32_t)sum;
+		sum >>= 32;
+	}
+
+	fe_fold(r, (uint32_t)sum);
+}
+
+static inline void fe_sqr(fe_t r, const fe_t a)
+{
+	fe_mul(r, a, a);
+}
+
+/* Reduce into [0, p): below 2^256 is below 2p + 38, so two subtractions at most */
+static void fe_canonical(fe_t r, const fe_t a)
+{
+	memcpy(r, a, sizeof(fe_t));
+
+	for (uint32_t pass = 0; pass < 2U; pass++) {
+		fe_t t;
+		int64_t borrow = 0;
+
+		for (uint32_t i = 0; i < ED25519_WORDS; i++) {
+			borrow += (int64_t)r[i] - fe_p[i];
+			t[i] = (uint32_t)borrow;
+			borrow >>= 32;
+		}
+
+		if (borrow == 0) {
+			memcpy(r, t, sizeof(fe_t));
+		}
+	}
+}
+
+static bool fe_equal(const fe_t a, const fe_t b)
+{
+	fe_t ca, cb;
+
+	fe_canonical(ca, a);
+	fe_canonical(cb, b);
+
+	return memcmp(ca, cb, sizeof(fe_t)) == 0;
+}
+
+static void fe_pow(fe_t r, const fe_t a, const fe_t exponent)
+{
+	fe_t result;
+
+	memcpy(result, fe_one, sizeof(fe_t));
+
+	for (int bit = 255; bit >= 0; bit--) {
+		fe_sqr(result, result);
+		if ((exponent[bit >> 5] >> (bit & 31)) & 1U) {
+			fe_mul(result, result, a);
+		}
+	}
+
+	memcpy(r, result, sizeof(fe_t));
+}
+
+static void fe_from_bytes(fe_t r, const uint8_t bytes[32])
+{
+	for (uint32_t i = 0; i < ED25519_WORDS; i++) {
+		const uint8_t *b = &bytes[4U * i];
+		r[i] = (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+	}
+}
+
+static void fe_to_bytes(uint8_t bytes[32], const fe_t a)
+{
+	fe_t c;
+
+	fe_canonical(c, a);
+	for (uint32_t i = 0; i < ED25519_WORDS; i++) {
+		bytes[4U * i] = (uint8_t)c[i];
+		bytes[(4U * i) + 1U] = (uint8_t)(c[i] >> 8);
+		bytes[(4U * i) + 2U] = (uint8_t)(c[i] >> 16);
+		bytes[(4U * i) + 3U] = (uint8_t)(c[i] >> 24);
+	}
+}
+
+static void ed25519_identity(ed25519_point_t *p)
+{
+	memcpy(p->x, fe_zero, sizeof(fe_t));
+	memcpy(p->y, fe_one, sizeof(fe_t));
+	memcpy(p->z, fe_one, sizeof(fe_t));
+	memcpy(p->t, fe_zero, sizeof(fe_t));
+}
+
+static void ed25519_to_cached(ed25519_cached_t *r, const ed25519_point_t *p)
+{
+	fe_add(r->y_plus_x, p->y, p->x);
+	fe_sub(r->y_minus_x, p->y, p->x);
+	memcpy(r->z, p->z, sizeof(fe_t));
+	fe_mul(r->t2d, p->t, fe_2d);
+}
+
+/* add-2008-hwcd-3, a = -1 */
+static void ed25519_point_add(ed25519_point_t *p, const ed25519_cached_t *q)
+{
+	fe_t a, b, c, d, e, f, g, h;
+
+	fe_sub(a, p->y, p->x);
+	fe_mul(a, a, q->y_minus_x);
+	fe_add(b, p->y, p->x);
+	fe_mul(b, b, q->y_plus_x);
+	fe_mul(c, p->t, q->t2d);
+	fe_mul(d, p->z, q->z);
+	fe_add(d, d, d);
+
+	fe_sub(e, b, a);
+	fe_sub(f, d, c);
+	fe_add(g, d, c);
+	fe_add(h, b, a);
+
+	fe_mul(p->x, e, f);
+	fe_mul(p->y, g, h);
+	fe_mul(p->t, e, h);
+	fe_mul(p->z, f, g);
+}
+
+/* dbl-2008-hwcd, a = -1 */
+static void ed25519_point_double(ed25519_point_t *p)
+{
+	fe_t xx, yy, e, f, g, h;
+
+	fe_sqr(xx, p->x);
+	fe_sqr(yy, p->y);
+	fe_sqr(f, p->z);
+	fe_add(f, f, f);
+
+	fe_add(e, p->x, p->y);
+	fe_sqr(e, e);
+	fe_add(h, yy, xx);
+	fe_sub(e, e, h);            /* 2XY */
+	fe_sub(g, yy, xx);
+	fe_sub(f, f, g);
+
+	fe_mul(p->x, e, f);
+	fe_mul(p->y, h, g);
+	fe_mul(p->t, e, h);
+	fe_mul(p->z, g, f);
+}
+
+/* Decode -A, rejecting non canonical encodings and points off the curve */
+static bool ed25519_decode_negated(ed25519_point_t *p, const uint8_t bytes[32])
+{
+	fe_t u, v, v3, x2, t;
+	uint32_t sign = bytes[31] >> 7;
+
+	fe_from_bytes(p->y, bytes);
+	p->y[ED25519_WORDS - 1U] &= 0x7FFFFFFFU;
+	fe_canonical(t, p->y);
+	if (memcmp(t, p->y, sizeof(fe_t)) != 0) {
+		return false;
+	}
+
+	/* x = u v^3 (u v^7)^((p - 5) / 8) with u = y^2 - 1, v = d y^2 + 1 */
+	fe_sqr(u, p->y);
+	fe_mul(v, u, fe_d);
+	fe_sub(u, u, fe_one);
+	fe_add(v, v, fe_one);
+
+	fe_sqr(v3, v);
+	fe_mul(v3, v3, v);
+	fe_sqr(p->x, v3);
+	fe_mul(p->x, p->x, v);
+	fe_mul(p->x, p->x, u);
+	fe_pow(p->x, p->x, fe_p_minus_5_div_8);
+	fe_mul(p->x, p->x, v3);
+	fe_mul(p->x, p->x, u);
+
+	fe_sqr(x2, p->x);
+	fe_mul(x2, x2, v);
+	if (!fe_equal(x2, u)) {
+		fe_sub(t, fe_zero, u);
+		if (!fe_equal(x2, t)) {
+			return false;
+		}
+		fe_mul(p->x, p->x, fe_sqrt_m1);
+	}
+
+	fe_canonical(p->x, p->x);
+	if ((p->x[0] & 1U) == sign) {
+		/* Negated: -A has the opposite sign of A */
+		if (fe_equal(p->x, fe_zero)) {
+			return sign == 0U;
+		}
+		fe_sub(p->x, fe_zero, p->x);
+	}
+
+	memcpy(p->z, fe_one, sizeof(fe_t));
+	fe_mul(p->t, p->x, p->y);
+
+	return true;
+}
+
+static void ed25519_build_key_table(const ed25519_point_t *negated_key)
+{
+	ed25519_point_t bases[ED25519_COMB_TEETH];
+	ed25519_point_t sum;
+
+	bases[0] = *negated_key;
+	for (uint32_t tooth = 1; tooth < ED25519_COMB_TEETH; tooth++) {
+		bases[tooth] = bases[tooth - 1U];
+		for (uint32_t i = 0; i < ED25519_COMB_SPACING; i++) {
+			ed25519_point_double(&bases[tooth]);
+		}
+	}
+
+	for (uint32_t index = 1; index <= ED25519_COMB_TABLE_SIZE; index++) {
+		ed25519_identity(&sum);
+		for (uint32_t tooth = 0; tooth < ED25519_COMB_TEETH; tooth++) {
+			if (index & (1U << tooth)) {
+				ed25519_cached_t base;
+				ed25519_to_cached(&base, &bases[tooth]);
+				ed25519_point_add(&sum, &base);
+			}
+		}
+		ed25519_to_cached(&ed25519_key_table[index - 1U], &sum);
+	}
+}
+
+static uint32_t ed25519_comb_index(const uint8_t k[32], uint32_t column)
+{
+	uint32_t index = 0;
+
+	for (uint32_t tooth = 0; tooth < ED25519_COMB_TEETH; tooth++) {
+		uint32_t bit = column + (tooth * ED25519_COMB_SPACING);
+		index |= ((uint32_t)(k[bit >> 3] >> (bit & 7U)) & 1U) << tooth;
+	}
+
+	return index;
+}
+
+/* r = x mod L, x being 64 little endian bytes (TweetNaCl modL) */
+static void ed25519_reduce_scalar(uint8_t r[32], int64_t x[64])
+{
+	int64_t carry;
+	int32_t i, j;
+
+	for (i = 63; i >= 32; --i) {
+		carry = 0;
+		for (j = i - 32; j < i - 12; ++j) {
+			x[j] += carry - (16 * x[i] * ed25519_l[j - (i - 32)]);
+			carry = (x[j] + 128) >> 8;
+			x[j] -= carry * 256;
+		}
+		x[j] += carry;
+		x[i] = 0;
+	}
+
+	carry = 0;
+	for (j = 0; j < 32; ++j) {
+		x[j] += carry - ((x[31] >> 4) * ed25519_l[j]);
+		carry = x[j] >> 8;
+		x[j] &= 255;
+	}
+
+	for (j = 0; j < 32; ++j) {
+		x[j] -= carry * ed25519_l[j];
+	}
+
+	for (i = 0; i < 32; ++i) {
+		x[i + 1] += x[i] >> 8;
+		r[i] = (uint8_t)(x[i] & 255);
+	}
+}
+
+static bool ed25519_scalar_is_reduced(const uint8_t s[32])
+{
+	for (int i = 31; i >= 0; i--) {
+		if (s[i] != ed25519_l[i]) {
+			return s[i] < ed25519_l[i];
+		}
+	}
+
+	return false;
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @brief Verify an Ed25519 signature.
+ * @param signature R | S
+ * @return ED25519_VERIFY_OK, ED25519_VERIFY_BAD_SIGNATURE or ED25519_VERIFY_BAD_KEY
+ */
+int ed25519_verify(const ed25519_public_key_t *public_key, const uint8_t *message, uint32_t message_size,
+		const uint8_t signature[ED25519_SIGNATURE_SIZE])
+{
+	const uint8_t *s = &signature[32];
+	uint8_t digest[SHA512_DIGEST_SIZE];
+	uint8_t k[32];
+	uint8_t check[32];
+	int64_t wide[64];
+	ed25519_point_t point;
+	sha512_ctx_t sha;
+	fe_t z_inverse, x, y;
+
+	if (!ed25519_scalar_is_reduced(s)) {
+		return ED25519_VERIFY_BAD_SIGNATURE;
+	}
+
+	if (!ed25519_decode_negated(&point, public_key->key)) {
+		return ED25519_VERIFY_BAD_KEY;
+	}
+
+	/* k = SHA-512(R | A | M) mod L */
+	sha512_init(&sha);
+	sha512_update(&sha, signature, 32U);
+	sha512_update(&sha, public_key->key, ED25519_PUBLIC_KEY_SIZE);
+	sha512_update(&sha, message, message_size);
+	sha512_final(&sha, digest);
+
+	for (uint32_t i = 0; i < 64U; i++) {
+		wide[i] = digest[i];
+	}
+	ed25519_reduce_scalar(k, wide);
+
+	/* [S]B + [k](-A), both combs sharing the doublings */
+	ed25519_build_key_table(&point);
+	ed25519_identity(&point);
+
+	for (int column = (int)ED25519_COMB_SPACING - 1; column >= 0; column--) {
+		ed25519_point_double(&point);
+
+		uint32_t index = ed25519_comb_index(s, (uint32_t)column);
+		if (index != 0) {
+			ed25519_point_add(&point, &ed25519_base_table[index - 1U]);
+		}
+
+		index = ed25519_comb_index(k, (uint32_t)column);
+		if (index != 0) {
+			ed25519_point_add(&point, &ed25519_key_table[index - 1U]);
+		}
+	}
+
+	fe_pow(z_inverse, point.z, fe_p_minus_2);
+	fe_mul(x, point.x, z_inverse);
+	fe_mul(y, point.y, z_inverse);
+	fe_to_bytes(check, y);
+	fe_canonical(x, x);
+	check[31] |= (uint8_t)((x[0] & 1U) << 7);
+
+	return (memcmp(check, signature, sizeof(check)) == 0) ? ED25519_VERIFY_OK : ED25519_VERIFY_BAD_SIGNATURE;
+}
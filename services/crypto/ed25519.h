@@ -0,0 +1,32 @@
+/**
+ * @file ed25519.h
+ * @brief Ed25519 signature verification (RFC 8032)
+ * @details Checks [S]B - [k]A == R with k = SHA-512(R | A | M) mod L, by comparing
+ *          encodings (cofactorless, as ref10). [S]B uses a precomputed comb
+ *          table and the comb of -A is built at run time, so both share their 64
+ *          doublings. Verification handles public data only and is not constant
+ *          time.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* General defines ------------------------------------------------------------------*/
+#define ED25519_PUBLIC_KEY_SIZE             32U
+#define ED25519_SIGNATURE_SIZE              64U
+
+#define ED25519_VERIFY_OK                   0
+#define ED25519_VERIFY_BAD_SIGNATURE        -1
+#define ED25519_VERIFY_BAD_KEY              -2
+
+/* Types ------------------------------------------------------------------*/
+typedef struct {
+    uint8_t key[ED25519_PUBLIC_KEY_SIZE];   /* Encoded point A */
+} ed25519_public_key_t;
+
+/* Public Functions ------------------------------------------------------------------*/
+int ed25519_verify(const ed25519_public_key_t *public_key, const uint8_t *message, uint32_t message_size,
+        const uint8_t signature[ED25519_SIGNATURE_SIZE]);
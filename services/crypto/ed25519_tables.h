@@ -0,0 +1,31 @@
+/**
+ * @file ed25519_tables.h
+ * @brief Precomputed comb table of the Ed25519 base point
+ * @details Same comb layout as the P-256 tables (see p256_tables.h): entry i - 1
+ *          holds the sum of 2^(ED25519_COMB_SPACING * j) * B over the bits j set
+ *          in i. Generated by tools/ed25519_tables/gen_ed25519_tables.py.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* General defines ------------------------------------------------------------------*/
+#define ED25519_WORDS                       8U
+#define ED25519_COMB_TEETH                  4U
+#define ED25519_COMB_SPACING                (256U / ED25519_COMB_TEETH)
+#define ED25519_COMB_TABLE_SIZE             ((1U << ED25519_COMB_TEETH) - 1U)
+
+/* Types ------------------------------------------------------------------*/
+/* Point ready to be added: (Y + X, Y - X, Z, 2d * T), little endian words */
+typedef struct {
+    uint32_t y_plus_x[ED25519_WORDS];
+    uint32_t y_minus_x[ED25519_WORDS];
+    uint32_t z[ED25519_WORDS];
+    uint32_t t2d[ED25519_WORDS];
+} ed25519_cached_t;
+
+/* Public Variables ------------------------------------------------------------------*/
+extern const ed25519_cached_t ed25519_base_table[ED25519_COMB_TABLE_SIZE];
@@ -0,0 +1,171 @@
+/**
+ * @file p256_tables.c
+ * @brief Comb tables for P-256 verification with fixed keys
+ * @details Generated by tools/p256_tables/gen_p256_tables.py from the public keys
+ *          in main.c, do not edit. Points are affine, in the Montgomery domain.
+ */
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "p256_tables.h"
+
+/* Public Variables -----------------------------------------------------------------*/
+const p256_affine_t p256_base_table[P256_COMB_TABLE_SIZE] = {
+    { { 0x18A9143C, 0x79E730D4, 0x5FEDB601, 0x75BA95FC, 0x77622510, 0x79FB732B, 0xA53755C6, 0x18905F76 },
+      { 0xCE95560A, 0xDDF25357, 0xBA19E45C, 0x8B4AB8E4, 0xDD21F325, 0xD2E88688, 0x25885D85, 0x8571FF18 } },
+    { { 0x16A0D2BB, 0x4F922FC5, 0x1A623499, 0x0D5CC16C, 0x57C62C8B, 0x9241CF3A, 0xFD1B667F, 0x2F5E6961 },
+      { 0xF5A01797, 0x5C15C70B, 0x60956192, 0x3D20B44D, 0x071FDB52, 0x04911B37, 0x8D6F0F7B, 0xF648F916 } },
+    { { 0xE137BBBC, 0x9E566847, 0x8A6A0BEC, 0xE434469E, 0x79D73463, 0xB1C42761, 0x133D0015, 0x5ABE0285 },
+      { 0xC04C7DAB, 0x92AA837C, 0x43260C07, 0x573D9F4C, 0x78E6CC37, 0x0C931562, 0x6B6F7383, 0x94BB725B } },
+    { { 0xBFE20925, 0x62A8C244, 0x8FDCE867, 0x91C19AC3, 0xDD387063, 0x5A96A5D5, 0x21D324F6, 0x61D587D4 },
+      { 0xA37173EA, 0xE87673A2, 0x53778B65, 0x23848008, 0x05BAB43E, 0x10F8441E, 0x4621EFBE, 0xFA11FE12 } },
+    { { 0x2CB19FFD, 0x1C891F2B, 0xB1923C23, 0x01BA8D5B, 0x8AC5CA8E, 0xB6D03D67, 0x1F13BEDC, 0x586EB04C },
+      { 0x27E8ED09, 0x0C35C6E5, 0x1819EDE2, 0x1E81A33C, 0x56C652FA, 0x278FD6C0, 0x70864F11, 0x19D5AC08 } },
+    { { 0xD2B533D5, 0x62577734, 0xA1BDDDC0, 0x673B8AF6, 0xA79EC293, 0x577E7C9A, 0xC3B266B1, 0xBB6DE651 },
+      { 0xB65259B3, 0xE7E9303A, 0xD03A7480, 0xD6A0AFD3, 0x9B3CFC27, 0xC5AC83D1, 0x5D18B99B, 0x60B4619A } },
+    { { 0x1AE5AA1C, 0xBD6A38E1, 0x49E73658, 0xB8B7652B, 0xEE5F87ED, 0x0B130014, 0xAEEBFFCD, 0x9D0F27B2 },
+      { 0x7A730A55, 0xCA924631, 0xDDBBC83A, 0x9C955B2F, 0xAC019A71, 0x07C1DFE0, 0x356EC48D, 0x244A566D } },
+    { { 0xF4F8B16A, 0x56F8410E, 0xC47B266A, 0x97241AFE, 0x6D9C87C1, 0x0A406B8E, 0xCD42AB1B, 0x803F3E02 },
+      { 0x04DBEC69, 0x7F0309A8, 0x3BBAD05F, 0xA83B85F7, 0xAD8E197F, 0xC6097273, 0x5067ADC1, 0xC097440E } },
+    { { 0xC379AB34, 0x846A56F2, 0x841DF8D1, 0xA8EE068B, 0x176C68EF, 0x20314459, 0x915F1F30, 0xF1AF32D5 },
+      { 0x5D75BD50, 0x99C37531, 0xF72F67BC, 0x837CFFBA, 0x48D7723F, 0x0613A418, 0xE2D41C8B, 0x23D0F130 } },
+    { { 0xD5BE5A2B, 0xED93E225, 0x5934F3C6, 0x6FE79983, 0x22626FFC, 0x43140926, 0x7990216A, 0x50BBB4D9 },
+      { 0xE57EC63E, 0x378191C6, 0x181DCDB2, 0x65422C40, 0x0236E0F6, 0x41A8099B, 0x01FE49C3, 0x2B100118 } },
+    { { 0x9B391593, 0xFC68B5C5, 0x598270FC, 0xC385F5A2, 0xD19ADCBB, 0x7144F3AA, 0x83FBAE0C, 0xDD558999 },
+      { 0x74B82FF4, 0x93B88B8E, 0x71E734C9, 0xD2E03C40, 0x43C0322A, 0x9A7A9EAF, 0x149D6041, 0xE6E4C551 } },
+    { { 0x80EC21FE, 0x5FE14BFE, 0xC255BE82, 0xF6CE116A, 0x2F4A5D67, 0x98BC5A07, 0xDB7E63AF, 0xFAD27148 },
+      { 0x29AB05B3, 0x90C0B6AC, 0x4E251AE6, 0x37A9A83C, 0xC2AADE7D, 0x0A7DC875, 0x9F0E1A84, 0x77387DE3 } },
+    { { 0xA56C0DD7, 0x1E9ECC49, 0x46086C74, 0xA5CFFCD8, 0xF505AECE, 0x8F7A1408, 0xBEF0C47E, 0xB37B85C0 },
+      { 0xCC0E6A8F, 0x3596B6E4, 0x6B388F23, 0xFD6D4BBF, 0xC39CEF4E, 0xABA453FA, 0xF9F628D5, 0x9C135AC8 } },
+    { { 0x95C8F8BE, 0x0A1C7294, 0x3BF362BF, 0x2961C480, 0xDF63D4AC, 0x9E418403, 0x91ECE900, 0xC109F9CB },
+      { 0x58945705, 0xC2D095D0, 0xDDEB85C0, 0xB9083D96, 0x7A40449B, 0x84692B8D, 0x2EEE1EE1, 0x9BC3344F } },
+    { { 0x42913074, 0x0D5AE356, 0x48A542B1, 0x55491B27, 0xB310732A, 0x469CA665, 0x5F1A4CC1, 0x29591D52 },
+      { 0xB84F983F, 0xE76F5B6B, 0x9F5F84E1, 0xBE7EEF41, 0x80BAA189, 0x1200D496, 0x18EF332C, 0x6376551F } },
+};
+
+const p256_fixed_key_t p256_fixed_keys[] = {
+    {
+        .public_key = {
+            0xc4, 0x05, 0xad, 0xcf, 0xbe, 0x78, 0x79, 0x58, 0x6a, 0xbe, 0x6f, 0x5a, 0x20, 0x27, 0x3f, 0xc9,
+            0x4e, 0xf0, 0x7c, 0xc5, 0x7b, 0xbe, 0xcc, 0x43, 0xe9, 0xa0, 0xc3, 0x77, 0x70, 0x0d, 0x69, 0x29,
+            0xb6, 0x9d, 0xae, 0xf1, 0x62, 0x3b, 0x5e, 0x90, 0x32, 0x9b, 0x2b, 0x82, 0x71, 0xd4, 0x55, 0x4e,
+            0x19, 0x2d, 0xfe, 0x31, 0x0c, 0x1d, 0x7d, 0x11, 0x80, 0xf6, 0x0e, 0x25, 0xaa, 0x2e, 0x82, 0xc7,
+        },
+        .table = {
+            { { 0xC15F8761, 0x57FBB96F, 0xDD72B286, 0x2B3A0E04, 0x6EE447E3, 0x4BC4362B, 0xD4850A61, 0x66897A6E },
+              { 0x0B4BB35D, 0xCFCAFCE5, 0xD9D7423D, 0x66DD929F, 0x1E06D4F9, 0xBAFF47D4, 0x9B641427, 0x044C938B } },
+            { { 0x6315E36F, 0x16E0A042, 0x1EF37A60, 0x290C4020, 0xF3B04226, 0x379D559A, 0x1CCC49CE, 0xF23FD53D },
+              { 0xE52689FD, 0x5557DC2B, 0x603929B4, 0xE9F47D09, 0xFBE18694, 0x6803C596, 0x0E5F2094, 0xC1D6F3E5 } },
+            { { 0xAA4B7082, 0x8603A42C, 0xA2D68676, 0xCA3F7DE4, 0xA4001D90, 0x887DB312, 0xADA92663, 0x5273A40F },
+              { 0x8B0F4D14, 0x3B179E55, 0x0EFC4513, 0xBCF00CE6, 0x67C9524B, 0x47265523, 0xB60BA522, 0xAC5A65F3 } },
+            { { 0xB2842AAE, 0xB6602AFF, 0xEA9EED1E, 0x8D3B39A2, 0xED987E0D, 0xB19D7A32, 0x8BD7EA8C, 0x45C30FA0 },
+              { 0x6FB574A6, 0xE895702B, 0xB401E94B, 0x22DCCC16, 0x34305715, 0x008C3B54, 0xCE260009, 0x651DD357 } },
+            { { 0x53DDB44B, 0xC3EB810B, 0x84414CDB, 0xFD576AD5, 0x6C2D4634, 0x4F6171F7, 0x671238E7, 0x1C673A79 },
+              { 0xC05CD756, 0xCFA1777A, 0x64A2EA12, 0x5A0D19FE, 0xB77E97A8, 0x0D535E47, 0x6128BA0C, 0x9A1B705E } },
+            { { 0xD39A8CF7, 0x6EF6774D, 0x88D9A8A6, 0xCEC5E01B, 0xEB3C1284, 0x980A4DA6, 0xA571306B, 0x661146E3 },
+              { 0x3DCE3AE3, 0x7DF92F33, 0x975EABFE, 0x32C645DC, 0xB067422B, 0xD66A499E, 0x0CCA9B57, 0xC65A0F05 } },
+            { { 0xC2F42B85, 0x90B7BC8E, 0x49EF36F2, 0x1B6EB0A5, 0x904AB7AC, 0x84586F01, 0x273779B9, 0xE681859E },
+              { 0x1D458B46, 0xEE366B3F, 0x29486B71, 0x74DB031B, 0x7A432D75, 0x7EF08B07, 0xFAC7324F, 0x7A721255 } },
+            { { 0x86914EBA, 0x473A148F, 0x7F2FF98F, 0xB7688187, 0x0E57B9DF, 0x37DF1883, 0x020DEBF9, 0x43C16884 },
+              { 0xE490B462, 0xCF57971E, 0xAB8D83D9, 0xE4BA0903, 0xFB982D3B, 0x4A0F8871, 0x4F9E2403, 0xE45056D9 } },
+            { { 0x6880CF8D, 0x731D45D6, 0x7F71E201, 0xDCD79282, 0xF630DF1E, 0x7920AFA5, 0xE2C265AC, 0x08D185E6 },
+              { 0x0480AE92, 0x341E5526, 0x2CD9E521, 0xE8EF23B7, 0x5989AE90, 0x7150ADBF, 0xC773E5A1, 0x8E523788 } },
+            { { 0x7006070B, 0x2F4EE912, 0xAFB9E72B, 0x774F793D, 0x98783595, 0xE318B386, 0x444425E3, 0x2F364F2C },
+              { 0x058B8FC9, 0x7FD3B623, 0x1F3FFCE3, 0x9BDEDBCC, 0xC5302B96, 0xC38EA8B1, 0xAB3571BE, 0x1E916511 } },
+            { { 0xD7BB8911, 0x1E1868EC, 0x48B42F59, 0xC1C782E3, 0xFF455E3B, 0x6183DC43, 0x577E97BC, 0x00315F6A },
+              { 0x521A9539, 0x3B619384, 0x1D488BBD, 0x9F79296A, 0x10EB19B8, 0x9C87A28B, 0xA1027EE6, 0xB735E244 } },
+            { { 0xAF4604F9, 0xA6E3BDED, 0x5A17E2CF, 0x005126EA, 0xFA32EFD0, 0xC17C8A45, 0x72B9EF3C, 0x3BD32613 },
+              { 0x3FBD477E, 0x26978DAF, 0xD12EE814, 0x6BBBA1AC, 0xE271C43E, 0x1EF20A32, 0x067B00CC, 0xEB236D92 } },
+            { { 0xE6577155, 0x54C22A77, 0x382295F3, 0x6B0842AC, 0xB3DBB9BC, 0x1A5B3D3B, 0xA3C56A59, 0x70C10B20 },
+              { 0x9AB0E09F, 0xDB94B45B, 0x270733FA, 0x50204E10, 0x71E404F7, 0x0746F26F, 0x3512CAB7, 0x82BA4840 } },
+            { { 0xE0716E23, 0xC2460C71, 0x946012F4, 0x170E996D, 0xFAC2EAAE, 0xD481F113, 0xF0954EA8, 0x8C374A4D },
+              { 0x3126C676, 0x3C6AE4D9, 0x3D8A1E92, 0x7C5BAFA2, 0x0C922370, 0xBF2318B9, 0xF5C794B3, 0xFDD626E5 } },
+            { { 0xC7FCCD8C, 0x324B8DC6, 0x96BC4FCF, 0x6F6FE3BA, 0x545AD289, 0x2DCF100F, 0x9AD80B44, 0x2C6ADE69 },
+              { 0xD8BC629E, 0x99B1FAB9, 0x3F074B1A, 0x073C02B9, 0xB26978E7, 0x32592427, 0x3DD32BC3, 0x7C09FC34 } },
+        },
+    },
+    {
+        .public_key = {
+            0x6e, 0xe7, 0x68, 0x2d, 0x5e, 0x20, 0xea, 0x16, 0x31, 0x21, 0x17, 0x32, 0x0b, 0x36, 0x70, 0x04,
+            0x95, 0x7b, 0x8e, 0xe0, 0x9d, 0x39, 0x02, 0x3c, 0x29, 0xef, 0xb9, 0x3e, 0x1e, 0x45, 0x9c, 0x34,
+            0x81, 0x4a, 0x20, 0x32, 0x2e, 0x03, 0xd1, 0x33, 0x32, 0xfd, 0xad, 0x32, 0xe8, 0xaa, 0x36, 0xb3,
+            0x02, 0xf6, 0x70, 0xa9, 0x46, 0x7d, 0x04, 0x91, 0x5f, 0x65, 0x9e, 0x4f, 0x25, 0xd6, 0x9d, 0x94,
+        },
+        .table = {
+            { { 0x18415545, 0xBDC8E200, 0x348B27A6, 0xBB68575C, 0x0FA73D08, 0x5AB6D9A1, 0xE11D505D, 0xFBEFBC69 },
+              { 0x389A1622, 0xDAECCD95, 0x6727D6A1, 0x03B89FD4, 0xBF70F61E, 0xF9D9A7C3, 0x3A61254C, 0x4499A50C } },
+            { { 0x7C1EB2EC, 0xAE3B221D, 0x7256E1AE, 0x4D79D257, 0xBDDD4847, 0x8AD88C42, 0x3F3CB236, 0x76C5362A },
+              { 0x68680A67, 0x6CB9952F, 0xE4B62F60, 0x7C5A5633, 0x771D5033, 0x1DDB1F03, 0xAC420E40, 0xD81A0338 } },
+            { { 0xB2D3B738, 0x6F27D091, 0x642C98A8, 0xEEE20FE2, 0xD6B37310, 0x412722C6, 0x2EA74E1F, 0xDA4D4187 },
+              { 0x089F30FE, 0x7B5C35AA, 0x9EAF0195, 0xB6959E54, 0x7BA0D681, 0xC89122A0, 0xCBC740B2, 0x277F20D3 } },
+            { { 0x0FA274CC, 0xF2546FD4, 0xAE577ADF, 0x7FD16AA9, 0x3303F21C, 0xB9568BEC, 0xE5EBADA2, 0xFA193EBF },
+              { 0xC741EE75, 0xCA0E9B18, 0xEDFB2185, 0xB4B85E9B, 0x0E1F09A2, 0x140A67F1, 0x3654D49A, 0x4622CEBC } },
+            { { 0x88452DDA, 0x91A68746, 0xA0270189, 0x0A2B8544, 0x93D9A320, 0x1D0472F3, 0xD047444E, 0x3F8FDC32 },
+              { 0x9DC6C03B, 0xBEB3F2E5, 0x30FE652A, 0xA3909D8B, 0xF31840E9, 0xA3834E4A, 0xDAEF92A3, 0x53ADA3E8 } },
+            { { 0xA3DC8360, 0xEE076BBD, 0xEC518D11, 0xBE189753, 0x16E963EB, 0x2E73A472, 0xA0645703, 0xEC6D199F },
+              { 0xAB82C84D, 0x8D214661, 0x72E6B6C2, 0xAA0D0607, 0xFA1CF291, 0x9D9EE105, 0xF54EA1BC, 0xC2811DDD } },
+            { { 0x69FB69B1, 0x844F08B9, 0xC5F8F4A4, 0x637A31C5, 0x2E6DE1EC, 0x19516DF1, 0x83889610, 0xC25A3D62 },
+              { 0x166382F2, 0x58E11EDE, 0xFCBED705, 0xC5FA654C, 0x293D735B, 0x2B5392B2, 0xABD3C5B0, 0x4BE11D2B } },
+            { { 0x6EE338DE, 0x8D73E64A, 0x2DA19137, 0xA1F20BF9, 0x86F18A55, 0x208E4E26, 0xC5420BA5, 0x7D8B8843 },
+              { 0x049251C9, 0x4CBDF212, 0x2A35AA0D, 0xCF981A3E, 0x7F6C6559, 0xB01E2B00, 0x194CA7D0, 0x09CD5742 } },
+            { { 0x7D211845, 0x23AD883A, 0xA44AD7EB, 0xB6668088, 0xB718D5FF, 0xF69F5E53, 0xD194ADBB, 0xC9D52202 },
+              { 0xE71E6957, 0xE44728DD, 0xB38B3CBD, 0xBBCB7C9C, 0x3D06203B, 0x215F89AA, 0x9EF2D5B1, 0xA1F5E8D6 } },
+            { { 0xF975B73C, 0x5C321F95, 0x0F6195C4, 0x18DF9C85, 0xF55A615F, 0x4BE36502, 0x22B8A30E, 0xED68CEA2 },
+              { 0x39892A4E, 0xB039A0D2, 0xA37F3825, 0xF2ABF053, 0xC04198CF, 0xB2B58691, 0x3DD164DE, 0x2A0ADA23 } },
+            { { 0x674E45A1, 0xAD07158E, 0x1A5C554D, 0x5D344B7E, 0xD730DF59, 0xAF666F02, 0xBB6D93C2, 0x6EF86C0D },
+              { 0x7307865A, 0xB39A207E, 0xBADF3619, 0xB862947D, 0x3261FDC0, 0x911D352A, 0xEA7B11A9, 0x6D821490 } },
+            { { 0xEE6A60BA, 0x3FD03A96, 0x3C1C05D6, 0xEB744B36, 0xD8F9047D, 0xA37BE1F2, 0xB50CD56C, 0x0177E554 },
+              { 0x4E0BD649, 0x735D7C99, 0x38CA54E5, 0x2AF8F56F, 0x74934273, 0x7E84671F, 0x0B80907E, 0xF74A2946 } },
+            { { 0x6ECBACA3, 0x7945E215, 0xC92EC7BB, 0x97B38E35, 0x548A902C, 0xDAD67653, 0x7826BC83, 0x1FAE5DFA },
+              { 0x318C675B, 0xE4249C5E, 0x1E025186, 0x60772B04, 0x5586147C, 0xF18F5B50, 0xA333C855, 0xE55EBF16 } },
+            { { 0xBE9DABE2, 0xD6668EDC, 0xBD5E1281, 0xA8689E49, 0x66B38E63, 0x030D075B, 0x9CBB9D6F, 0x11EE888A },
+              { 0xF0B6054F, 0x6ECF1E76, 0x8A1E1E29, 0xF0CF20FE, 0x9D75CD19, 0x85643178, 0xE51E690C, 0x4B4806CC } },
+            { { 0xC734725B, 0xB05F10F3, 0x61286E86, 0x9E5818F1, 0x82D0D88B, 0xCE7816D4, 0x982AAEDD, 0x2A138528 },
+              { 0xB5C08088, 0x4E10A319, 0x30FADF5F, 0x28D80D8C, 0xF617D232, 0x29CDA8AC, 0x940ADA4F, 0x9C0541AC } },
+        },
+    },
+#ifdef BOOTLOADER_BENCHMARK
+    /* Benchmark test key */
+    {
+        .public_key = {
+            0xab, 0x50, 0x08, 0x53, 0x77, 0xaf, 0x8d, 0xe5, 0x70, 0x7e, 0x6c, 0x52, 0xcc, 0xc6, 0x03, 0x9d,
+            0x07, 0xac, 0x56, 0xf1, 0x68, 0x61, 0x9a, 0xe9, 0xaa, 0xa8, 0xaf, 0x65, 0x5d, 0xba, 0x62, 0x49,
+            0xa6, 0x2a, 0x1e, 0xa6, 0xdf, 0x49, 0xd7, 0x8d, 0x78, 0xd2, 0xda, 0x69, 0x51, 0xa8, 0xfe, 0xdc,
+            0xef, 0x6a, 0x37, 0xb5, 0x2a, 0x30, 0x4b, 0xe8, 0x65, 0x9e, 0xca, 0x4d, 0x02, 0x96, 0x3c, 0x58,
+        },
+        .table = {
+            { { 0x4BC2BCE9, 0xB2C64426, 0xDC8FEF4E, 0x65B0076B, 0xDF2E2375, 0x0B9E0AE8, 0x25CA14FB, 0xB258197B },
+              { 0xCF051E1E, 0x3FDF46BA, 0x1B53B2FF, 0xEC9A223F, 0xE47273E3, 0x3CC8FEF6, 0xFACF97B9, 0x10FE3B6B } },
+            { { 0x1F4A2C5D, 0xF7BF4261, 0x707CCC78, 0xB27BE88F, 0x213F5961, 0x5F3D8F8D, 0x4FF1C506, 0x0775FEF2 },
+              { 0x3D5C3AA7, 0xFAD5459F, 0xE2C723B1, 0x06FBF5D2, 0x04C3AF9F, 0xF7AD1662, 0x69C6257B, 0xE123DFED } },
+            { { 0x168AEBDF, 0x449F6CD4, 0xB1BFD005, 0x9A4ABC5A, 0x16C9BE8B, 0x20E2D9A7, 0x02D15A8F, 0x55BED52A },
+              { 0xE8521B63, 0x37B6BE99, 0x8C9260B4, 0xEEB85408, 0x0823478E, 0xE57E3208, 0x273071B3, 0xA5763145 } },
+            { { 0x740116F3, 0x354CAE7F, 0x28D7F052, 0xB9142F73, 0x4D7B9B27, 0xE293747C, 0xDA87464E, 0x207FFA8F },
+              { 0xA0881449, 0x65FA9537, 0x048DC9E6, 0x2E7F51FF, 0x54566275, 0x51A87FED, 0x08F50113, 0xF56BDBD3 } },
+            { { 0x30848699, 0x3E4DC1E0, 0xAD28AA24, 0xA20387E3, 0x283C725D, 0xC62F94BE, 0x8219401A, 0x75388BFD },
+              { 0xB012F132, 0x9FF3FDF5, 0x03336E7C, 0x3DD495ED, 0x35B90A17, 0xACA62FAF, 0x6EDA17D0, 0xEC1C3956 } },
+            { { 0x5BF65ECD, 0x33B3AC15, 0x3A02BC15, 0x1EFEDCD1, 0xA0C0FAE9, 0xA0A7C24B, 0x3A478732, 0x52837894 },
+              { 0x0B80FF49, 0x604FD23F, 0xF61B0131, 0x93EBD7B8, 0x0A0B1E87, 0x02EB2832, 0xB6BBF4BF, 0xA13F64EB } },
+            { { 0x137B1F97, 0xA9CB5717, 0x991274E6, 0x6B5DEAB2, 0xDEF2E23A, 0x5591E60D, 0x10838788, 0x62D71BD7 },
+              { 0xC6E84B3D, 0xF7EE7AF4, 0x13FA61F2, 0x05188C7F, 0x8217AC4C, 0x2B42C66E, 0x713C2F05, 0xEB2CF038 } },
+            { { 0x9C24C280, 0xA907084C, 0xFD51E74B, 0x6E31A621, 0x60FC2039, 0xD6342388, 0x9E3CE7C9, 0x3F8D448A },
+              { 0x864835B4, 0x94DBF489, 0xA402DB21, 0xEAAEC46D, 0x12EFF760, 0x15141791, 0xA683A599, 0x966182EF } },
+            { { 0xE963EEB9, 0x698C21A4, 0xDA0FEF38, 0x7B13A842, 0x97840366, 0x7FBEC7AD, 0xC39E6F9E, 0xE54C4DB7 },
+              { 0xCA40EB26, 0xA727EA7F, 0x16C0F182, 0x7AA3EE63, 0x5DEC8499, 0xA0C20EF6, 0x60A36607, 0xCCBA4E3A } },
+            { { 0x766786AD, 0xB259B7CF, 0xFCD83CE8, 0xE70AD6FE, 0xF5F22A86, 0x862E83E8, 0x4C037FD2, 0x1B4C7668 },
+              { 0xA34B8E35, 0xAEDF00FC, 0x3B5B40D3, 0x29735564, 0x4F522FA5, 0xC5BF2D84, 0x566972DA, 0xCD96D84E } },
+            { { 0x96246151, 0x07456895, 0x58D78988, 0xA19AE015, 0x0659DF1C, 0x87E62C8B, 0xAD852365, 0x3BE0C7D6 },
+              { 0xE1336DF1, 0x8298E0CB, 0x4FEC1160, 0xD93B09A3, 0xFE06F276, 0xF6B44B0F, 0x4AA59A5A, 0x4A1230B2 } },
+            { { 0x7DCA77BE, 0xDE50051D, 0xD6188C70, 0xCD046BB5, 0x4D489FF1, 0x210DA9BF, 0x6106E135, 0x2B0C567E },
+              { 0x18E90DA4, 0xB75E9477, 0x668F6BF7, 0x17414C91, 0x5AAAEEF9, 0x0358EC1B, 0x3EA1086C, 0x82EE78E3 } },
+            { { 0x158DEF1F, 0x73448258, 0x6C38DB8D, 0xB1ED7607, 0x1A8532EC, 0xE2B181A3, 0xADEBA927, 0xF24573BF },
+              { 0xB73BD438, 0xB38F98A2, 0x6E4E832B, 0x5C478254, 0x57FDA929, 0x4F507E5D, 0xCC0633AF, 0xA4A9121B } },
+            { { 0xAA20BA9F, 0x5F60AEAD, 0x6462926D, 0x49901BC8, 0x4E2DCB8E, 0x07438C83, 0xCCD18416, 0xA76D70F4 },
+              { 0x80390FDF, 0xE7020569, 0x9AE8A301, 0xA54C9A8D, 0xC0A82918, 0x835F60B9, 0xDC806890, 0x57C68432 } },
+            { { 0xB5AE099E, 0x8857DB93, 0xF0CFFFD3, 0x4148147B, 0x90952764, 0xDF68EA30, 0x417F3D39, 0x679C919C },
+              { 0x98AADB27, 0xC389D648, 0xE759C562, 0xDC0C852A, 0xAB8E0FA3, 0x7DC1CC41, 0x49636040, 0x3D7E0055 } },
+        },
+    },
+#endif
+};
+
+const uint32_t p256_fixed_key_count = sizeof(p256_fixed_keys) / sizeof(p256_fixed_keys[0]);
@@ -0,0 +1,36 @@
+/**
+ * @file p256_tables.h
+ * @brief Precomputed comb tables for P-256 verification with fixed keys
+ * @details The scalar is split into P256_COMB_TEETH interleaved parts of
+ *          P256_COMB_SPACING bits. Entry i - 1 of a table holds the sum of
+ *          2^(P256_COMB_SPACING * j) * P over the bits j set in i.
+ *          The tables are generated by tools/p256_tables/gen_p256_tables.py.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* General defines ------------------------------------------------------------------*/
+#define P256_WORDS                          8U
+#define P256_COMB_TEETH                     4U
+#define P256_COMB_SPACING                   (256U / P256_COMB_TEETH)
+#define P256_COMB_TABLE_SIZE                ((1U << P256_COMB_TEETH) - 1U)
+
+/* Types ------------------------------------------------------------------*/
+typedef struct {
+    uint32_t x[P256_WORDS];                 /* Little endian words, Montgomery domain */
+    uint32_t y[P256_WORDS];
+} p256_affine_t;
+
+typedef struct {
+    uint8_t public_key[64];                 /* X | Y, big endian, as in public_key_t */
+    p256_affine_t table[P256_COMB_TABLE_SIZE];
+} p256_fixed_key_t;
+
+/* Public Variables ------------------------------------------------------------------*/
+extern const p256_affine_t p256_base_table[P256_COMB_TABLE_SIZE];
+extern const p256_fixed_key_t p256_fixed_keys[];
+extern const uint32_t p256_fixed_key_count;
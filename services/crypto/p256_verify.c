@@ -0,0 +1,413 @@
+/**
+ * @file p256_verify.c
+ * @brief ECDSA P-256 verification for keys known at build time
+ * @details Numbers are 8 little endian 32-bit words. Field elements live in the
+ *          Montgomery domain (a * 2^256 mod p) so every product is a single
+ *          Montgomery multiplication. Points are Jacobian, with the comb table
+ *          entries added as affine points (mixed addition).
+ * @date 19/10/2026
+ */
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <string.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "p256_verify.h"
+#include "p256_tables.h"
+#include "umaal.h"
+
+/* The project is built for size, this kernel is worth the extra bytes */
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize ("O2")
+#endif
+
+/* Private types --------------------------------------------------------------------*/
+typedef struct {
+	uint32_t m[P256_WORDS];
+	uint32_t n0;                    /* -m^-1 mod 2^32 */
+	uint32_t r2[P256_WORDS];        /* 2^512 mod m, converts into the Montgomery domain */
+	uint32_t one[P256_WORDS];       /* 2^256 mod m, 1 in the Montgomery domain */
+} p256_modulus_t;
+
+typedef struct {
+	uint32_t x[P256_WORDS];
+	uint32_t y[P256_WORDS];
+	uint32_t z[P256_WORDS];
+	bool infinity;
+} p256_jacobian_t;
+
+/* Static Variables -----------------------------------------------------------------*/
+static const p256_modulus_t p256_p = {
+	.m = { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0xFFFFFFFF },
+	.n0 = 0x00000001,
+	.r2 = { 0x00000003, 0x00000000, 0xFFFFFFFF, 0xFFFFFFFB, 0xFFFFFFFE, 0xFFFFFFFF, 0xFFFFFFFD, 0x00000004 },
+	.one = { 0x00000001, 0x00000000, 0x00000000, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFE, 0x00000000 },
+};
+
+static const p256_modulus_t p256_n = {
+	.m = { 0xFC632551, 0xF3B9CAC2, 0xA7179E84, 0xBCE6FAAD, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0xFFFFFFFF },
+	.n0 = 0xEE00BC4F,
+	.r2 = { 0xBE79EEA2, 0x83244C95, 0x49BD6FA6, 0x4699799C, 0x2B6BEC59, 0x2845B239, 0xF3D95620, 0x66E12D94 },
+	.one = { 0x039CDAAF, 0x0C46353D, 0x58E8617B, 0x43190552, 0x00000000, 0x00000000, 0xFFFFFFFF, 0x00000000 },
+};
+
+/* n - 2, the exponent of the modular inverse */
+static const uint32_t p256_n_minus_2[P256_WORDS] = {
+	0xFC63254F, 0xF3B9CAC2, 0xA7179E84, 0xBCE6FAAD, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0xFFFFFFFF
+};
+
+/* Private Functions ----------------------------------------------------------------*/
+static void p256_from_bytes(uint32_t r[P256_WORDS], const uint8_t bytes[32])
+{
+	for (uint32_t i = 0; i < P256_WORDS; i++) {
+		const uint8_t *b = &bytes[28U - (4U * i)];
+		r[i] = ((uint32_t)b[0] << 24) | ((uint32_t)b[1] << 16) | ((uint32_t)b[2] << 8) | b[3];
+	}
+}
+
+static bool p256_is_zero(const uint32_t a[P256_WORDS])
+{
+	uint32_t bits = 0;
+
+	for (uint32_t i = 0; i < P256_WORDS; i++) {
+		bits |= a[i];
+	}
+
+	return bits == 0;
+}
+
+static int p256_cmp(const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS])
+{
+	for (int i = (int)P256_WORDS - 1; i >= 0; i--) {
+		if (a[i] != b[i]) {
+			return (a[i] > b[i]) ? 1 : -1;
+		}
+	}
+
+	return 0;
+}
+
+static uint32_t p256_add_words(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS])
+{
+	uint64_t carry = 0;
+
+	for (uint32_t i = 0; i < P256_WORDS; i++) {
+		carry += (uint64_t)a[i] + b[i];
+		r[i] = (uint32_t)carry;
+		carry >>= 32;
+	}
+
+	return (uint32_t)carry;
+}
+
+static uint32_t p256_sub_words(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS])
+{
+	int64_t borrow = 0;
+
+	for (uint32_t i = 0; i < P256_WORDS; i++) {
+		borrow += (int64_t)a[i] - b[i];
+		r[i] = (uint32_t)borrow;
+		borrow >>= 32;
+	}
+
+	return (uint32_t)(borrow & 1);
+}
+
+static void p256_mod_add(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS],
+		const p256_modulus_t *mod)
+{
+	if (p256_add_words(r, a, b) != 0 || p256_cmp(r, mod->m) >= 0) {
+		(void)p256_sub_words(r, r, mod->m);
+	}
+}
+
+static void p256_mod_sub(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS],
+		const p256_modulus_t *mod)
+{
+	if (p256_sub_words(r, a, b) != 0) {
+		(void)p256_add_words(r, r, mod->m);
+	}
+}
+
+/* r = a * b / 2^256 mod m (CIOS), a and b below m; r may alias a or b */
+static void p256_mont_mul(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS],
+		const p256_modulus_t *mod)
+{
+	uint32_t t[P256_WORDS + 2U] = { 0 };
+
+	for (uint32_t i = 0; i < P256_WORDS; i++) {
+		uint32_t carry = 0;
+
+		for (uint32_t j = 0; j < P256_WORDS; j++) {
+			umaal(&t[j], &carry, a[j], b[i]);
+		}
+		uint64_t sum = (uint64_t)t[P256_WORDS] + carry;
+		t[P256_WORDS] = (uint32_t)sum;
+		t[P256_WORDS + 1U] = (uint32_t)(sum >> 32);
+
+		/* Add q * m so the lowest word cancels, then shift down one word */
+		uint32_t q = t[0] * mod->n0;
+		uint32_t low = t[0];
+		carry = 0;
+		umaal(&low, &carry, q, mod->m[0]);
+		for (uint32_t j = 1; j < P256_WORDS; j++) {
+			low = t[j];
+			umaal(&low, &carry, q, mod->m[j]);
+			t[j - 1U] = low;
+		}
+		sum = (uint64_t)t[P256_WORDS] + carry;
+		t[P256_WORDS - 1U] = (uint32_t)sum;
+		t[P256_WORDS] = t[P256_WORDS + 1U] + (uint32_t)(sum >> 32);
+	}
+
+	if (t[P256_WORDS] != 0 || p256_cmp(t, mod->m) >= 0) {
+		(void)p256_sub_words(t, t, mod->m);
+	}
+
+	memcpy(r, t, P256_WORDS * sizeof(uint32_t));
+}
+
+/* Field shorthands, all in the Montgomery domain of p */
+static inline void fp_mul(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS])
+{
+	p256_mont_mul(r, a, b, &p256_p);
+}
+
+static inline void fp_sqr(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS])
+{
+	p256_mont_mul(r, a, a, &p256_p);
+}
+
+static inline void fp_add(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS])
+{
+	p256_mod_add(r, a, b, &p256_p);
+}
+
+static inline void fp_sub(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS], const uint32_t b[P256_WORDS])
+{
+	p256_mod_sub(r, a, b, &p256_p);
+}
+
+/* dbl-2001-b, a = -3 */
+static void p256_point_double(p256_jacobian_t *p)
+{
+	uint32_t delta[P256_WORDS], gamma[P256_WORDS], beta[P256_WORDS], alpha[P256_WORDS];
+	uint32_t t1[P256_WORDS], t2[P256_WORDS];
+
+	if (p->infinity) {
+		return;
+	}
+
+	fp_sqr(delta, p->z);
+	fp_sqr(gamma, p->y);
+	fp_mul(beta, p->x, gamma);
+
+	/* alpha = 3 * (x - delta) * (x + delta) */
+	fp_sub(t1, p->x, delta);
+	fp_add(t2, p->x, delta);
+	fp_mul(t1, t1, t2);
+	fp_add(alpha, t1, t1);
+	fp_add(alpha, alpha, t1);
+
+	/* z3 = (y + z)^2 - gamma - delta */
+	fp_add(t1, p->y, p->z);
+	fp_sqr(t1, t1);
+	fp_sub(t1, t1, gamma);
+	fp_sub(p->z, t1, delta);
+
+	/* x3 = alpha^2 - 8 * beta */
+	fp_add(beta, beta, beta);
+	fp_add(beta, beta, beta);
+	fp_sqr(t1, alpha);
+	fp_add(t2, beta, beta);
+	fp_sub(p->x, t1, t2);
+
+	/* y3 = alpha * (4 * beta - x3) - 8 * gamma^2 */
+	fp_sub(t1, beta, p->x);
+	fp_mul(t1, alpha, t1);
+	fp_sqr(t2, gamma);
+	fp_add(t2, t2, t2);
+	fp_add(t2, t2, t2);
+	fp_add(t2, t2, t2);
+	fp_sub(p->y, t1, t2);
+}
+
+/* madd-2007-bl, p += q */
+static void p256_point_add_affine(p256_jacobian_t *p, const p256_affine_t *q)
+{
+	uint32_t z1z1[P256_WORDS], h[P256_WORDS], hh[P256_WORDS], r[P256_WORDS];
+	uint32_t i[P256_WORDS], j[P256_WORDS], v[P256_WORDS], t[P256_WORDS];
+
+	if (p->infinity) {
+		memcpy(p->x, q->x, sizeof(p->x));
+		memcpy(p->y, q->y, sizeof(p->y));
+		memcpy(p->z, p256_p.one, sizeof(p->z));
+		p->infinity = false;
+		return;
+	}
+
+	fp_sqr(z1z1, p->z);
+	fp_mul(h, q->x, z1z1);                  /* u2 */
+	fp_sub(h, h, p->x);
+	fp_mul(r, q->y, p->z);
+	fp_mul(r, r, z1z1);                     /* s2 */
+	fp_sub(r, r, p->y);
+
+	if (p256_is_zero(h)) {
+		if (p256_is_zero(r)) {
+			p256_point_double(p);
+		} else {
+			p->infinity = true;
+		}
+		return;
+	}
+
+	fp_sqr(hh, h);
+	fp_add(i, hh, hh);
+	fp_add(i, i, i);
+	fp_mul(j, h, i);
+	fp_add(r, r, r);
+	fp_mul(v, p->x, i);
+
+	/* z3 = (z1 + h)^2 - z1z1 - hh */
+	fp_add(t, p->z, h);
+	fp_sqr(t, t);
+	fp_sub(t, t, z1z1);
+	fp_sub(p->z, t, hh);
+
+	/* y3 = r * (v - x3) - 2 * y1 * j, needs y1 so x3 goes to t first */
+	fp_sqr(t, r);
+	fp_sub(t, t, j);
+	fp_sub(t, t, v);
+	fp_sub(t, t, v);
+	fp_sub(v, v, t);
+	fp_mul(v, r, v);
+	fp_mul(j, p->y, j);
+	fp_add(j, j, j);
+	fp_sub(p->y, v, j);
+	memcpy(p->x, t, sizeof(p->x));
+}
+
+static uint32_t p256_comb_index(const uint32_t k[P256_WORDS], uint32_t column)
+{
+	uint32_t index = 0;
+
+	for (uint32_t tooth = 0; tooth < P256_COMB_TEETH; tooth++) {
+		uint32_t bit = column + (tooth * P256_COMB_SPACING);
+		index |= ((k[bit >> 5] >> (bit & 31U)) & 1U) << tooth;
+	}
+
+	return index;
+}
+
+/* r = u1 * G + u2 * Q, both with combs sharing the doublings */
+static void p256_double_comb(p256_jacobian_t *r, const uint32_t u1[P256_WORDS], const uint32_t u2[P256_WORDS],
+		const p256_affine_t *key_table)
+{
+	r->infinity = true;
+
+	for (int column = (int)P256_COMB_SPACING - 1; column >= 0; column--) {
+		p256_point_double(r);
+
+		uint32_t index = p256_comb_index(u1, (uint32_t)column);
+		if (index != 0) {
+			p256_point_add_affine(r, &p256_base_table[index - 1U]);
+		}
+
+		index = p256_comb_index(u2, (uint32_t)column);
+		if (index != 0) {
+			p256_point_add_affine(r, &key_table[index - 1U]);
+		}
+	}
+}
+
+/* r = a^-1 * 2^256 mod n, from a in the Montgomery domain (Fermat) */
+static void p256_scalar_invert(uint32_t r[P256_WORDS], const uint32_t a[P256_WORDS])
+{
+	uint32_t result[P256_WORDS];
+
+	memcpy(result, p256_n.one, sizeof(result));
+
+	for (int bit = 255; bit >= 0; bit--) {
+		p256_mont_mul(result, result, result, &p256_n);
+		if ((p256_n_minus_2[bit >> 5] >> (bit & 31)) & 1U) {
+			p256_mont_mul(result, result, a, &p256_n);
+		}
+	}
+
+	memcpy(r, result, sizeof(result));
+}
+
+/* x(R) mod n == r, without leaving the Jacobian coordinates: x * z^2 == X for x = r or r + n */
+static bool p256_x_matches(const p256_jacobian_t *point, const uint32_t r[P256_WORDS])
+{
+	uint32_t z2[P256_WORDS], candidate[P256_WORDS], t[P256_WORDS];
+
+	fp_sqr(z2, point->z);
+	memcpy(candidate, r, sizeof(candidate));
+
+	for (uint32_t attempt = 0; attempt < 2U; attempt++) {
+		fp_mul(t, candidate, p256_p.r2);
+		fp_mul(t, t, z2);
+		if (p256_cmp(t, point->x) == 0) {
+			return true;
+		}
+
+		if (p256_add_words(candidate, candidate, p256_n.m) != 0 || p256_cmp(candidate, p256_p.m) >= 0) {
+			break;
+		}
+	}
+
+	return false;
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @brief Verify an ECDSA P-256 signature of a SHA-256 hash.
+ * @param public_key X | Y, big endian; only keys with a generated table are supported
+ * @param signature r | s, big endian
+ * @return P256_VERIFY_OK, P256_VERIFY_BAD_SIGNATURE or P256_VERIFY_UNKNOWN_KEY
+ */
+int p256_verify_fixed(const uint8_t public_key[64], const uint8_t hash[32], const uint8_t signature[64])
+{
+	const p256_fixed_key_t *key = NULL;
+	uint32_t e[P256_WORDS], r[P256_WORDS], s[P256_WORDS], u1[P256_WORDS], u2[P256_WORDS];
+	p256_jacobian_t point;
+
+	for (uint32_t i = 0; i < p256_fixed_key_count; i++) {
+		if (memcmp(p256_fixed_keys[i].public_key, public_key, sizeof(p256_fixed_keys[i].public_key)) == 0) {
+			key = &p256_fixed_keys[i];
+			break;
+		}
+	}
+
+	if (key == NULL) {
+		return P256_VERIFY_UNKNOWN_KEY;
+	}
+
+	p256_from_bytes(r, &signature[0]);
+	p256_from_bytes(s, &signature[32]);
+	if (p256_is_zero(r) || p256_is_zero(s) || p256_cmp(r, p256_n.m) >= 0 || p256_cmp(s, p256_n.m) >= 0) {
+		return P256_VERIFY_BAD_SIGNATURE;
+	}
+
+	p256_from_bytes(e, hash);
+	if (p256_cmp(e, p256_n.m) >= 0) {
+		(void)p256_sub_words(e, e, p256_n.m);
+	}
+
+	/* w = s^-1 kept in the Montgomery domain, so u = x * w comes out plain */
+	p256_mont_mul(s, s, p256_n.r2, &p256_n);
+	p256_scalar_invert(s, s);
+	p256_mont_mul(u1, e, s, &p256_n);
+	p256_mont_mul(u2, r, s, &p256_n);
+
+	p256_double_comb(&point, u1, u2, key->table);
+
+	if (point.infinity || !p256_x_matches(&point, r)) {
+		return P256_VERIFY_BAD_SIGNATURE;
+	}
+
+	return P256_VERIFY_OK;
+}
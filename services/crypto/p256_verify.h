@@ -0,0 +1,24 @@
+/**
+ * @file p256_verify.h
+ * @brief ECDSA P-256 verification for keys known at build time
+ * @details Both u1 * G and u2 * Q are computed with fixed-base combs sharing their
+ *          doublings, from tables precomputed for G and for every key in main.c
+ *          (see p256_tables.h). Field and scalar arithmetic use Montgomery
+ *          multiplication on the UMAAL multiply-accumulate when the DSP extension
+ *          is available. Verification handles public data only and is not
+ *          constant time.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* General defines ------------------------------------------------------------------*/
+#define P256_VERIFY_OK                      0
+#define P256_VERIFY_BAD_SIGNATURE           -1
+#define P256_VERIFY_UNKNOWN_KEY             -2      /* No table for this key */
+
+/* Public Functions ------------------------------------------------------------------*/
+int p256_verify_fixed(const uint8_t public_key[64], const uint8_t hash[32], const uint8_t signature[64]);
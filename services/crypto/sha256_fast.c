@@ -0,0 +1,171 @@
+/**
+ * @file sha256_fast.c
+ * @brief SHA-256 block function tuned for the Cortex-M33
+ * @date 19/10/2026
+ */
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <string.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include <tinycrypt/constants.h>
+#include "sha256_fast.h"
+
+/* The project is built for size, this kernel is worth the extra bytes */
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize ("O2")
+#endif
+
+/* Private defines ------------------------------------------------------------------*/
+#define SHA256_ROTR(x, n)                   (((x) >> (n)) | ((x) << (32U - (n))))
+#define SHA256_S0(x)                        (SHA256_ROTR((x), 2U) ^ SHA256_ROTR((x), 13U) ^ SHA256_ROTR((x), 22U))
+#define SHA256_S1(x)                        (SHA256_ROTR((x), 6U) ^ SHA256_ROTR((x), 11U) ^ SHA256_ROTR((x), 25U))
+#define SHA256_s0(x)                        (SHA256_ROTR((x), 7U) ^ SHA256_ROTR((x), 18U) ^ ((x) >> 3))
+#define SHA256_s1(x)                        (SHA256_ROTR((x), 17U) ^ SHA256_ROTR((x), 19U) ^ ((x) >> 10))
+#define SHA256_CH(x, y, z)                  ((z) ^ ((x) & ((y) ^ (z))))
+#define SHA256_MAJ(x, y, z)                 (((x) & (y)) | ((z) & ((x) | (y))))
+
+/* Schedule word i: loaded for the first 16 rounds, expanded in place afterwards */
+#define SHA256_W_LOAD(i)                    (w[(i)])
+#define SHA256_W_EXPAND(i)                  (w[(i) & 15U] += SHA256_s1(w[((i) - 2U) & 15U]) + w[((i) - 7U) & 15U] + SHA256_s0(w[((i) - 15U) & 15U]))
+
+/* One round; the caller rotates the working variables through the arguments */
+#define SHA256_ROUND(a, b, c, d, e, f, g, h, i, W) \
+	do { \
+		uint32_t t1 = (h) + SHA256_S1(e) + SHA256_CH((e), (f), (g)) + sha256_k[(i)] + W(i); \
+		(d) += t1; \
+		(h) = t1 + SHA256_S0(a) + SHA256_MAJ((a), (b), (c)); \
+	} while (0)
+
+#define SHA256_ROUNDS_8(i, W) \
+	do { \
+		SHA256_ROUND(a, b, c, d, e, f, g, h, (i) + 0U, W); \
+		SHA256_ROUND(h, a, b, c, d, e, f, g, (i) + 1U, W); \
+		SHA256_ROUND(g, h, a, b, c, d, e, f, (i) + 2U, W); \
+		SHA256_ROUND(f, g, h, a, b, c, d, e, (i) + 3U, W); \
+		SHA256_ROUND(e, f, g, h, a, b, c, d, (i) + 4U, W); \
+		SHA256_ROUND(d, e, f, g, h, a, b, c, (i) + 5U, W); \
+		SHA256_ROUND(c, d, e, f, g, h, a, b, (i) + 6U, W); \
+		SHA256_ROUND(b, c, d, e, f, g, h, a, (i) + 7U, W); \
+	} while (0)
+
+/* Static Variables -----------------------------------------------------------------*/
+static const uint32_t sha256_k[64] = {
+	0x428A2F98UL, 0x71374491UL, 0xB5C0FBCFUL, 0xE9B5DBA5UL, 0x3956C25BUL, 0x59F111F1UL, 0x923F82A4UL, 0xAB1C5ED5UL,
+	0xD807AA98UL, 0x12835B01UL, 0x243185BEUL, 0x550C7DC3UL, 0x72BE5D74UL, 0x80DEB1FEUL, 0x9BDC06A7UL, 0xC19BF174UL,
+	0xE49B69C1UL, 0xEFBE4786UL, 0x0FC19DC6UL, 0x240CA1CCUL, 0x2DE92C6FUL, 0x4A7484AAUL, 0x5CB0A9DCUL, 0x76F988DAUL,
+	0x983E5152UL, 0xA831C66DUL, 0xB00327C8UL, 0xBF597FC7UL, 0xC6E00BF3UL, 0xD5A79147UL, 0x06CA6351UL, 0x14292967UL,
+	0x27B70A85UL, 0x2E1B2138UL, 0x4D2C6DFCUL, 0x53380D13UL, 0x650A7354UL, 0x766A0ABBUL, 0x81C2C92EUL, 0x92722C85UL,
+	0xA2BFE8A1UL, 0xA81A664BUL, 0xC24B8B70UL, 0xC76C51A3UL, 0xD192E819UL, 0xD6990624UL, 0xF40E3585UL, 0x106AA070UL,
+	0x19A4C116UL, 0x1E376C08UL, 0x2748774CUL, 0x34B0BCB5UL, 0x391C0CB3UL, 0x4ED8AA4AUL, 0x5B9CCA4FUL, 0x682E6FF3UL,
+	0x748F82EEUL, 0x78A5636FUL, 0x84C87814UL, 0x8CC70208UL, 0x90BEFFFAUL, 0xA4506CEBUL, 0xBEF9A3F7UL, 0xC67178F2UL,
+};
+
+/* Private Functions ----------------------------------------------------------------*/
+static inline uint32_t sha256_load_be(const uint8_t *p)
+{
+	uint32_t word;
+
+	/* Single unaligned LDR on the M33, byte loads elsewhere */
+	memcpy(&word, p, sizeof(word));
+	return __builtin_bswap32(word);
+}
+
+/**
+ * @brief Hash whole 64 byte blocks into the state.
+ */
+SHA256_FAST_SECTION static void sha256_compress(unsigned int state[8], const uint8_t *data, size_t blocks)
+{
+	uint32_t a = state[0];
+	uint32_t b = state[1];
+	uint32_t c = state[2];
+	uint32_t d = state[3];
+	uint32_t e = state[4];
+	uint32_t f = state[5];
+	uint32_t g = state[6];
+	uint32_t h = state[7];
+	bool aligned = (((uintptr_t)data) & 3U) == 0U;
+	uint32_t w[16];
+
+	while (blocks-- != 0U) {
+		if (aligned) {
+			const uint32_t *words = (const uint32_t *)(const void *)data;
+
+			for (uint32_t i = 0; i < 16U; i++) {
+				w[i] = __builtin_bswap32(words[i]);
+			}
+		} else {
+			for (uint32_t i = 0; i < 16U; i++) {
+				w[i] = sha256_load_be(&data[i * 4U]);
+			}
+		}
+
+		SHA256_ROUNDS_8(0U, SHA256_W_LOAD);
+		SHA256_ROUNDS_8(8U, SHA256_W_LOAD);
+		SHA256_ROUNDS_8(16U, SHA256_W_EXPAND);
+		SHA256_ROUNDS_8(24U, SHA256_W_EXPAND);
+		SHA256_ROUNDS_8(32U, SHA256_W_EXPAND);
+		SHA256_ROUNDS_8(40U, SHA256_W_EXPAND);
+		SHA256_ROUNDS_8(48U, SHA256_W_EXPAND);
+		SHA256_ROUNDS_8(56U, SHA256_W_EXPAND);
+
+		a = (state[0] += a);
+		b = (state[1] += b);
+		c = (state[2] += c);
+		d = (state[3] += d);
+		e = (state[4] += e);
+		f = (state[5] += f);
+		g = (state[6] += g);
+		h = (state[7] += h);
+		data += TC_SHA256_BLOCK_SIZE;
+	}
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @brief Same contract as tc_sha256_update().
+ * @return TC_CRYPTO_SUCCESS, or TC_CRYPTO_FAIL if s or data is NULL
+ */
+int sha256_fast_update(TCSha256State_t s, const uint8_t *data, size_t datalen)
+{
+	if (s == NULL || data == NULL) {
+		return TC_CRYPTO_FAIL;
+	}
+	if (datalen == 0U) {
+		return TC_CRYPTO_SUCCESS;
+	}
+
+	/* Complete a block started by an earlier call */
+	if (s->leftover_offset != 0U) {
+		size_t take = TC_SHA256_BLOCK_SIZE - s->leftover_offset;
+
+		if (take > datalen) {
+			take = datalen;
+		}
+		memcpy(&s->leftover[s->leftover_offset], data, take);
+		s->leftover_offset += take;
+		data += take;
+		datalen -= take;
+
+		if (s->leftover_offset < TC_SHA256_BLOCK_SIZE) {
+			return TC_CRYPTO_SUCCESS;
+		}
+		sha256_compress(s->iv, s->leftover, 1U);
+		s->bits_hashed += (uint64_t)TC_SHA256_BLOCK_SIZE * 8U;
+		s->leftover_offset = 0U;
+	}
+
+	size_t blocks = datalen / TC_SHA256_BLOCK_SIZE;
+	if (blocks != 0U) {
+		sha256_compress(s->iv, data, blocks);
+		s->bits_hashed += (uint64_t)blocks * TC_SHA256_BLOCK_SIZE * 8U;
+		data += blocks * TC_SHA256_BLOCK_SIZE;
+		datalen -= blocks * TC_SHA256_BLOCK_SIZE;
+	}
+
+	memcpy(s->leftover, data, datalen);
+	s->leftover_offset = datalen;
+
+	return TC_CRYPTO_SUCCESS;
+}
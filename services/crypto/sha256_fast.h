@@ -0,0 +1,36 @@
+/**
+ * @file sha256_fast.h
+ * @brief SHA-256 block function tuned for the Cortex-M33
+ * @details Drop-in replacement for tc_sha256_update(): works on the same state,
+ *          so tc_sha256_init() and tc_sha256_final() are used around it and a
+ *          hash may be started with one and continued with the other. The 64
+ *          rounds are fully unrolled, the message schedule is kept as a 16 word
+ *          window, and whole blocks are hashed straight from the caller's buffer
+ *          (word loads + REV when it is word aligned). The kernel runs from RAM
+ *          unless SHA256_FAST_IN_RAM is defined to 0.
+ *
+ *          On target, tc_sha256_update() is redirected here by linking with
+ *          -Wl,--wrap=tc_sha256_update (see mem_sha256.c).
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+#include <tinycrypt/sha256.h>
+
+/* General defines ------------------------------------------------------------------*/
+#ifndef SHA256_FAST_IN_RAM
+#define SHA256_FAST_IN_RAM                  1
+#endif
+
+#if SHA256_FAST_IN_RAM && defined(__arm__)
+#define SHA256_FAST_SECTION                 __attribute__((section(".RamFunc")))
+#else
+#define SHA256_FAST_SECTION
+#endif
+
+/* Public Functions ------------------------------------------------------------------*/
+int sha256_fast_update(TCSha256State_t s, const uint8_t *data, size_t datalen);
@@ -0,0 +1,27 @@
+/**
+ * @file sha512.h
+ * @brief SHA-512 (FIPS 180-4), needed by Ed25519
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* General defines ------------------------------------------------------------------*/
+#define SHA512_DIGEST_SIZE                  64U
+#define SHA512_BLOCK_SIZE                   128U
+
+/* Types ------------------------------------------------------------------*/
+typedef struct {
+    uint64_t state[8];
+    uint64_t bytes;                         /* Total bytes hashed */
+    uint8_t block[SHA512_BLOCK_SIZE];
+    uint32_t block_used;
+} sha512_ctx_t;
+
+/* Public Functions ------------------------------------------------------------------*/
+void sha512_init(sha512_ctx_t *ctx);
+void sha512_update(sha512_ctx_t *ctx, const void *data, uint32_t size);
+void sha512_final(sha512_ctx_t *ctx, uint8_t digest[SHA512_DIGEST_SIZE]);
@@ -0,0 +1,24 @@
+/**
+ * @file umaal.h
+ * @brief 32x32+32+32 multiply-accumulate for multi-precision arithmetic
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Public Functions ------------------------------------------------------------------*/
+/* {hi:lo} = a * b + lo + hi, which cannot overflow 64 bits (UMAAL with the DSP extension) */
+static inline void umaal(uint32_t *lo, uint32_t *hi, uint32_t a, uint32_t b)
+{
+#if defined(__ARM_FEATURE_DSP)
+	__asm__ ("umaal %0, %1, %2, %3" : "+r" (*lo), "+r" (*hi) : "r" (a), "r" (b));
+#else
+	uint64_t result = ((uint64_t)a * b) + *lo + *hi;
+
+	*lo = (uint32_t)result;
+	*hi = (uint32_t)(result >> 32);
+#endif
+}
@@ -0,0 +1,160 @@
+/**
+ * @file dlog.c
+ * @brief Deferred binary log
+ * @date 19/10/2026
+ */
+
+/* Private Includes ------------------------------------------------------------------*/
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "dlog.h"
+
+/* Private defines ------------------------------------------------------------------*/
+/* Format strings of dlog_printf() whose argument count is remembered */
+#define DLOG_ARGC_CACHE_SIZE                8U
+
+/* Private types --------------------------------------------------------------------*/
+typedef struct {
+	const char *fmt;
+	uint32_t argc;
+} dlog_argc_cache_t;
+
+/* Variables ------------------------------------------------------------------------*/
+__attribute__((section(".noinit"))) dlog_ring_t dlog_ring;
+
+/* Static Variables -----------------------------------------------------------------*/
+static dlog_argc_cache_t dlog_argc_cache[DLOG_ARGC_CACHE_SIZE];
+
+/* Private Functions ----------------------------------------------------------------*/
+static bool dlog_ring_valid(void)
+{
+	return dlog_ring.magic == DLOG_MAGIC && dlog_ring.version == DLOG_VERSION &&
+			dlog_ring.record_count == DLOG_RECORD_COUNT && dlog_ring.tail <= dlog_ring.head;
+}
+
+/* Conversions of a printf format, %% excluded */
+static uint32_t dlog_count_args(const char *fmt)
+{
+	uint32_t argc = 0;
+
+	for (const char *p = fmt; *p != '\0'; p++) {
+		if (*p != '%') {
+			continue;
+		}
+		if (p[1] == '%') {
+			p++;
+			continue;
+		}
+		argc++;
+	}
+
+	return argc;
+}
+
+static uint32_t dlog_lookup_args(const char *fmt)
+{
+	dlog_argc_cache_t *entry = &dlog_argc_cache[((uintptr_t)fmt >> 2) & (DLOG_ARGC_CACHE_SIZE - 1U)];
+
+	if (entry->fmt != fmt) {
+		entry->fmt = fmt;
+		entry->argc = dlog_count_args(fmt);
+	}
+
+	return entry->argc;
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @brief Keep the records of the previous run, or start an empty ring.
+ */
+void dlog_init(void)
+{
+	if (!dlog_ring_valid()) {
+		dlog_ring.magic = DLOG_MAGIC;
+		dlog_ring.version = DLOG_VERSION;
+		dlog_ring.record_count = DLOG_RECORD_COUNT;
+		dlog_ring.head = 0;
+		dlog_ring.tail = 0;
+	}
+
+	DLOG("boot, %u records pending", dlog_pending());
+}
+
+/**
+ * @brief printf-style entry for bootloader_config.log_func.
+ * @details The format string address is logged, so it has to stay valid: string
+ *          literals in FLASH. Only the first DLOG_MAX_ARGS arguments are kept.
+ */
+void dlog_printf(const char *fmt, ...)
+{
+	uint32_t args[DLOG_MAX_ARGS];
+	uint32_t argc = dlog_lookup_args(fmt);
+	va_list ap;
+
+	if (argc > DLOG_MAX_ARGS) {
+		argc = DLOG_MAX_ARGS;
+	}
+
+	va_start(ap, fmt);
+	for (uint32_t i = 0; i < argc; i++) {
+		args[i] = va_arg(ap, uint32_t);
+	}
+	va_end(ap);
+
+	dlog_write((uint32_t)(uintptr_t)fmt, argc, args);
+}
+
+/**
+ * @brief Records not drained yet, the overwritten ones excluded.
+ */
+uint32_t dlog_pending(void)
+{
+	uint32_t pending = dlog_ring.head - dlog_ring.tail;
+
+	return (pending > DLOG_RECORD_COUNT) ? DLOG_RECORD_COUNT : pending;
+}
+
+/**
+ * @brief Index of the oldest record not drained yet.
+ */
+uint32_t dlog_first(void)
+{
+	return dlog_ring.head - dlog_pending();
+}
+
+/**
+ * @brief Copy a record out of the ring.
+ * @param index Record index, counted from the creation of the ring
+ * @return false if it was not written yet or has been overwritten
+ */
+bool dlog_read(uint32_t index, dlog_record_t *record)
+{
+	bool valid = false;
+
+#if defined(__arm__)
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+#endif
+
+	if ((dlog_ring.head - index) - 1U < DLOG_RECORD_COUNT) {
+		*record = dlog_ring.records[index & (DLOG_RECORD_COUNT - 1U)];
+		valid = true;
+	}
+
+#if defined(__arm__)
+	__set_PRIMASK(primask);
+#endif
+
+	return valid;
+}
+
+/**
+ * @brief Mark the records up to index as drained.
+ */
+void dlog_release(uint32_t index)
+{
+	if ((int32_t)(index + 1U - dlog_ring.tail) > 0) {
+		dlog_ring.tail = index + 1U;
+	}
+}
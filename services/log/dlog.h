@@ -0,0 +1,99 @@
+/**
+ * @file dlog.h
+ * @brief Deferred binary log
+ * @details DLOG() stores a record of the timestamp, the address of its format
+ *          string and up to DLOG_MAX_ARGS raw 32-bit arguments in a RAM ring. Nothing
+ *          is formatted on the target: the format strings go to .dlog_fmt, a section
+ *          that is kept in the ELF but not loaded, and tools/dlog/dlog_decode.py
+ *          formats the records against it. Writing a record is a handful of stores
+ *          with interrupts masked.
+ *
+ *          The ring is in .noinit, so it survives a reset into the bootloader and can
+ *          be read by a debugger or drained over CAN afterwards. When it is full the
+ *          oldest records are overwritten.
+ *
+ *          Arguments are 32-bit words: integers, characters and pointers. %s only
+ *          resolves strings that are in FLASH.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "timebase.h"
+
+/* General defines ------------------------------------------------------------------*/
+#define DLOG_MAGIC                          0x474F4C44U     /* "DLOG" */
+#define DLOG_VERSION                        1U
+
+#define DLOG_MAX_ARGS                       4U
+#define DLOG_RECORD_COUNT                   64U             /* Power of 2 */
+
+/* The argument count is kept in the top bits of the format string address */
+#define DLOG_ID_ARGC_SHIFT                  28U
+#define DLOG_ID_ADDRESS_MASK                0x0FFFFFFFU
+
+/* Public Types ---------------------------------------------------------------------*/
+typedef struct {
+	uint32_t timestamp_us;                  /* timebase_us() */
+	uint32_t id;                            /* Format string address and argument count */
+	uint32_t args[DLOG_MAX_ARGS];
+} dlog_record_t;
+
+typedef struct {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t record_count;
+	uint32_t head;                          /* Records written since the ring was created */
+	uint32_t tail;                          /* First record not drained yet */
+	dlog_record_t records[DLOG_RECORD_COUNT];
+} dlog_ring_t;
+
+_Static_assert((DLOG_RECORD_COUNT & (DLOG_RECORD_COUNT - 1U)) == 0U, "DLOG_RECORD_COUNT must be a power of 2");
+
+extern dlog_ring_t dlog_ring;
+
+/* Public Functions ------------------------------------------------------------------*/
+static inline void dlog_write(uint32_t fmt_address, uint32_t argc, const uint32_t *args)
+{
+#if defined(__arm__)
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+#endif
+
+	dlog_record_t *record = &dlog_ring.records[dlog_ring.head & (DLOG_RECORD_COUNT - 1U)];
+	dlog_ring.head++;
+
+	record->timestamp_us = timebase_us();
+	record->id = (fmt_address & DLOG_ID_ADDRESS_MASK) | (argc << DLOG_ID_ARGC_SHIFT);
+	for (uint32_t i = 0; i < argc; i++) {
+		record->args[i] = args[i];
+	}
+
+#if defined(__arm__)
+	__set_PRIMASK(primask);
+#endif
+}
+
+#define DLOG_NARGS_(_0, _1, _2, _3, _4, n, ...)     n
+#define DLOG_NARGS(...)                             DLOG_NARGS_(0, ##__VA_ARGS__, 4, 3, 2, 1, 0)
+
+/**
+ * @brief Log a message, DLOG("copied %u bytes to 0x%08x", size, address).
+ * @param fmt String literal, printf conversions of 32-bit values
+ */
+#define DLOG(fmt, ...)                                                                          \
+	do {                                                                                        \
+		__attribute__((section(".dlog_fmt"))) static const char dlog_fmt[] = fmt;               \
+		dlog_write((uint32_t)(uintptr_t)dlog_fmt, DLOG_NARGS(__VA_ARGS__),                      \
+				(const uint32_t[DLOG_MAX_ARGS + 1U]){ 0, ##__VA_ARGS__ } + 1);                   \
+	} while (0)
+
+void dlog_init(void);
+void dlog_printf(const char *fmt, ...);
+uint32_t dlog_pending(void);
+uint32_t dlog_first(void);
+bool dlog_read(uint32_t index, dlog_record_t *record);
+void dlog_release(uint32_t index);
@@ -0,0 +1,333 @@
+/**
+ * @file fw_manifest.c
+ * @brief Signed segment manifest: early rejection of corrupt image transfers
+ * @details The manifest is received in pieces over CAN (see can_message_handler.c)
+ *          and validated once complete: format, root of the segment hash list and
+ *          signature. The upgrade slot is then scanned, one segment per call of
+ *          fw_manifest_scan() from a main loop task, to find how many leading segments
+ *          already match and can skip programming.
+ *          Writes into the upgrade slot are checked through a mem write hook.
+ * @date 19/10/2026
+ */
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include <tinycrypt/sha256.h>
+#include <tinycrypt/ecc_dsa.h>
+#include "fw_manifest.h"
+#include "mem.h"
+#include "update_report.h"
+#include "boot_handoff.h"
+#include "profile_zone.h"
+
+/* Private defines ------------------------------------------------------------------*/
+#define FW_MANIFEST_SLOT_SIZE               (MEM_UPGRADE_END_ADDRESS - MEM_UPGRADE_START_ADDRESS)
+
+/* Private types --------------------------------------------------------------------*/
+typedef struct {
+	uint8_t buffer[FW_MANIFEST_MAX_SIZE];
+	uint32_t received;                          /* Contiguous bytes received */
+	uint32_t expected;                          /* Total size, known once the header is in */
+	fw_manifest_status_e status;
+	uint32_t verified_segments;                 /* Leading segments known to match in the slot */
+	uint32_t chunk_size;                        /* btea_chunk_size, the size of the core writes */
+	uint32_t cursor;                            /* Next image offset expected from the writes */
+	struct tc_sha256_state_struct segment_sha;  /* Hash of the segment being written */
+} fw_manifest_state_t;
+
+/* Static Variables -----------------------------------------------------------------*/
+static fw_manifest_state_t manifest;
+static const public_key_t *manifest_public_key;
+static const ed25519_public_key_t *manifest_ed25519_key;
+
+/* Private Functions ----------------------------------------------------------------*/
+static const fw_manifest_header_t *fw_manifest_header(void)
+{
+	return (const fw_manifest_header_t *)manifest.buffer;
+}
+
+static const uint8_t *fw_manifest_segment_hash(uint32_t segment)
+{
+	return &manifest.buffer[sizeof(fw_manifest_header_t) + (segment * FW_MANIFEST_HASH_SIZE)];
+}
+
+static uint32_t fw_manifest_segment_length(uint32_t segment)
+{
+	const fw_manifest_header_t *header = fw_manifest_header();
+	uint32_t start = segment * header->segment_size;
+	uint32_t remaining = header->image_size - start;
+
+	return (remaining < header->segment_size) ? remaining : header->segment_size;
+}
+
+static void fw_manifest_sha256(const void *data, uint32_t size, uint8_t digest[TC_SHA256_DIGEST_SIZE])
+{
+	struct tc_sha256_state_struct sha;
+
+	(void)tc_sha256_init(&sha);
+	(void)tc_sha256_update(&sha, (const uint8_t *)data, size);
+	(void)tc_sha256_final(digest, &sha);
+}
+
+static bool fw_manifest_signature_valid(const uint8_t digest[TC_SHA256_DIGEST_SIZE])
+{
+	const fw_manifest_header_t *header = fw_manifest_header();
+	const uint8_t *signature = fw_manifest_segment_hash(header->segment_count);
+
+	switch (header->sig_alg) {
+		case FW_MANIFEST_SIG_ECDSA_P256:
+			return uECC_verify(manifest_public_key->key, digest, TC_SHA256_DIGEST_SIZE, signature,
+					uECC_secp256r1()) == TC_CRYPTO_SUCCESS;
+
+		case FW_MANIFEST_SIG_ED25519:
+			return (manifest_ed25519_key != NULL) &&
+					(ed25519_verify(manifest_ed25519_key, digest, TC_SHA256_DIGEST_SIZE, signature) == ED25519_VERIFY_OK);
+
+		default:
+			return false;
+	}
+}
+
+/* The leading segments found so far are kept, the slot is only checked from now on */
+static void fw_manifest_scan_end(void)
+{
+	manifest.status = FW_MANIFEST_STATUS_VALID;
+	manifest.cursor = 0;
+	(void)tc_sha256_init(&manifest.segment_sha);
+}
+
+static fw_manifest_status_e fw_manifest_validate(void)
+{
+	const fw_manifest_header_t *header = fw_manifest_header();
+	uint8_t digest[TC_SHA256_DIGEST_SIZE];
+
+	if ((header->sig_alg != FW_MANIFEST_SIG_ECDSA_P256 && header->sig_alg != FW_MANIFEST_SIG_ED25519) ||
+			header->segment_size == 0 || (header->segment_size % MEM_FLASH_QUAD_WORD_SIZE) != 0 ||
+			(manifest.chunk_size % header->segment_size) != 0 ||
+			header->image_size == 0 || header->image_size > FW_MANIFEST_SLOT_SIZE ||
+			header->segment_count != ((header->image_size + header->segment_size - 1U) / header->segment_size)) {
+		return FW_MANIFEST_STATUS_INVALID_FORMAT;
+	}
+
+	/* The root binds the hash list to the signed header */
+	fw_manifest_sha256(fw_manifest_segment_hash(0), header->segment_count * FW_MANIFEST_HASH_SIZE, digest);
+	if (memcmp(digest, header->root, sizeof(digest)) != 0) {
+		return FW_MANIFEST_STATUS_INVALID_FORMAT;
+	}
+
+	fw_manifest_sha256(header, sizeof(fw_manifest_header_t), digest);
+	update_report_stage_begin(UPDATE_REPORT_STAGE_VERIFY);
+	PROFILE_ZONE_BEGIN(PROFILE_ZONE_MANIFEST_SIGNATURE);
+	bool signature_valid = fw_manifest_signature_valid(digest);
+	PROFILE_ZONE_END(PROFILE_ZONE_MANIFEST_SIGNATURE);
+	update_report_stage_end();
+
+	if (!signature_valid) {
+		return FW_MANIFEST_STATUS_INVALID_SIGNATURE;
+	}
+
+	manifest.verified_segments = 0;
+
+	return FW_MANIFEST_STATUS_SCANNING;
+}
+
+static int fw_manifest_reject(uint32_t segment)
+{
+	manifest.status = FW_MANIFEST_STATUS_SEGMENT_REJECTED;
+	manifest.cursor = segment * fw_manifest_header()->segment_size;
+	(void)tc_sha256_init(&manifest.segment_sha);
+	boot_handoff_update_failed();
+
+	return MEM_STATUS_REJECTED;
+}
+
+/* Check the data written into the upgrade slot against the segment hashes */
+static int fw_manifest_write_hook(uint32_t address, const void *data, uint32_t size)
+{
+	const fw_manifest_header_t *header = fw_manifest_header();
+	const uint8_t *bytes = (const uint8_t *)data;
+	uint8_t digest[TC_SHA256_DIGEST_SIZE];
+
+	if ((manifest.status != FW_MANIFEST_STATUS_VALID && manifest.status != FW_MANIFEST_STATUS_SEGMENT_REJECTED &&
+			manifest.status != FW_MANIFEST_STATUS_SCANNING) || address < MEM_UPGRADE_START_ADDRESS || address >= MEM_UPGRADE_END_ADDRESS) {
+		return MEM_WRITE_HOOK_PROCEED;
+	}
+
+	/* The transfer did not wait for the scan */
+	if (manifest.status == FW_MANIFEST_STATUS_SCANNING) {
+		fw_manifest_scan_end();
+	}
+
+	uint32_t offset = address - MEM_UPGRADE_START_ADDRESS;
+
+	/* Padding after the image is not covered by the manifest */
+	if (offset >= header->image_size) {
+		return MEM_WRITE_HOOK_PROCEED;
+	}
+
+	/* A transfer may (re)start at any segment boundary up to the first unverified segment */
+	if (offset != manifest.cursor) {
+		if ((offset % header->segment_size) != 0 || (offset / header->segment_size) > manifest.verified_segments) {
+			return fw_manifest_reject(manifest.cursor / header->segment_size);
+		}
+		manifest.cursor = offset;
+		(void)tc_sha256_init(&manifest.segment_sha);
+	}
+
+	/* Only whole segments that already match in the slot can skip programming */
+	bool skip = ((offset % header->segment_size) == 0) && (size <= (header->image_size - offset));
+	uint32_t remaining = (size < (header->image_size - offset)) ? size : (header->image_size - offset);
+
+	while (remaining > 0) {
+		uint32_t segment = manifest.cursor / header->segment_size;
+		uint32_t segment_end = (segment * header->segment_size) + fw_manifest_segment_length(segment);
+		uint32_t chunk = segment_end - manifest.cursor;
+
+		if (chunk > remaining) {
+			chunk = remaining;
+		}
+
+		(void)tc_sha256_update(&manifest.segment_sha, bytes, chunk);
+		manifest.cursor += chunk;
+		bytes += chunk;
+		remaining -= chunk;
+
+		if (manifest.cursor != segment_end) {
+			skip = false;
+			continue;
+		}
+
+		(void)tc_sha256_final(digest, &manifest.segment_sha);
+		(void)tc_sha256_init(&manifest.segment_sha);
+
+		if (memcmp(digest, fw_manifest_segment_hash(segment), sizeof(digest)) != 0) {
+			return fw_manifest_reject(segment);
+		}
+
+		manifest.status = FW_MANIFEST_STATUS_VALID;
+
+		if (segment >= manifest.verified_segments) {
+			manifest.verified_segments = segment + 1U;
+			skip = false;
+		}
+	}
+
+	return skip ? MEM_WRITE_HOOK_SKIP : MEM_WRITE_HOOK_PROCEED;
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @brief Set the keys manifests are verified with and start checking upgrade writes.
+ * @param ed25519_key Key for FW_MANIFEST_SIG_ED25519 manifests, NULL refuses them
+ * @param chunk_size  btea_chunk_size of the core: the segment size must divide it, so
+ *                    every write of the core covers whole segments
+ * @note  mem_init() must have been called.
+ */
+void fw_manifest_init(const public_key_t *public_key, const ed25519_public_key_t *ed25519_key, uint32_t chunk_size)
+{
+	memset(&manifest, 0, sizeof(manifest));
+	manifest_public_key = public_key;
+	manifest_ed25519_key = ed25519_key;
+	manifest.chunk_size = chunk_size;
+
+	(void)mem_add_write_hook(fw_manifest_write_hook);
+}
+
+/**
+ * @brief Store a piece of the manifest, validating it once complete.
+ * @param offset Offset of the piece in the manifest, 0 starts a new manifest
+ * @return Status after this piece
+ */
+fw_manifest_status_e fw_manifest_rx(uint16_t offset, const uint8_t *data, uint16_t size)
+{
+	if (offset == 0) {
+		manifest.received = 0;
+		manifest.expected = 0;
+		manifest.verified_segments = 0;
+		manifest.status = FW_MANIFEST_STATUS_RECEIVING;
+	}
+
+	if (manifest.status != FW_MANIFEST_STATUS_RECEIVING) {
+		return manifest.status;
+	}
+
+	if (offset != manifest.received || (manifest.received + size) > sizeof(manifest.buffer)) {
+		manifest.status = FW_MANIFEST_STATUS_INVALID_FORMAT;
+		return manifest.status;
+	}
+
+	memcpy(&manifest.buffer[manifest.received], data, size);
+	manifest.received += size;
+
+	if (manifest.expected == 0 && manifest.received >= sizeof(fw_manifest_header_t)) {
+		const fw_manifest_header_t *header = fw_manifest_header();
+
+		if (header->magic != FW_MANIFEST_MAGIC || header->version != FW_MANIFEST_VERSION ||
+				header->segment_count == 0 || header->segment_count > FW_MANIFEST_MAX_SEGMENTS) {
+			manifest.status = FW_MANIFEST_STATUS_INVALID_FORMAT;
+			return manifest.status;
+		}
+
+		manifest.expected = FW_MANIFEST_SIZE(header->segment_count);
+	}
+
+	if (manifest.expected != 0 && manifest.received >= manifest.expected) {
+		manifest.status = (manifest.received == manifest.expected) ? fw_manifest_validate() : FW_MANIFEST_STATUS_INVALID_FORMAT;
+	}
+
+	return manifest.status;
+}
+
+/**
+ * @brief Check the next segment of the upgrade slot against a manifest just validated.
+ * @details One segment is hashed per call, the scan stops at the first segment that
+ *          does not match. A write into the upgrade slot ends the scan early.
+ * @return true while segments are left to scan
+ */
+bool fw_manifest_scan(void)
+{
+	const fw_manifest_header_t *header = fw_manifest_header();
+	uint32_t segment = manifest.verified_segments;
+	uint8_t digest[TC_SHA256_DIGEST_SIZE];
+
+	if (manifest.status != FW_MANIFEST_STATUS_SCANNING) {
+		return false;
+	}
+
+	if (segment < header->segment_count) {
+		uint32_t address = MEM_UPGRADE_START_ADDRESS + (segment * header->segment_size);
+
+		fw_manifest_sha256((const void *)address, fw_manifest_segment_length(segment), digest);
+		if (memcmp(digest, fw_manifest_segment_hash(segment), sizeof(digest)) == 0) {
+			manifest.verified_segments++;
+			if (manifest.verified_segments < header->segment_count) {
+				return true;
+			}
+		}
+	}
+
+	fw_manifest_scan_end();
+
+	return false;
+}
+
+fw_manifest_status_e fw_manifest_get_status(void)
+{
+	return manifest.status;
+}
+
+uint32_t fw_manifest_get_verified_segments(void)
+{
+	return manifest.verified_segments;
+}
+
+uint32_t fw_manifest_get_segment_count(void)
+{
+	if (manifest.expected == 0) {
+		return 0;
+	}
+
+	return fw_manifest_header()->segment_count;
+}
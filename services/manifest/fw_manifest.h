@@ -0,0 +1,41 @@
+/**
+ * @file fw_manifest.h
+ * @brief Signed segment manifest: early rejection of corrupt image transfers
+ * @details Once a valid manifest has been received, every write into the upgrade slot
+ *          is checked segment by segment and a corrupt segment is rejected as soon as
+ *          it is complete, instead of after the whole transfer. Segments already in
+ *          the slot that match the manifest are not programmed again, so a transfer
+ *          repeated after an interruption only erases and programs the segments that
+ *          were not verified yet. The core still requests the whole image from the
+ *          start: the bus time is the same.
+ *          Without a manifest, writes are not checked (legacy testers).
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "bootloader.h"
+#include "ed25519.h"
+#include "fw_manifest_format.h"
+
+/* Types ------------------------------------------------------------------*/
+typedef enum {
+    FW_MANIFEST_STATUS_NONE = 0,            /* No manifest, writes are not checked */
+    FW_MANIFEST_STATUS_RECEIVING,
+    FW_MANIFEST_STATUS_VALID,
+    FW_MANIFEST_STATUS_INVALID_FORMAT,
+    FW_MANIFEST_STATUS_INVALID_SIGNATURE,
+    FW_MANIFEST_STATUS_SEGMENT_REJECTED,
+    FW_MANIFEST_STATUS_SCANNING,            /* Valid, the slot is checked by fw_manifest_scan() */
+} fw_manifest_status_e;
+
+/* Public Functions ------------------------------------------------------------------*/
+void fw_manifest_init(const public_key_t *public_key, const ed25519_public_key_t *ed25519_key, uint32_t chunk_size);
+fw_manifest_status_e fw_manifest_rx(uint16_t offset, const uint8_t *data, uint16_t size);
+bool fw_manifest_scan(void);
+fw_manifest_status_e fw_manifest_get_status(void);
+uint32_t fw_manifest_get_verified_segments(void);
+uint32_t fw_manifest_get_segment_count(void);
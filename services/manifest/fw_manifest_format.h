@@ -0,0 +1,56 @@
+/**
+ * @file fw_manifest_format.h
+ * @brief Wire format of the signed segment manifest
+ * @details The manifest is sent before the image. It splits the image, as stored in
+ *          the upgrade slot, into fixed-size segments and carries the SHA-256 of each
+ *          one. The header holds the SHA-256 of the concatenated segment hashes (the
+ *          root) and is signed, so the whole hash list is authenticated by a single
+ *          signature check.
+ *
+ *          Layout (all fields little endian):
+ *            fw_manifest_header_t | segment hash[segment_count] | signature
+ *
+ *          The signature covers SHA-256(header), for every algorithm. This file is shared with the host
+ *          tools, it must only depend on the standard headers.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* General defines ------------------------------------------------------------------*/
+#define FW_MANIFEST_MAGIC                   0x31464E4DU     /* "MNF1" */
+#define FW_MANIFEST_VERSION                 1U
+
+#define FW_MANIFEST_HASH_SIZE               32U
+#define FW_MANIFEST_SIGNATURE_SIZE          64U
+#define FW_MANIFEST_MAX_SEGMENTS            64U
+
+/**
+ * @brief Signature algorithms
+ */
+#define FW_MANIFEST_SIG_ECDSA_P256          0U      /* r | s, public_key_t */
+#define FW_MANIFEST_SIG_ED25519             1U      /* R | S, ed25519_public_key_t */
+
+/**
+ * @brief Size of a manifest holding segment_count hashes
+ */
+#define FW_MANIFEST_SIZE(segment_count)     (sizeof(fw_manifest_header_t) + \
+                                             ((segment_count) * FW_MANIFEST_HASH_SIZE) + \
+                                             FW_MANIFEST_SIGNATURE_SIZE)
+
+#define FW_MANIFEST_MAX_SIZE                FW_MANIFEST_SIZE(FW_MANIFEST_MAX_SEGMENTS)
+
+/* Types ------------------------------------------------------------------*/
+typedef struct __attribute__((packed)) {
+    uint32_t magic;                         /* FW_MANIFEST_MAGIC */
+    uint16_t version;                       /* FW_MANIFEST_VERSION */
+    uint16_t sig_alg;                       /* FW_MANIFEST_SIG_* */
+    uint32_t image_size;                    /* Bytes stored in the upgrade slot */
+    uint32_t segment_size;                  /* Bytes per segment, the last one may be shorter */
+    uint32_t segment_count;                 /* Number of segment hashes that follow */
+    uint32_t fw_version;                    /* Informative, not enforced */
+    uint8_t root[FW_MANIFEST_HASH_SIZE];    /* SHA-256 over the segment hash list */
+} fw_manifest_header_t;
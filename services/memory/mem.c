@@ -9,16 +9,233 @@
  */
 
 /* Global Includes ------------------------------------------------------------------*/
+#include <string.h>
 
 /* Private Includes ------------------------------------------------------------------*/
 #include "sf_flash_hal.h"
 #include "nand_flash.h"
 #include "mem.h"
+#include "mem_cache.h"
+#include "crc.h"
+#include "update_report.h"
+#include "boot_handoff.h"
+#include "profile_zone.h"
 
 /* Private defines ------------------------------------------------------------------*/
 
 /* Static Variables -----------------------------------------------------------------*/
 static nand_t nand;
+static mem_digest_t *tracked_digests[MEM_DIGEST_MAX_TRACKED];
+static mem_write_hook_t write_hooks[MEM_WRITE_HOOK_MAX];
+
+/* Private Functions ----------------------------------------------------------------*/
+static mem_digest_t *mem_digest_find(uint32_t address)
+{
+	for (uint32_t i = 0; i < MEM_DIGEST_MAX_TRACKED; i++) {
+		mem_digest_t *digest = tracked_digests[i];
+
+		if (digest != NULL && address >= digest->start_address && address < digest->end_address) {
+			return digest;
+		}
+	}
+
+	return NULL;
+}
+
+static void mem_digest_restart(mem_digest_t *digest)
+{
+	digest->length = 0;
+	digest->crc32 = CRC32_INIT_VALUE;
+	(void)tc_sha256_init(&digest->sha256);
+	digest->valid = true;
+}
+
+static int mem_write_hooks_run(uint32_t address, const void *data, uint32_t size)
+{
+	int verdict = MEM_WRITE_HOOK_PROCEED;
+
+	for (uint32_t i = 0; i < MEM_WRITE_HOOK_MAX && write_hooks[i] != NULL; i++) {
+		int result = write_hooks[i](address, data, size);
+
+		if (result < 0) {
+			return result;
+		}
+		if (result == MEM_WRITE_HOOK_SKIP) {
+			verdict = MEM_WRITE_HOOK_SKIP;
+		}
+	}
+
+	return verdict;
+}
+
+/* Fold freshly programmed data into the digest tracking its region, if any */
+static void mem_digest_fold(uint32_t address, const void *data, uint32_t size)
+{
+	mem_digest_t *digest = mem_digest_find(address);
+
+	if (digest == NULL) {
+		return;
+	}
+
+	if (address == digest->start_address) {
+		mem_digest_restart(digest);
+	}
+
+	if (!digest->valid) {
+		return;
+	}
+
+	if (address != (digest->start_address + digest->length) || (address + size) > digest->end_address) {
+		digest->valid = false;
+		return;
+	}
+
+	update_report_stage_begin(UPDATE_REPORT_STAGE_HASH);
+	PROFILE_ZONE_BEGIN(PROFILE_ZONE_CRC);
+	digest->crc32 = crc32_continue_dma(digest->crc32, data, size);
+	PROFILE_ZONE_END(PROFILE_ZONE_CRC);
+	(void)tc_sha256_update(&digest->sha256, (const uint8_t *)data, size);
+	update_report_stage_end();
+	digest->length += size;
+}
+
+/*
+ * Cheap safeguard instead of a full read back: compare the last programmed
+ * quad-word of every sector touched by the write against its source.
+ */
+static int mem_readback_compare(uint32_t address, const void *data, uint32_t size)
+{
+	const uint8_t *src = (const uint8_t *)data;
+	uint32_t end = address + size;
+	uint32_t sector_end = (address & ~(MEM_FLASH_SECTOR_SIZE - 1U)) + MEM_FLASH_SECTOR_SIZE;
+
+	/* Read back what was programmed, not what the cache still holds */
+	mem_cache_invalidate_range(address, size);
+
+	while (address < end) {
+		uint32_t chunk_end = (sector_end < end) ? sector_end : end;
+		uint32_t check_start = (chunk_end - 1U) & ~(MEM_FLASH_QUAD_WORD_SIZE - 1U);
+
+		if (check_start < address) {
+			check_start = address;
+		}
+
+		if (memcmp((const void *)check_start, &src[check_start - (end - size)], chunk_end - check_start) != 0) {
+			return MEM_STATUS_READBACK_ERROR;
+		}
+
+		address = chunk_end;
+		sector_end += MEM_FLASH_SECTOR_SIZE;
+	}
+
+	return MEM_STATUS_OK;
+}
+
+static int mem_readback_check(uint32_t address, const void *data, uint32_t size)
+{
+	update_report_stage_begin(UPDATE_REPORT_STAGE_VERIFY);
+	int result = mem_readback_compare(address, data, size);
+	update_report_stage_end();
+
+	return result;
+}
+
+/* Erase (when asked) and program through the NAND layer */
+static uint8_t mem_nand_write(uint32_t address, const void *data, uint32_t size, bool erase)
+{
+	update_report_stage_begin(UPDATE_REPORT_STAGE_PROGRAM);
+	uint8_t status = nand_write_erase(&nand, address, data, size, erase);
+	update_report_stage_end();
+
+	return status;
+}
+
+/* Full read back of a copy the digests cannot check */
+static int mem_copy_readback(uint32_t src_address, uint32_t dst_address, uint32_t size)
+{
+	update_report_stage_begin(UPDATE_REPORT_STAGE_VERIFY);
+	int result = (memcmp((const void*)dst_address, (const void*)src_address, size) == 0) ?
+			MEM_STATUS_OK : MEM_STATUS_READBACK_ERROR;
+	update_report_stage_end();
+
+	return result;
+}
+
+static int mem_copy_data(uint32_t src_address, uint32_t dst_address, uint32_t size)
+{
+	int result = mem_write_hooks_run(dst_address, (const void*)src_address, size);
+	if (result < 0) {
+		return result;
+	}
+
+	if (result != MEM_WRITE_HOOK_SKIP) {
+		uint8_t status = mem_nand_write(dst_address,(const void*)src_address,size,true);
+		if (status != NAND_STATUS_SUCCESS) {
+			return status;
+		}
+
+		/* Read back what was programmed, not what the cache still holds */
+		mem_cache_invalidate_range(dst_address, size);
+	}
+
+	/*
+	 * The destination digest is folded from the FLASH read back, not from the
+	 * source: once the whole source stream is copied, comparing both digests
+	 * checks every programmed byte. A copy outside of the digest streams is
+	 * read back in full instead.
+	 */
+	mem_digest_fold(dst_address, (const void*)dst_address, size);
+
+	mem_digest_t *src_digest = mem_digest_find(src_address);
+	mem_digest_t *dst_digest = mem_digest_find(dst_address);
+
+	if (src_digest == NULL || dst_digest == NULL || !src_digest->valid || !dst_digest->valid ||
+			dst_digest->length > src_digest->length) {
+		return mem_copy_readback(src_address, dst_address, size);
+	}
+
+	/* The whole source stream is copied: the update is installed or rejected */
+	if (dst_digest->length == src_digest->length) {
+		if (!mem_digest_equal(src_digest, dst_digest)) {
+			boot_handoff_update_failed();
+			return MEM_STATUS_DIGEST_MISMATCH;
+		}
+		boot_handoff_update_installed();
+	}
+
+	return MEM_STATUS_OK;
+}
+
+static int mem_write_data(uint32_t address, const void *data, uint32_t size)
+{
+	int result = mem_write_hooks_run(address, data, size);
+	if (result < 0) {
+		return result;
+	}
+
+	if (result != MEM_WRITE_HOOK_SKIP) {
+		uint8_t status = mem_nand_write(address,data,size,true);
+
+		if (status != NAND_STATUS_SUCCESS) {
+			return status;
+		}
+
+		/* Also leaves the range out of the cache, see mem_readback_compare() */
+		result = mem_readback_check(address, data, size);
+		if (result != MEM_STATUS_OK) {
+			return result;
+		}
+	}
+
+	/*
+	 * Folded from the FLASH read back, not from the source: the digest checked by
+	 * the signature of the upgrade slot covers the programmed bytes. A skipped
+	 * write is already in FLASH.
+	 */
+	mem_digest_fold(address, (const void*)address, size);
+
+	return MEM_STATUS_OK;
+}
 
 void mem_init( void )
 {
@@ -37,28 +254,146 @@ void mem_init( void )
 int mem_read( uint32_t address, void* data, uint32_t size) {
 
 	if (address >= MEM_FLASH_END_ADDRESS || (address +size)>=MEM_FLASH_END_ADDRESS) {
-        return -1;
+        return MEM_STATUS_OUT_OF_RANGE;
     }
 
     return sf_flash_read(address, data, size, NULL);
 }
 
 int mem_copy(uint32_t src_address, uint32_t dst_address,uint32_t size) {
-	uint8_t status = nand_write_erase(&nand,dst_address,(const void*)src_address,size,true);
-	if (status == NAND_STATUS_SUCCESS) {
-		return 0;
-	} else {
-		return status;
-	}
+	PROFILE_ZONE_BEGIN(PROFILE_ZONE_MEM_COPY);
+	int result = mem_copy_data(src_address, dst_address, size);
+	PROFILE_ZONE_END(PROFILE_ZONE_MEM_COPY);
+
+	return result;
 }
 
 int mem_write(uint32_t address, const void *data,uint32_t size) {
+	PROFILE_ZONE_BEGIN(PROFILE_ZONE_MEM_WRITE);
+	int result = mem_write_data(address, data, size);
+	PROFILE_ZONE_END(PROFILE_ZONE_MEM_WRITE);
+
+	return result;
+}
+
+/**
+ * @brief Program already erased FLASH, nothing else in the sector is touched.
+ */
+int mem_program(uint32_t address, const void *data, uint32_t size) {
+
+	int result = mem_write_hooks_run(address, data, size);
+	if (result < 0) {
+		return result;
+	}
+	if (result == MEM_WRITE_HOOK_SKIP) {
+		return MEM_STATUS_OK;
+	}
 
-	uint8_t status = nand_write_erase(&nand,address,data,size,true);
+	uint8_t status = mem_nand_write(address,data,size,false);
 
-	if (status == NAND_STATUS_SUCCESS) {
-		return 0;
-	} else {
+	if (status != NAND_STATUS_SUCCESS) {
 		return status;
 	}
+
+	return mem_readback_check(address, data, size);
+}
+
+/**
+ * @brief Register a hook run before every write, in registration order.
+ * @return MEM_STATUS_OK, or MEM_STATUS_OUT_OF_RANGE if no hook slot is left.
+ */
+int mem_add_write_hook(mem_write_hook_t hook) {
+	for (uint32_t i = 0; i < MEM_WRITE_HOOK_MAX; i++) {
+		if (write_hooks[i] == NULL || write_hooks[i] == hook) {
+			write_hooks[i] = hook;
+			return MEM_STATUS_OK;
+		}
+	}
+
+	return MEM_STATUS_OUT_OF_RANGE;
+}
+
+/**
+ * @brief Start tracking the data programmed into [start_address, end_address).
+ * @return MEM_STATUS_OK, or MEM_STATUS_OUT_OF_RANGE if no tracking slot is left.
+ */
+int mem_digest_attach(mem_digest_t *digest, uint32_t start_address, uint32_t end_address) {
+	digest->start_address = start_address;
+	digest->end_address = end_address;
+	digest->length = 0;
+	digest->valid = false;
+
+	for (uint32_t i = 0; i < MEM_DIGEST_MAX_TRACKED; i++) {
+		if (tracked_digests[i] == NULL || tracked_digests[i] == digest) {
+			tracked_digests[i] = digest;
+			return MEM_STATUS_OK;
+		}
+	}
+
+	return MEM_STATUS_OUT_OF_RANGE;
+}
+
+void mem_digest_detach(mem_digest_t *digest) {
+	for (uint32_t i = 0; i < MEM_DIGEST_MAX_TRACKED; i++) {
+		if (tracked_digests[i] == digest) {
+			tracked_digests[i] = NULL;
+		}
+	}
+}
+
+/**
+ * @brief Check whether the digest describes exactly [address, address + size).
+ */
+bool mem_digest_covers(const mem_digest_t *digest, uint32_t address, uint32_t size) {
+	return digest->valid && (address == digest->start_address) && (size == digest->length);
+}
+
+/**
+ * @brief Find a tracked digest that describes exactly [address, address + size).
+ * @return The digest, or NULL if none does.
+ */
+const mem_digest_t *mem_digest_lookup(uint32_t address, uint32_t size) {
+	for (uint32_t i = 0; i < MEM_DIGEST_MAX_TRACKED; i++) {
+		if (tracked_digests[i] != NULL && mem_digest_covers(tracked_digests[i], address, size)) {
+			return tracked_digests[i];
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Get the CRC32 and SHA-256 of the data folded so far.
+ * @details The running state is left untouched, the stream can keep growing.
+ * @return MEM_STATUS_OK, or MEM_STATUS_DIGEST_MISMATCH if the digest is not valid.
+ */
+int mem_digest_final(const mem_digest_t *digest, uint32_t *crc32, uint8_t sha256[TC_SHA256_DIGEST_SIZE]) {
+	if (!digest->valid) {
+		return MEM_STATUS_DIGEST_MISMATCH;
+	}
+
+	if (crc32 != NULL) {
+		*crc32 = digest->crc32;
+	}
+
+	if (sha256 != NULL) {
+		struct tc_sha256_state_struct state = digest->sha256;
+		(void)tc_sha256_final(sha256, &state);
+	}
+
+	return MEM_STATUS_OK;
+}
+
+bool mem_digest_equal(const mem_digest_t *a, const mem_digest_t *b) {
+	uint8_t sha_a[TC_SHA256_DIGEST_SIZE];
+	uint8_t sha_b[TC_SHA256_DIGEST_SIZE];
+
+	if (!a->valid || !b->valid || a->length != b->length || a->crc32 != b->crc32) {
+		return false;
+	}
+
+	(void)mem_digest_final(a, NULL, sha_a);
+	(void)mem_digest_final(b, NULL, sha_b);
+
+	return memcmp(sha_a, sha_b, sizeof(sha_a)) == 0;
 }
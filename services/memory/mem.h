@@ -11,6 +11,9 @@
 #pragma once
 
 /* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <tinycrypt/sha256.h>
 
 /* FLASH Memory Map -----------------------------------------------------------*/
 /* Application Information */
@@ -52,8 +55,61 @@
 /* End of FLASH Memory */
 #define MEM_FLASH_END_ADDRESS               0x08100000
 
+/* FLASH Geometry */
+#define MEM_FLASH_SECTOR_SIZE               0x2000U
+#define MEM_FLASH_QUAD_WORD_SIZE            16U
+
+/* Return codes (NAND status codes are passed through as positive values) */
+#define MEM_STATUS_OK                       0
+#define MEM_STATUS_OUT_OF_RANGE             (-1)
+#define MEM_STATUS_READBACK_ERROR           (-2)
+#define MEM_STATUS_DIGEST_MISMATCH          (-3)
+#define MEM_STATUS_REJECTED                 (-4)
+
+/* Write hook verdicts (a negative MEM_STATUS_* rejects the write) */
+#define MEM_WRITE_HOOK_PROCEED              0
+#define MEM_WRITE_HOOK_SKIP                 1
+
+/* Number of write hooks that can be registered */
+#define MEM_WRITE_HOOK_MAX                  4U
+
+/* Number of regions that can be tracked by a running digest at once */
+#define MEM_DIGEST_MAX_TRACKED              2U
+
+/**
+ * @brief Called before any mem_write()/mem_copy()/mem_program() reaches the FLASH.
+ * @return MEM_WRITE_HOOK_PROCEED to program the data, MEM_WRITE_HOOK_SKIP when the
+ *         FLASH already holds it, or a negative MEM_STATUS_* to reject the write.
+ */
+typedef int (*mem_write_hook_t)(uint32_t address, const void *data, uint32_t size);
+
+/**
+ * @brief Running digest of the data programmed into a FLASH region.
+ * @details Once attached, every mem_write()/mem_copy() that starts at
+ *          start_address restarts the digest and every write that continues
+ *          the stream contiguously is folded into it. Any other write into the
+ *          region invalidates it until the stream is restarted.
+ */
+typedef struct {
+	uint32_t start_address;                     /* First address of the tracked region */
+	uint32_t end_address;                       /* End (exclusive) of the tracked region */
+	uint32_t length;                            /* Bytes folded since the stream was restarted */
+	uint32_t crc32;                             /* Running CRC32, same configuration as the CRC peripheral */
+	struct tc_sha256_state_struct sha256;       /* Running SHA-256 state */
+	bool valid;                                 /* False until restarted, or after an out-of-order write */
+} mem_digest_t;
+
 
 void mem_init( void );
 int mem_read( uint32_t address, void* data, uint32_t size);
 int mem_copy(uint32_t src_address, uint32_t dst_address, uint32_t size);
 int mem_write(uint32_t address, const void *data, uint32_t size);
+int mem_program(uint32_t address, const void *data, uint32_t size);
+int mem_add_write_hook(mem_write_hook_t hook);
+
+int mem_digest_attach(mem_digest_t *digest, uint32_t start_address, uint32_t end_address);
+void mem_digest_detach(mem_digest_t *digest);
+bool mem_digest_covers(const mem_digest_t *digest, uint32_t address, uint32_t size);
+const mem_digest_t *mem_digest_lookup(uint32_t address, uint32_t size);
+int mem_digest_final(const mem_digest_t *digest, uint32_t *crc32, uint8_t sha256[TC_SHA256_DIGEST_SIZE]);
+bool mem_digest_equal(const mem_digest_t *a, const mem_digest_t *b);
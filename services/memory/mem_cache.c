@@ -0,0 +1,117 @@
+/**
+ * @file mem_cache.c
+ * @brief Instruction cache and MPU region map for running from FLASH
+ * @date 19/10/2026
+ */
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "mem.h"
+#include "mem_cache.h"
+
+/* Private defines ------------------------------------------------------------------*/
+/* MAIR encodings: the LL attribute nibbles apply to both the inner and outer policy */
+#define MEM_CACHE_MAIR_NORMAL(policy)       (((policy) << 4) | (policy))
+#define MEM_CACHE_ATTR_CACHEABLE            LL_MPU_ATTRIBUTES_NUMBER1
+#define MEM_CACHE_ATTR_NON_CACHEABLE        LL_MPU_ATTRIBUTES_NUMBER2
+
+#define MEM_CACHE_REGION_VECTORS            LL_MPU_REGION_NUMBER0
+#define MEM_CACHE_REGION_PROGRAMMED         LL_MPU_REGION_NUMBER1
+#define MEM_CACHE_REGION_BOOTLOADER         LL_MPU_REGION_NUMBER2
+#define MEM_CACHE_REGION_SHARED_RAM         LL_MPU_REGION_NUMBER3
+
+/* The vector table sector, never programmed by the bootloader */
+#define MEM_CACHE_VECTORS_START_ADDRESS     0x08000000U
+#define MEM_CACHE_VECTORS_END_ADDRESS       MEM_APP_INFO_ADDRESS
+
+/* Linker script symbols */
+extern uint32_t __shared_ram_start;
+extern uint32_t __shared_ram_end;
+
+/* Private Functions ----------------------------------------------------------------*/
+static void mem_cache_wait_ready(void)
+{
+	while ((ICACHE->SR & ICACHE_SR_BUSYF) != 0U) {
+	}
+	ICACHE->FCR = ICACHE_FCR_CBSYENDF;
+}
+
+static bool mem_cache_is_cacheable(uint32_t address, uint32_t size)
+{
+	uint32_t end = address + size;
+
+	return (address < MEM_CACHE_VECTORS_END_ADDRESS && end > MEM_CACHE_VECTORS_START_ADDRESS) ||
+			(address < MEM_BOOTLOADER_END_ADDRESS && end > MEM_BOOTLOADER_START_ADDRESS);
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @brief Program the MPU region map and enable the instruction cache.
+ * @note  Call once the system clock is configured; replaces the map set by MPU_Config().
+ */
+void mem_cache_init(void)
+{
+	LL_MPU_Disable();
+
+	LL_MPU_ConfigAttributes(MEM_CACHE_ATTR_CACHEABLE,
+			MEM_CACHE_MAIR_NORMAL(LL_MPU_WRITE_THROUGH | LL_MPU_NON_TRANSIENT | LL_MPU_R_ALLOCATE));
+	LL_MPU_ConfigAttributes(MEM_CACHE_ATTR_NON_CACHEABLE, MEM_CACHE_MAIR_NORMAL(LL_MPU_NOT_CACHEABLE));
+
+	LL_MPU_ConfigRegion(MEM_CACHE_REGION_VECTORS,
+			LL_MPU_INSTRUCTION_ACCESS_ENABLE | LL_MPU_ACCESS_NOT_SHAREABLE | LL_MPU_REGION_ALL_RO,
+			MEM_CACHE_ATTR_CACHEABLE, MEM_CACHE_VECTORS_START_ADDRESS, MEM_CACHE_VECTORS_END_ADDRESS - 1U);
+	LL_MPU_ConfigRegion(MEM_CACHE_REGION_PROGRAMMED,
+			LL_MPU_INSTRUCTION_ACCESS_DISABLE | LL_MPU_ACCESS_NOT_SHAREABLE | LL_MPU_REGION_ALL_RW,
+			MEM_CACHE_ATTR_NON_CACHEABLE, MEM_APP_INFO_ADDRESS, MEM_BOOTLOADER_START_ADDRESS - 1U);
+	LL_MPU_ConfigRegion(MEM_CACHE_REGION_BOOTLOADER,
+			LL_MPU_INSTRUCTION_ACCESS_ENABLE | LL_MPU_ACCESS_NOT_SHAREABLE | LL_MPU_REGION_ALL_RO,
+			MEM_CACHE_ATTR_CACHEABLE, MEM_BOOTLOADER_START_ADDRESS, MEM_BOOTLOADER_END_ADDRESS - 1U);
+	LL_MPU_ConfigRegion(MEM_CACHE_REGION_SHARED_RAM,
+			LL_MPU_INSTRUCTION_ACCESS_DISABLE | LL_MPU_ACCESS_NOT_SHAREABLE | LL_MPU_REGION_ALL_RW,
+			MEM_CACHE_ATTR_NON_CACHEABLE, (uint32_t)&__shared_ram_start, (uint32_t)&__shared_ram_end - 1U);
+
+	/* Anything outside the regions keeps the default memory map */
+	LL_MPU_Enable(LL_MPU_CTRL_PRIVILEGED_DEFAULT);
+
+	mem_cache_enable(true);
+}
+
+/**
+ * @brief Leave the cache and the MPU as after reset, right before the jump to the application.
+ */
+void mem_cache_deinit(void)
+{
+	mem_cache_enable(false);
+	LL_MPU_Disable();
+}
+
+/**
+ * @brief Switch the instruction cache on or off; the cache is invalidated either way.
+ */
+void mem_cache_enable(bool enable)
+{
+	if (enable) {
+		if ((ICACHE->CR & ICACHE_CR_EN) == 0U) {
+			mem_cache_wait_ready();
+			ICACHE->CR |= ICACHE_CR_EN;
+		}
+	} else if ((ICACHE->CR & ICACHE_CR_EN) != 0U) {
+		/* Disabling starts a full invalidation */
+		ICACHE->CR &= ~ICACHE_CR_EN;
+		mem_cache_wait_ready();
+	}
+}
+
+/**
+ * @brief Drop stale lines after [address, address + size) has been programmed.
+ * @details Only needed for cacheable ranges; the ICACHE can only invalidate as a whole.
+ */
+void mem_cache_invalidate_range(uint32_t address, uint32_t size)
+{
+	if ((ICACHE->CR & ICACHE_CR_EN) == 0U || !mem_cache_is_cacheable(address, size)) {
+		return;
+	}
+
+	ICACHE->CR |= ICACHE_CR_CACHEINV;
+	mem_cache_wait_ready();
+}
@@ -0,0 +1,30 @@
+/**
+ * @file mem_cache.h
+ * @brief Instruction cache and MPU region map for running from FLASH
+ * @details The bootloader runs at 240 MHz from FLASH with 5 wait states, so the
+ *          ICACHE is enabled over a region map where only what is never
+ *          programmed by the bootloader is cacheable:
+ *            - the vector table sector and the bootloader area: cacheable
+ *              (write-through, read-allocate), read-only;
+ *            - everything in between (application, upgrade, configuration and
+ *              reserved areas): non-cacheable, execute-never, as it is erased and
+ *              programmed;
+ *            - the shared RAM handed over to the application: non-cacheable,
+ *              execute-never.
+ *          Programming a cacheable range still invalidates the cache. Before
+ *          jumping to the application the cache and the MPU are switched off, so the
+ *          application starts with both as after reset.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Public Functions ------------------------------------------------------------------*/
+void mem_cache_init(void);
+void mem_cache_deinit(void);
+void mem_cache_enable(bool enable);
+void mem_cache_invalidate_range(uint32_t address, uint32_t size);
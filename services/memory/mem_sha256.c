@@ -0,0 +1,45 @@
+/**
+ * @file mem_sha256.c
+ * @brief SHA-256 of FLASH regions served from the running digests
+ * @details Linked with -Wl,--wrap=tc_sha256_update. When a fresh SHA-256 is asked
+ *          to hash a FLASH region that a running digest (see mem_digest_t)
+ *          describes exactly, the state folded while the data was programmed is
+ *          handed over instead of reading the region again. This is how the image
+ *          digest checked by the bootloader core after the last burst is built
+ *          incrementally during the transfer, leaving only the signature check for
+ *          the completion step. Any other call is hashed by sha256_fast_update(),
+ *          which keeps the tinycrypt state layout.
+ * @date 19/10/2026
+ */
+
+#if defined(__arm__)
+
+/* Private Includes ------------------------------------------------------------------*/
+#include <tinycrypt/constants.h>
+#include "mem.h"
+#include "sha256_fast.h"
+#include "update_report.h"
+
+/* Public Functions -----------------------------------------------------------------*/
+int __wrap_tc_sha256_update(TCSha256State_t s, const uint8_t *data, size_t datalen);
+
+int __wrap_tc_sha256_update(TCSha256State_t s, const uint8_t *data, size_t datalen)
+{
+	/* Only a state that has not hashed anything yet can take over a running digest */
+	if (s != NULL && data != NULL && datalen != 0 && s->bits_hashed == 0 && s->leftover_offset == 0) {
+		const mem_digest_t *digest = mem_digest_lookup((uint32_t)data, (uint32_t)datalen);
+
+		if (digest != NULL && &digest->sha256 != s) {
+			*s = digest->sha256;
+			return TC_CRYPTO_SUCCESS;
+		}
+	}
+
+	update_report_stage_begin(UPDATE_REPORT_STAGE_HASH);
+	int result = sha256_fast_update(s, data, datalen);
+	update_report_stage_end();
+
+	return result;
+}
+
+#endif
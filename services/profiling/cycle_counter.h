@@ -0,0 +1,63 @@
+/**
+ * @file cycle_counter.h
+ * @brief Free-running cycle counter for profiling and benchmarks
+ * @details On target this is the DWT cycle counter (core clock). On the host the
+ *          same API counts nanoseconds of the monotonic clock, so code measured on
+ *          both sides can be shared unchanged.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#if defined(__arm__)
+#include "stm32h5xx.h"
+
+/* Public Functions ------------------------------------------------------------------*/
+/* Starts the counter from 0. A running counter is left alone, also one still running
+ * from before a system reset: measure from a count taken after the call. */
+static inline void cycle_counter_init(void)
+{
+	if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) != 0U) {
+		return;
+	}
+
+	DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static inline uint32_t cycle_counter_get(void)
+{
+	return DWT->CYCCNT;
+}
+
+static inline uint32_t cycle_counter_hz(void)
+{
+	return SystemCoreClock;
+}
+
+#else
+#include <time.h>
+
+/* Public Functions ------------------------------------------------------------------*/
+static inline void cycle_counter_init(void)
+{
+}
+
+static inline uint32_t cycle_counter_get(void)
+{
+	struct timespec now;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint32_t)(((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec);
+}
+
+static inline uint32_t cycle_counter_hz(void)
+{
+	return 1000000000UL;
+}
+
+#endif
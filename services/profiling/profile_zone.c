@@ -0,0 +1,47 @@
+/**
+ * @file profile_zone.c
+ * @brief Cycle counter profiling zones
+ * @details Statistics table of the zones and its read out, see profile_zone.h.
+ * @date 19/10/2026
+ */
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "profile_zone.h"
+
+#if BOOTLOADER_PROFILING
+
+/* Public Variables ------------------------------------------------------------------*/
+profile_zone_stats_t profile_zone_table[PROFILE_ZONE_COUNT];
+
+/* Public Functions -----------------------------------------------------------------*/
+void profile_zone_reset(void)
+{
+	memset(profile_zone_table, 0, sizeof(profile_zone_table));
+}
+
+/**
+ * @brief Get one value of a zone, 0 for a zone that never ran.
+ * @details The total is returned in microseconds so that it fits 32 bits.
+ */
+uint32_t profile_zone_get(profile_zone_e zone, profile_zone_value_e value)
+{
+	const profile_zone_stats_t *stats = &profile_zone_table[zone];
+
+	switch (value) {
+		case PROFILE_ZONE_VALUE_CALLS:
+			return stats->count;
+		case PROFILE_ZONE_VALUE_MIN_CYCLES:
+			return stats->min_cycles;
+		case PROFILE_ZONE_VALUE_MAX_CYCLES:
+			return stats->max_cycles;
+		case PROFILE_ZONE_VALUE_TOTAL_US:
+			return (uint32_t)(stats->total_cycles / (cycle_counter_hz() / 1000000U));
+		default:
+			return 0U;
+	}
+}
+
+#endif
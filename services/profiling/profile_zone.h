@@ -0,0 +1,96 @@
+/**
+ * @file profile_zone.h
+ * @brief Cycle counter profiling zones
+ * @details PROFILE_ZONE_BEGIN() and PROFILE_ZONE_END() bracket a hot path and add
+ *          its cycle count to the statistics of the zone: calls, total, min and
+ *          max. A pair costs two counter reads and a few compares and stores. The
+ *          statistics are kept since reset and returned on the CAN profiling
+ *          request, one frame per value.
+ *
+ *          Zones are inclusive: a zone run inside another one is also counted in
+ *          the outer one. They are only used from thread mode, the table is not
+ *          protected against interrupts.
+ *
+ *          Profiling is built when BOOTLOADER_PROFILING is 1, by default in Debug
+ *          builds. Otherwise the macros expand to nothing and there is no table.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "cycle_counter.h"
+
+/* General defines ------------------------------------------------------------------*/
+#ifndef BOOTLOADER_PROFILING
+#ifdef DEBUG
+#define BOOTLOADER_PROFILING                1
+#else
+#define BOOTLOADER_PROFILING                0
+#endif
+#endif
+
+#define PROFILE_ZONE_VERSION                1U
+
+/* Public Types ---------------------------------------------------------------------*/
+typedef enum {
+	PROFILE_ZONE_CAN_FRAME = 0,             /* can_message_handler_process_frame() */
+	PROFILE_ZONE_BOOTLOADER_RX,             /* bootloader_rx_message_received() */
+	PROFILE_ZONE_DECRYPT,                   /* BTEA decryption of a chunk */
+	PROFILE_ZONE_MEM_WRITE,                 /* mem_write() */
+	PROFILE_ZONE_MEM_COPY,                  /* mem_copy() */
+	PROFILE_ZONE_CRC,                       /* CRC32 of programmed data */
+	PROFILE_ZONE_ECDSA_VERIFY,              /* uECC_verify() */
+	PROFILE_ZONE_MANIFEST_SIGNATURE,        /* Manifest signature, ECDSA or Ed25519 */
+	PROFILE_ZONE_COUNT
+} profile_zone_e;
+
+typedef enum {
+	PROFILE_ZONE_VALUE_CALLS = 0,
+	PROFILE_ZONE_VALUE_MIN_CYCLES,
+	PROFILE_ZONE_VALUE_MAX_CYCLES,
+	PROFILE_ZONE_VALUE_TOTAL_US,            /* Sum of all calls */
+	PROFILE_ZONE_VALUE_COUNT
+} profile_zone_value_e;
+
+typedef struct {
+	uint32_t count;
+	uint32_t min_cycles;
+	uint32_t max_cycles;
+	uint64_t total_cycles;
+} profile_zone_stats_t;
+
+#if BOOTLOADER_PROFILING
+
+/* Public Variables ------------------------------------------------------------------*/
+extern profile_zone_stats_t profile_zone_table[PROFILE_ZONE_COUNT];
+
+/* Public Macros ---------------------------------------------------------------------*/
+#define PROFILE_ZONE_BEGIN(zone)            const uint32_t profile_zone_start_##zone = cycle_counter_get()
+#define PROFILE_ZONE_END(zone)              profile_zone_record((zone), cycle_counter_get() - profile_zone_start_##zone)
+
+/* Public Functions ------------------------------------------------------------------*/
+static inline void profile_zone_record(profile_zone_e zone, uint32_t cycles)
+{
+	profile_zone_stats_t *stats = &profile_zone_table[zone];
+
+	if (stats->count == 0U || cycles < stats->min_cycles) {
+		stats->min_cycles = cycles;
+	}
+	if (cycles > stats->max_cycles) {
+		stats->max_cycles = cycles;
+	}
+	stats->total_cycles += cycles;
+	stats->count++;
+}
+
+void profile_zone_reset(void);
+uint32_t profile_zone_get(profile_zone_e zone, profile_zone_value_e value);
+
+#else
+
+#define PROFILE_ZONE_BEGIN(zone)            do { } while (0)
+#define PROFILE_ZONE_END(zone)              do { } while (0)
+
+#endif
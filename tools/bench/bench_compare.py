@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+"""Summarise benchmark results and compare them with a baseline.
+
+Reads the lines printed by the benchmarks in services/bench (host `bench`
+executable stdout, or the SWO capture of a BOOTLOADER_BENCHMARK target build);
+other lines are ignored. Prints the cost per KB of every kernel and, given a
+baseline run of the same build type, flags kernels that got slower.
+
+    ./build-tools/bench > current.txt
+    python3 tools/bench/bench_compare.py current.txt
+    python3 tools/bench/bench_compare.py current.txt --baseline release-1.4.txt
+
+Exits with status 1 if a check failed or a kernel regressed beyond the
+tolerance, so it can gate a release.
+"""
+
+import argparse
+import sys
+
+
+def parse(path):
+    """Return (clock_hz, {(name, bytes): cycles}, {check: passed})."""
+    clock = None
+    results = {}
+    checks = {}
+    with open(path, encoding='utf-8', errors='replace') as f:
+        for line in f:
+            fields = line.strip().split(',')
+            try:
+                if fields[0] == 'clock' and len(fields) == 2:
+                    clock = int(fields[1])
+                elif fields[0] == 'bench' and len(fields) == 4:
+                    key = (fields[1], int(fields[2]))
+                    # Keep the best of repeated runs concatenated in one file
+                    results[key] = min(int(fields[3]), results.get(key, int(fields[3])))
+                elif fields[0] == 'check' and len(fields) == 3:
+                    checks[fields[1]] = checks.get(fields[1], True) and fields[2] == 'PASS'
+            except ValueError:
+                continue
+    return clock, results, checks
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('results', help='output of a benchmark run')
+    parser.add_argument('--baseline', help='output of a reference run to compare with')
+    parser.add_argument('--tolerance', type=float, default=10.0,
+                        help='allowed slowdown against the baseline, in percent (default 10)')
+    args = parser.parse_args()
+
+    clock, results, checks = parse(args.results)
+    if clock is None or not results:
+        sys.exit('%s: no benchmark results found' % args.results)
+    unit = 'ns' if clock == 1000000000 else 'cycles'
+
+    baseline = {}
+    if args.baseline:
+        base_clock, baseline, _ = parse(args.baseline)
+        if base_clock != clock:
+            print('warning: clock differs from the baseline (%s vs %s Hz)' % (clock, base_clock))
+
+    failed = [name for name, passed in sorted(checks.items()) if not passed]
+    regressed = []
+
+    print('%-28s %8s %12s %14s %9s' % ('kernel', 'bytes', unit, unit + '/KB', 'vs base'))
+    for (name, size), cycles in sorted(results.items()):
+        per_kb = cycles * 1024.0 / size if size else float(cycles)
+        change = ''
+        if (name, size) in baseline and baseline[(name, size)] > 0:
+            delta = 100.0 * (cycles - baseline[(name, size)]) / baseline[(name, size)]
+            change = '%+.1f%%' % delta
+            if delta > args.tolerance:
+                regressed.append('%s (%d bytes) %s' % (name, size, change))
+        print('%-28s %8d %12d %14.1f %9s' % (name, size, cycles, per_kb, change))
+
+    for name in failed:
+        print('FAIL: check %s' % name)
+    for entry in regressed:
+        print('REGRESSION: %s' % entry)
+
+    return 1 if failed or regressed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
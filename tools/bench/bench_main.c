@@ -0,0 +1,30 @@
+/**
+ * @file bench_main.c
+ * @brief Host runner for the benchmarks in services/bench
+ * @details Same kernels and checks as on target, timed in nanoseconds. Exits with
+ *          a non-zero status if any check fails.
+ * @date 19/10/2026
+ */
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "bench.h"
+
+/* Public Functions -----------------------------------------------------------------*/
+int main(void)
+{
+	int failures = 0;
+
+	bench_init();
+	failures += bench_btea();
+	failures += bench_ecdsa();
+	failures += bench_ed25519();
+	failures += bench_sha256();
+	failures += bench_image();
+	failures += bench_dlog();
+	failures += bench_profile_zone();
+
+	return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
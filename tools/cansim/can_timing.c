@@ -0,0 +1,228 @@
+/**
+ * @file can_timing.c
+ * @brief Bit-level duration of CAN and CAN FD frames
+ * @date 19/10/2026
+ */
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <string.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "can_timing.h"
+
+/* Private defines ------------------------------------------------------------------*/
+#define CAN_TIMING_MAX_BITS                 (64U + (HOST_CAN_MAX_DATA_LENGTH * 8U))
+#define CAN_TIMING_STUFF_RUN                5U
+#define CAN_TIMING_CRC15_POLYNOMIAL         0x4599U
+
+#define CAN_TIMING_CLASSIC_TAIL_BITS        (1U + 2U + 7U + CAN_TIMING_INTERMISSION_BITS)  /* CRC delimiter, ACK, EOF */
+#define CAN_TIMING_FD_TAIL_BITS             (2U + 7U + CAN_TIMING_INTERMISSION_BITS)       /* ACK, EOF */
+#define CAN_TIMING_FD_STUFF_COUNT_BITS      4U
+#define CAN_TIMING_FD_CRC17_BITS            17U
+#define CAN_TIMING_FD_CRC21_BITS            21U
+#define CAN_TIMING_FD_CRC17_MAX_LENGTH      16U
+
+/* Private types --------------------------------------------------------------------*/
+typedef struct {
+	uint8_t bits[CAN_TIMING_MAX_BITS];
+	uint32_t count;
+	uint32_t switch_bit;                    /* First bit of the data phase, CAN_TIMING_MAX_BITS if none */
+} can_timing_bits_t;
+
+/* Static Variables -----------------------------------------------------------------*/
+static const uint8_t can_timing_fd_lengths[] = { 12U, 16U, 20U, 24U, 32U, 48U, 64U };
+
+/* Private Functions ----------------------------------------------------------------*/
+static void can_timing_put(can_timing_bits_t *bits, uint32_t value, uint32_t width)
+{
+	while (width-- > 0U) {
+		bits->bits[bits->count++] = (uint8_t)((value >> width) & 1U);
+	}
+}
+
+static uint8_t can_timing_dlc(uint8_t length)
+{
+	if (length <= 8U) {
+		return length;
+	}
+
+	for (uint8_t i = 0; i < sizeof(can_timing_fd_lengths); i++) {
+		if (length <= can_timing_fd_lengths[i]) {
+			return (uint8_t)(9U + i);
+		}
+	}
+
+	return 15U;
+}
+
+static uint16_t can_timing_crc15(const can_timing_bits_t *bits)
+{
+	uint16_t crc = 0;
+
+	for (uint32_t i = 0; i < bits->count; i++) {
+		bool feedback = (((crc >> 14) & 1U) ^ bits->bits[i]) != 0U;
+
+		crc = (uint16_t)((crc << 1) & 0x7FFFU);
+		if (feedback) {
+			crc ^= CAN_TIMING_CRC15_POLYNOMIAL;
+		}
+	}
+
+	return crc;
+}
+
+/* SOF to the end of the data field, unstuffed */
+static void can_timing_layout(const host_can_frame_t *frame, bool fd, bool bit_rate_switch, can_timing_bits_t *bits)
+{
+	uint8_t length = fd ? can_timing_fd_length(frame->length) : frame->length;
+
+	bits->count = 0;
+	can_timing_put(bits, 0U, 1U);                                    /* SOF */
+
+	if (frame->extended) {
+		can_timing_put(bits, frame->identifier >> 18, 11U);
+		can_timing_put(bits, 1U, 1U);                                /* SRR */
+		can_timing_put(bits, 1U, 1U);                                /* IDE */
+		can_timing_put(bits, frame->identifier & 0x3FFFFU, 18U);
+	} else {
+		can_timing_put(bits, frame->identifier & 0x7FFU, 11U);
+	}
+
+	if (fd) {
+		if (!frame->extended) {
+			can_timing_put(bits, 0U, 1U);                            /* RRS */
+			can_timing_put(bits, 0U, 1U);                            /* IDE */
+		} else {
+			can_timing_put(bits, 0U, 1U);                            /* RRS */
+		}
+		can_timing_put(bits, 1U, 1U);                                /* FDF */
+		can_timing_put(bits, 0U, 1U);                                /* res */
+		can_timing_put(bits, bit_rate_switch ? 1U : 0U, 1U);         /* BRS */
+		bits->switch_bit = bits->count;
+		can_timing_put(bits, 0U, 1U);                                /* ESI */
+	} else {
+		can_timing_put(bits, 0U, 1U);                                /* RTR */
+		can_timing_put(bits, 0U, 1U);                                /* IDE, or r1 */
+		can_timing_put(bits, 0U, 1U);                                /* r0 */
+	}
+
+	can_timing_put(bits, can_timing_dlc(length), 4U);
+	for (uint32_t i = 0; i < length; i++) {
+		can_timing_put(bits, (i < frame->length) ? frame->data[i] : 0U, 8U);
+	}
+
+	if (!fd || !bit_rate_switch) {
+		bits->switch_bit = CAN_TIMING_MAX_BITS;
+	}
+}
+
+/* Dynamic stuff bits, split before and after the bit rate switch */
+static void can_timing_stuff(const can_timing_bits_t *bits, uint32_t *before, uint32_t *after)
+{
+	uint32_t run = 0;
+	uint8_t last = 2U;
+
+	*before = 0;
+	*after = 0;
+
+	for (uint32_t i = 0; i < bits->count; i++) {
+		if (bits->bits[i] == last) {
+			run++;
+		} else {
+			last = bits->bits[i];
+			run = 1;
+		}
+
+		/* The stuff bit is the complement and starts the next run */
+		if (run == CAN_TIMING_STUFF_RUN) {
+			if (i >= bits->switch_bit) {
+				(*after)++;
+			} else {
+				(*before)++;
+			}
+			last ^= 1U;
+			run = 1;
+		}
+	}
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @brief Length of an FD frame once padded to a valid DLC.
+ */
+uint8_t can_timing_fd_length(uint8_t length)
+{
+	if (length <= 8U) {
+		return length;
+	}
+
+	for (uint8_t i = 0; i < sizeof(can_timing_fd_lengths); i++) {
+		if (length <= can_timing_fd_lengths[i]) {
+			return can_timing_fd_lengths[i];
+		}
+	}
+
+	return HOST_CAN_MAX_DATA_LENGTH;
+}
+
+void can_timing_frame(const can_timing_t *timing, const host_can_frame_t *frame, can_timing_frame_t *result)
+{
+	can_timing_bits_t bits;
+	uint32_t stuff_before;
+	uint32_t stuff_after;
+	bool bit_rate_switch = frame->fd && timing->data_bps > timing->nominal_bps;
+
+	memset(result, 0, sizeof(*result));
+	can_timing_layout(frame, frame->fd, bit_rate_switch, &bits);
+
+	if (!frame->fd) {
+		can_timing_put(&bits, can_timing_crc15(&bits), 15U);
+		can_timing_stuff(&bits, &stuff_before, &stuff_after);
+
+		result->nominal_bits = bits.count + stuff_before + CAN_TIMING_CLASSIC_TAIL_BITS;
+		result->stuff_bits = stuff_before;
+	} else {
+		uint32_t crc_bits = (can_timing_fd_length(frame->length) <= CAN_TIMING_FD_CRC17_MAX_LENGTH) ?
+				CAN_TIMING_FD_CRC17_BITS : CAN_TIMING_FD_CRC21_BITS;
+		uint32_t field_bits = CAN_TIMING_FD_STUFF_COUNT_BITS + crc_bits;
+		/* One fixed stuff bit before the stuff count, then one every 4 bits */
+		uint32_t fixed_stuff_bits = 1U + ((field_bits - 1U) / 4U);
+		/* Stuff count and CRC with their fixed stuff bits, CRC delimiter */
+		uint32_t tail_bits = field_bits + fixed_stuff_bits + 1U;
+
+		can_timing_stuff(&bits, &stuff_before, &stuff_after);
+		result->stuff_bits = stuff_before + stuff_after + fixed_stuff_bits;
+
+		if (bit_rate_switch) {
+			result->nominal_bits = bits.switch_bit + stuff_before + CAN_TIMING_FD_TAIL_BITS;
+			result->data_bits = (bits.count - bits.switch_bit) + stuff_after + tail_bits;
+		} else {
+			result->nominal_bits = bits.count + stuff_before + stuff_after + tail_bits + CAN_TIMING_FD_TAIL_BITS;
+		}
+	}
+
+	result->duration_ns = ((uint64_t)result->nominal_bits * 1000000000ULL) / timing->nominal_bps;
+	if (result->data_bits != 0U) {
+		result->duration_ns += ((uint64_t)result->data_bits * 1000000000ULL) / timing->data_bps;
+	}
+}
+
+/**
+ * @brief Bus time taken by a frame destroyed at error_bit: the bits up to the error,
+ *        the error flags, the error delimiter and the intermission.
+ * @details The bits before the error are counted at the average bit time of the
+ *          frame, which is exact for frames without a bit rate switch.
+ */
+uint64_t can_timing_error_ns(const can_timing_t *timing, const can_timing_frame_t *frame, uint32_t error_bit)
+{
+	uint32_t frame_bits = frame->nominal_bits + frame->data_bits;
+	uint32_t error_frame_bits = CAN_TIMING_ERROR_FLAG_BITS + CAN_TIMING_ERROR_DELIMITER_BITS + CAN_TIMING_INTERMISSION_BITS;
+
+	if (error_bit > frame_bits) {
+		error_bit = frame_bits;
+	}
+
+	return ((frame->duration_ns * error_bit) / frame_bits) +
+			(((uint64_t)error_frame_bits * 1000000000ULL) / timing->nominal_bps);
+}
@@ -0,0 +1,44 @@
+/**
+ * @file can_timing.h
+ * @brief Bit-level duration of CAN and CAN FD frames
+ * @details The frame is laid out bit by bit as ISO 11898-1 sends it, so that the
+ *          stuff bits are counted on the actual content instead of the worst case:
+ *            - classic frames are stuffed from the SOF to the end of the CRC-15,
+ *              which is computed;
+ *            - FD frames are stuffed dynamically up to the end of the data, then
+ *              the stuff count and the CRC-17/21 get fixed stuff bits, so their
+ *              length does not depend on the CRC value, which is not computed.
+ *          With a bit rate switch the FD data phase, from the ESI bit to the CRC
+ *          delimiter, is sent at the data bit rate. Every frame ends with the ACK,
+ *          the EOF and the 3-bit intermission.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "host_can.h"
+
+/* General defines ------------------------------------------------------------------*/
+#define CAN_TIMING_ERROR_FLAG_BITS          12U     /* Active error flag and the flags it triggers */
+#define CAN_TIMING_ERROR_DELIMITER_BITS     8U
+#define CAN_TIMING_INTERMISSION_BITS        3U
+
+/* Public Types ---------------------------------------------------------------------*/
+typedef struct {
+	uint32_t nominal_bps;
+	uint32_t data_bps;                      /* FD data phase, 0 or nominal_bps for no bit rate switch */
+} can_timing_t;
+
+typedef struct {
+	uint32_t nominal_bits;                  /* Stuff bits and intermission included */
+	uint32_t data_bits;                     /* At the data bit rate */
+	uint32_t stuff_bits;
+	uint64_t duration_ns;
+} can_timing_frame_t;
+
+/* Public Functions ------------------------------------------------------------------*/
+void can_timing_frame(const can_timing_t *timing, const host_can_frame_t *frame, can_timing_frame_t *result);
+uint64_t can_timing_error_ns(const can_timing_t *timing, const can_timing_frame_t *frame, uint32_t error_bit);
+uint8_t can_timing_fd_length(uint8_t length);
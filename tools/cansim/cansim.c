@@ -0,0 +1,386 @@
+/**
+ * @file cansim.c
+ * @brief Discrete-event simulation of a CAN bus
+ * @details The error counters follow the transmitter side of the fault confinement
+ *          rules (+8 per error, -1 per success) for the report only, nodes never go
+ *          bus-off.
+ * @date 19/10/2026
+ */
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "cansim.h"
+
+/* Private defines ------------------------------------------------------------------*/
+#define CANSIM_TX_QUEUE_INITIAL             16U
+#define CANSIM_EVENTS_INITIAL               256U
+#define CANSIM_TEC_ERROR_STEP               8U
+
+/* Private types --------------------------------------------------------------------*/
+typedef enum {
+	CANSIM_EVENT_ARBITRATE = 0,
+	CANSIM_EVENT_FRAME_END,
+	CANSIM_EVENT_WAKE,
+} cansim_event_type_e;
+
+/* Private Functions ----------------------------------------------------------------*/
+static bool cansim_event_before(const cansim_event_t *a, const cansim_event_t *b)
+{
+	return (a->time_ns != b->time_ns) ? (a->time_ns < b->time_ns) : (a->sequence < b->sequence);
+}
+
+static int cansim_schedule(cansim_t *sim, uint64_t time_ns, cansim_event_type_e type, uint32_t node, uint32_t generation)
+{
+	if (sim->event_count == sim->event_capacity) {
+		uint32_t capacity = sim->event_capacity * 2U;
+		cansim_event_t *events = realloc(sim->events, capacity * sizeof(*events));
+
+		if (events == NULL) {
+			return -1;
+		}
+		sim->events = events;
+		sim->event_capacity = capacity;
+	}
+
+	cansim_event_t event = {
+		.time_ns = (time_ns < sim->now_ns) ? sim->now_ns : time_ns,
+		.sequence = sim->event_sequence++,
+		.type = type,
+		.node = node,
+		.generation = generation,
+	};
+	uint32_t index = sim->event_count++;
+
+	while (index > 0U) {
+		uint32_t parent = (index - 1U) / 2U;
+
+		if (!cansim_event_before(&event, &sim->events[parent])) {
+			break;
+		}
+		sim->events[index] = sim->events[parent];
+		index = parent;
+	}
+	sim->events[index] = event;
+
+	return 0;
+}
+
+static cansim_event_t cansim_next_event(cansim_t *sim)
+{
+	cansim_event_t first = sim->events[0];
+	cansim_event_t last = sim->events[--sim->event_count];
+	uint32_t index = 0;
+
+	while (true) {
+		uint32_t child = (index * 2U) + 1U;
+
+		if (child >= sim->event_count) {
+			break;
+		}
+		if ((child + 1U) < sim->event_count && cansim_event_before(&sim->events[child + 1U], &sim->events[child])) {
+			child++;
+		}
+		if (!cansim_event_before(&sim->events[child], &last)) {
+			break;
+		}
+		sim->events[index] = sim->events[child];
+		index = child;
+	}
+	if (sim->event_count > 0U) {
+		sim->events[index] = last;
+	}
+
+	return first;
+}
+
+static uint32_t cansim_node_index(const cansim_t *sim, const cansim_node_t *node)
+{
+	for (uint32_t i = 0; i < sim->node_count; i++) {
+		if (sim->nodes[i] == node) {
+			return i;
+		}
+	}
+
+	return CANSIM_MAX_NODES;
+}
+
+/* Lower wins: the identifier bits in bus order, the IDE bit after the base identifier */
+static uint64_t cansim_priority(const host_can_frame_t *frame)
+{
+	if (frame->extended) {
+		return ((uint64_t)(frame->identifier >> 18) << 19) | (1ULL << 18) | (frame->identifier & 0x3FFFFU);
+	}
+
+	return (uint64_t)(frame->identifier & 0x7FFU) << 19;
+}
+
+static void cansim_arbitrate(cansim_t *sim)
+{
+	cansim_node_t *winner = NULL;
+	uint64_t winner_priority = UINT64_MAX;
+	uint64_t next_ready_ns = UINT64_MAX;
+
+	if (sim->bus_busy) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < sim->node_count; i++) {
+		cansim_node_t *node = sim->nodes[i];
+
+		if (node->tx_count == 0U) {
+			continue;
+		}
+
+		const cansim_tx_t *head = &node->tx_queue[node->tx_head];
+
+		if (head->ready_ns > sim->now_ns) {
+			if (head->ready_ns < next_ready_ns) {
+				next_ready_ns = head->ready_ns;
+			}
+			continue;
+		}
+
+		uint64_t priority = cansim_priority(&head->frame);
+		if (priority < winner_priority) {
+			winner = node;
+			winner_priority = priority;
+		}
+	}
+
+	if (winner == NULL) {
+		if (next_ready_ns != UINT64_MAX) {
+			(void)cansim_schedule(sim, next_ready_ns, CANSIM_EVENT_ARBITRATE, 0U, 0U);
+		}
+		return;
+	}
+
+	can_timing_frame_t timing;
+	uint64_t duration_ns;
+
+	can_timing_frame(&sim->config.timing, &winner->tx_queue[winner->tx_head].frame, &timing);
+	sim->transmit_error = cansim_random(sim) < sim->config.error_rate;
+
+	if (sim->transmit_error) {
+		uint32_t error_bit = (uint32_t)(cansim_random(sim) * (double)(timing.nominal_bits + timing.data_bits));
+
+		duration_ns = can_timing_error_ns(&sim->config.timing, &timing, error_bit);
+		sim->stats.error_frames++;
+	} else {
+		duration_ns = timing.duration_ns;
+		sim->stats.frames++;
+		sim->stats.frame_bits += timing.nominal_bits + timing.data_bits;
+		sim->stats.stuff_bits += timing.stuff_bits;
+	}
+
+	sim->bus_busy = true;
+	sim->transmitter = winner;
+	sim->stats.busy_ns += duration_ns;
+	winner->stats.bus_ns += duration_ns;
+	(void)cansim_schedule(sim, sim->now_ns + duration_ns, CANSIM_EVENT_FRAME_END, 0U, 0U);
+}
+
+static void cansim_frame_end(cansim_t *sim)
+{
+	cansim_node_t *transmitter = sim->transmitter;
+	host_can_frame_t frame;
+
+	sim->bus_busy = false;
+	sim->transmitter = NULL;
+
+	if (sim->transmit_error) {
+		transmitter->tec += CANSIM_TEC_ERROR_STEP;
+		transmitter->stats.errors++;
+		if (transmitter->tec > transmitter->stats.tec_max) {
+			transmitter->stats.tec_max = transmitter->tec;
+		}
+		cansim_arbitrate(sim);
+		return;
+	}
+
+	frame = transmitter->tx_queue[transmitter->tx_head].frame;
+	transmitter->tx_head = (transmitter->tx_head + 1U) % transmitter->tx_capacity;
+	transmitter->tx_count--;
+	if (transmitter->tec > 0U) {
+		transmitter->tec--;
+	}
+	transmitter->stats.frames_sent++;
+	transmitter->stats.bytes_sent += frame.length;
+
+	for (uint32_t i = 0; i < sim->node_count; i++) {
+		cansim_node_t *node = sim->nodes[i];
+
+		if (node == transmitter) {
+			continue;
+		}
+
+		if (sim->config.loss_rate > 0.0 && cansim_random(sim) < sim->config.loss_rate) {
+			node->stats.frames_lost++;
+			sim->stats.frames_lost++;
+			continue;
+		}
+
+		node->stats.frames_received++;
+		node->ops->receive(sim, node, &frame);
+	}
+
+	if (transmitter->ops->transmitted != NULL) {
+		transmitter->ops->transmitted(sim, transmitter, &frame);
+	}
+
+	cansim_arbitrate(sim);
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+int cansim_init(cansim_t *sim, const cansim_config_t *config)
+{
+	memset(sim, 0, sizeof(*sim));
+	sim->config = *config;
+	sim->random = (config->seed != 0U) ? config->seed : 1U;
+	sim->event_capacity = CANSIM_EVENTS_INITIAL;
+	sim->events = malloc(sim->event_capacity * sizeof(*sim->events));
+
+	return (sim->events != NULL) ? 0 : -1;
+}
+
+void cansim_deinit(cansim_t *sim)
+{
+	for (uint32_t i = 0; i < sim->node_count; i++) {
+		free(sim->nodes[i]->tx_queue);
+		sim->nodes[i]->tx_queue = NULL;
+	}
+	free(sim->events);
+	sim->events = NULL;
+}
+
+int cansim_attach(cansim_t *sim, cansim_node_t *node, const char *name, const cansim_node_ops_t *ops, void *context)
+{
+	if (sim->node_count == CANSIM_MAX_NODES) {
+		return -1;
+	}
+
+	memset(node, 0, sizeof(*node));
+	node->name = name;
+	node->ops = ops;
+	node->context = context;
+	node->tx_capacity = CANSIM_TX_QUEUE_INITIAL;
+	node->tx_queue = malloc(node->tx_capacity * sizeof(*node->tx_queue));
+	if (node->tx_queue == NULL) {
+		return -1;
+	}
+
+	sim->nodes[sim->node_count++] = node;
+
+	return 0;
+}
+
+/**
+ * @brief Queue a frame for transmission, it arbitrates from ready_ns on.
+ */
+int cansim_send(cansim_t *sim, cansim_node_t *node, const host_can_frame_t *frame, uint64_t ready_ns)
+{
+	if (node->tx_count == node->tx_capacity) {
+		uint32_t capacity = node->tx_capacity * 2U;
+		cansim_tx_t *queue = malloc(capacity * sizeof(*queue));
+
+		if (queue == NULL) {
+			return -1;
+		}
+		for (uint32_t i = 0; i < node->tx_count; i++) {
+			queue[i] = node->tx_queue[(node->tx_head + i) % node->tx_capacity];
+		}
+		free(node->tx_queue);
+		node->tx_queue = queue;
+		node->tx_capacity = capacity;
+		node->tx_head = 0;
+	}
+
+	/* A FIFO: a frame is not ready before the one ahead of it */
+	if (node->tx_count > 0U) {
+		uint64_t previous_ns = node->tx_queue[(node->tx_head + node->tx_count - 1U) % node->tx_capacity].ready_ns;
+
+		if (ready_ns < previous_ns) {
+			ready_ns = previous_ns;
+		}
+	}
+
+	cansim_tx_t *tx = &node->tx_queue[(node->tx_head + node->tx_count) % node->tx_capacity];
+	tx->frame = *frame;
+	tx->frame.fd = tx->frame.fd || sim->config.fd;
+	tx->ready_ns = ready_ns;
+	node->tx_count++;
+	if (node->tx_count > node->stats.tx_queue_max) {
+		node->stats.tx_queue_max = node->tx_count;
+	}
+
+	return cansim_schedule(sim, ready_ns, CANSIM_EVENT_ARBITRATE, 0U, 0U);
+}
+
+/**
+ * @brief Call the wake handler of the node at time_ns, replaces an earlier request.
+ */
+void cansim_wake(cansim_t *sim, cansim_node_t *node, uint64_t time_ns)
+{
+	node->wake_generation++;
+	node->wake_armed = true;
+	node->wake_ns = (time_ns < sim->now_ns) ? sim->now_ns : time_ns;
+	(void)cansim_schedule(sim, node->wake_ns, CANSIM_EVENT_WAKE, cansim_node_index(sim, node), node->wake_generation);
+}
+
+/**
+ * @brief Run the events until cansim_stop(), the time limit or the last event.
+ */
+void cansim_run(cansim_t *sim)
+{
+	while (!sim->stopped && sim->event_count > 0U) {
+		cansim_event_t event = cansim_next_event(sim);
+
+		if (sim->config.time_limit_ns != 0U && event.time_ns > sim->config.time_limit_ns) {
+			sim->now_ns = sim->config.time_limit_ns;
+			break;
+		}
+		sim->now_ns = event.time_ns;
+
+		switch (event.type) {
+			case CANSIM_EVENT_ARBITRATE:
+				cansim_arbitrate(sim);
+				break;
+
+			case CANSIM_EVENT_FRAME_END:
+				cansim_frame_end(sim);
+				break;
+
+			case CANSIM_EVENT_WAKE: {
+				cansim_node_t *node = sim->nodes[event.node];
+
+				if (node->wake_armed && node->wake_generation == event.generation) {
+					node->wake_armed = false;
+					node->ops->wake(sim, node);
+				}
+				break;
+			}
+
+			default:
+				break;
+		}
+	}
+}
+
+void cansim_stop(cansim_t *sim)
+{
+	sim->stopped = true;
+}
+
+/**
+ * @brief Uniform in [0, 1), xorshift64* seeded from the configuration.
+ */
+double cansim_random(cansim_t *sim)
+{
+	sim->random ^= sim->random >> 12;
+	sim->random ^= sim->random << 25;
+	sim->random ^= sim->random >> 27;
+
+	return (double)((sim->random * 0x2545F4914F6CDD1DULL) >> 11) / 9007199254740992.0;
+}
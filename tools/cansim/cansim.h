@@ -0,0 +1,134 @@
+/**
+ * @file cansim.h
+ * @brief Discrete-event simulation of a CAN bus
+ * @details Time is in nanoseconds from the start of the simulation. Events are run
+ *          in time order, those at the same time in the order they were scheduled,
+ *          so a simulation run twice with the same seed gives the same result.
+ *
+ *          Each node has a transmit FIFO, like the FDCAN in FIFO mode. When the bus
+ *          goes idle the head frames ready on every node arbitrate and the lowest
+ *          identifier wins, a standard identifier beating an extended one with the
+ *          same base. The frame then occupies the bus for its duration from
+ *          can_timing_frame(). It can be destroyed by an error frame, at a random
+ *          bit, with the error rate given: the transmitter then tries again, like
+ *          the automatic retransmission of the FDCAN. A frame sent successfully is
+ *          received by every other node at its end, except the ones that lose it,
+ *          with the loss rate given, as an overrun of their receiver would.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "can_timing.h"
+#include "host_can.h"
+
+/* General defines ------------------------------------------------------------------*/
+#define CANSIM_MAX_NODES                    32U
+#define CANSIM_NS_PER_US                    1000ULL
+
+/* Public Types ---------------------------------------------------------------------*/
+typedef struct cansim cansim_t;
+typedef struct cansim_node cansim_node_t;
+
+typedef struct {
+	/* A frame sent by another node, at sim->now_ns */
+	void (*receive)(cansim_t *sim, cansim_node_t *node, const host_can_frame_t *frame);
+	/* The time given to cansim_wake() is reached */
+	void (*wake)(cansim_t *sim, cansim_node_t *node);
+	/* The head of the transmit FIFO was sent and left it, optional */
+	void (*transmitted)(cansim_t *sim, cansim_node_t *node, const host_can_frame_t *frame);
+} cansim_node_ops_t;
+
+typedef struct {
+	host_can_frame_t frame;
+	uint64_t ready_ns;
+} cansim_tx_t;
+
+typedef struct {
+	uint32_t frames_sent;
+	uint64_t bytes_sent;
+	uint32_t frames_received;
+	uint32_t frames_lost;                   /* Not received, loss rate */
+	uint32_t errors;                        /* Error frames on frames of this node */
+	uint32_t tx_queue_max;
+	uint32_t tec_max;                       /* Highest transmit error counter */
+	uint64_t bus_ns;                        /* Bus time of its frames, error frames included */
+} cansim_node_stats_t;
+
+struct cansim_node {
+	const char *name;
+	const cansim_node_ops_t *ops;
+	void *context;
+
+	cansim_tx_t *tx_queue;                  /* Ring of tx_capacity */
+	uint32_t tx_capacity;
+	uint32_t tx_head;
+	uint32_t tx_count;
+	uint32_t tec;
+
+	uint64_t wake_ns;
+	uint32_t wake_generation;               /* Wake-ups scheduled before the last cansim_wake() are stale */
+	bool wake_armed;
+
+	cansim_node_stats_t stats;
+};
+
+typedef struct {
+	can_timing_t timing;
+	bool fd;                                /* Every frame is sent as an FD frame */
+	double error_rate;                      /* Per frame */
+	double loss_rate;                       /* Per frame and receiver */
+	uint64_t seed;
+	uint64_t time_limit_ns;
+} cansim_config_t;
+
+typedef struct {
+	uint64_t busy_ns;
+	uint32_t frames;
+	uint32_t error_frames;
+	uint32_t frames_lost;
+	uint64_t frame_bits;
+	uint64_t stuff_bits;
+} cansim_bus_stats_t;
+
+typedef struct {
+	uint64_t time_ns;
+	uint64_t sequence;
+	uint32_t type;
+	uint32_t node;
+	uint32_t generation;
+} cansim_event_t;
+
+struct cansim {
+	cansim_config_t config;
+	uint64_t now_ns;
+	bool stopped;
+
+	cansim_node_t *nodes[CANSIM_MAX_NODES];
+	uint32_t node_count;
+
+	bool bus_busy;
+	cansim_node_t *transmitter;             /* Node of the frame on the bus */
+	bool transmit_error;                    /* The frame on the bus is destroyed */
+
+	cansim_event_t *events;                 /* Binary heap */
+	uint32_t event_count;
+	uint32_t event_capacity;
+	uint64_t event_sequence;
+
+	uint64_t random;
+	cansim_bus_stats_t stats;
+};
+
+/* Public Functions ------------------------------------------------------------------*/
+int cansim_init(cansim_t *sim, const cansim_config_t *config);
+void cansim_deinit(cansim_t *sim);
+int cansim_attach(cansim_t *sim, cansim_node_t *node, const char *name, const cansim_node_ops_t *ops, void *context);
+int cansim_send(cansim_t *sim, cansim_node_t *node, const host_can_frame_t *frame, uint64_t ready_ns);
+void cansim_wake(cansim_t *sim, cansim_node_t *node, uint64_t time_ns);
+void cansim_run(cansim_t *sim);
+void cansim_stop(cansim_t *sim);
+double cansim_random(cansim_t *sim);
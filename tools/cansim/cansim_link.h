@@ -0,0 +1,39 @@
+/**
+ * @file cansim_link.h
+ * @brief Link between the bus simulator and a simulated ECU
+ * @details A simulated ECU is a vecu_sim process, which runs on simulated time
+ *          (TIMEBASE_SIMULATED) and reaches the bus through one end of a socket pair,
+ *          opened as the bus "sim:<fd>". The two sides take turns:
+ *            - the simulator sends a FRAME or a WAKE, stamped with the simulated
+ *              time the ECU moves to;
+ *            - the ECU runs, sends a SEND per frame stamped with the time it was
+ *              queued for transmission, then a WAIT with the time it wants to be
+ *              woken at if nothing is received before.
+ *          The ECU only runs between a message of the simulator and its WAIT, so
+ *          the simulator sees every ECU at a known time and stays deterministic.
+ *          Times are the 32-bit microsecond timebase readings of the ECU.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "host_can.h"
+
+/* General defines ------------------------------------------------------------------*/
+#define CANSIM_LINK_BUS_PREFIX              "sim:"
+
+/* Public Types ---------------------------------------------------------------------*/
+typedef enum {
+	CANSIM_LINK_FRAME = 0,                  /* Simulator: a frame received at time_us */
+	CANSIM_LINK_WAKE,                       /* Simulator: time_us is reached */
+	CANSIM_LINK_SEND,                       /* ECU: a frame queued for transmission at time_us */
+	CANSIM_LINK_WAIT,                       /* ECU: idle until time_us */
+} cansim_link_type_e;
+
+typedef struct {
+	uint32_t type;
+	uint32_t time_us;
+	host_can_frame_t frame;
+} cansim_link_message_t;
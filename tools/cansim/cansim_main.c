@@ -0,0 +1,727 @@
+/**
+ * @file cansim_main.c
+ * @brief Simulation of a fleet update on one CAN bus
+ * @details The bus carries:
+ *            - the simulated ECUs, one vecu_sim process each: the bootloader, its
+ *              CAN message handler and the FLASH, on the simulated time. Their FLASH
+ *              files are recreated erased, so they stay in the bootloader;
+ *            - the tester, which updates them with the image given, one after the
+ *              other as the line does or all at once with --parallel, its frames
+ *              chosen by flash_scheduler.h, a frame at a time as a CAN adapter
+ *              does, answering received frames after the latency of the host;
+ *            - periodic frames of other equipment, with --traffic.
+ *          The default bus is the 250 kbit/s classic CAN of fdcan.c.
+ *
+ *            cansim --image update.bin --ecu 4 --ecu 5:inverter --erase-us 2000
+ *
+ *          The report gives the bus utilization, what each node sent and received,
+ *          and per ECU the update time from the start of its turn to the
+ *          FINISH_REPORT, with the image throughput. Every ECU is kept in the
+ *          bootloader from the start, with the PREPARE_REQUEST.
+ *
+ *          --capture writes the frames the tester sends and receives to a trace in
+ *          the format of candump -l, on the simulated time, for a replay by vecu_sim.
+ * @date 19/10/2026
+ */
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <errno.h>
+#include <getopt.h>
+#include <libgen.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "cansim.h"
+#include "cansim_link.h"
+#include "can_log.h"
+#include "flash_scheduler.h"
+#include "flash_session.h"
+#include "can_message_handler.h"
+
+/* Private defines ------------------------------------------------------------------*/
+#define CANSIM_DEFAULT_BITRATE              250000U     /* fdcan.c: 240 MHz / 24 / 40 tq */
+#define CANSIM_DEFAULT_ECU                  4U
+#define CANSIM_DEFAULT_TESTER_LATENCY_US    200U
+#define CANSIM_DEFAULT_TIME_LIMIT_S         3600U
+#define CANSIM_TESTER_POLL_US               10000U
+#define CANSIM_END_GRACE_US                 2000000U    /* For the ECUs to jump after their update */
+#define CANSIM_MAX_ECUS                     16U
+#define CANSIM_MAX_TRAFFIC                  8U
+#define CANSIM_CAPTURE_INTERFACE            "sim"
+
+/* Private types --------------------------------------------------------------------*/
+typedef struct {
+	cansim_node_t node;
+	char name[16];
+	uint8_t ecu_id;
+	const char *board;
+	pid_t pid;
+	int fd;
+	bool exited;
+	uint64_t clock_ns;                      /* Last time of the ECU known */
+} cansim_ecu_t;
+
+typedef struct {
+	cansim_node_t node;
+	flash_session_t sessions[CANSIM_MAX_ECUS];
+	uint32_t session_count;
+	flash_scheduler_t scheduler;
+	uint32_t next;                          /* Session released when sequential */
+	bool parallel;
+	bool busy;                              /* A frame is in the adapter */
+	uint64_t latency_ns;
+	uint64_t done_ns;
+	bool done;
+	FILE *capture;                          /* Trace of the frames of the tester, NULL if none */
+} cansim_tester_t;
+
+typedef struct {
+	cansim_node_t node;
+	char name[24];
+	host_can_frame_t frame;
+	uint64_t period_ns;
+	uint32_t skipped;                       /* Periods where the previous frame was still queued */
+} cansim_traffic_t;
+
+/* Static Variables -----------------------------------------------------------------*/
+static cansim_ecu_t cansim_ecus[CANSIM_MAX_ECUS];
+static uint32_t cansim_ecu_count;
+static cansim_tester_t cansim_tester;
+static cansim_traffic_t cansim_traffic[CANSIM_MAX_TRAFFIC];
+static uint32_t cansim_traffic_count;
+
+/* Private Functions ----------------------------------------------------------------*/
+static uint64_t cansim_us(const cansim_t *sim)
+{
+	return sim->now_ns / CANSIM_NS_PER_US;
+}
+
+static void cansim_check_end(cansim_t *sim)
+{
+	if (!cansim_tester.done) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < cansim_ecu_count; i++) {
+		if (!cansim_ecus[i].exited) {
+			return;
+		}
+	}
+
+	cansim_stop(sim);
+}
+
+/* ECUs ---------------------------------------------------------------------------*/
+/* The 32-bit time of the ECU, at most 35 minutes away from its last known time */
+static uint64_t cansim_ecu_time_ns(const cansim_ecu_t *ecu, uint32_t time_us)
+{
+	uint64_t base_us = ecu->clock_ns / CANSIM_NS_PER_US;
+
+	return (uint64_t)((int64_t)base_us + (int32_t)(time_us - (uint32_t)base_us)) * CANSIM_NS_PER_US;
+}
+
+static void cansim_ecu_exited(cansim_t *sim, cansim_ecu_t *ecu)
+{
+	ecu->exited = true;
+	close(ecu->fd);
+	(void)waitpid(ecu->pid, NULL, 0);
+	cansim_check_end(sim);
+}
+
+/* Take the frames of the ECU until it waits */
+static void cansim_ecu_collect(cansim_t *sim, cansim_ecu_t *ecu)
+{
+	cansim_link_message_t message;
+
+	while (recv(ecu->fd, &message, sizeof(message), 0) == (ssize_t)sizeof(message)) {
+		uint64_t time_ns = cansim_ecu_time_ns(ecu, message.time_us);
+
+		if (time_ns > ecu->clock_ns) {
+			ecu->clock_ns = time_ns;
+		}
+
+		if (message.type == CANSIM_LINK_SEND) {
+			(void)cansim_send(sim, &ecu->node, &message.frame, time_ns);
+		} else if (message.type == CANSIM_LINK_WAIT) {
+			cansim_wake(sim, &ecu->node, time_ns);
+			return;
+		}
+	}
+
+	/* The ECU jumped to the application */
+	cansim_ecu_exited(sim, ecu);
+}
+
+/* An ECU busy past now, programming its FLASH, gets the frame when it is done */
+static void cansim_ecu_run(cansim_t *sim, cansim_ecu_t *ecu, cansim_link_type_e type, const host_can_frame_t *frame)
+{
+	cansim_link_message_t message = { .type = type };
+
+	if (ecu->exited) {
+		return;
+	}
+
+	if (sim->now_ns > ecu->clock_ns) {
+		ecu->clock_ns = sim->now_ns;
+	}
+	message.time_us = (uint32_t)(ecu->clock_ns / CANSIM_NS_PER_US);
+	if (frame != NULL) {
+		message.frame = *frame;
+	}
+
+	if (send(ecu->fd, &message, sizeof(message), MSG_NOSIGNAL) != (ssize_t)sizeof(message)) {
+		cansim_ecu_exited(sim, ecu);
+		return;
+	}
+
+	cansim_ecu_collect(sim, ecu);
+}
+
+static void cansim_ecu_receive(cansim_t *sim, cansim_node_t *node, const host_can_frame_t *frame)
+{
+	cansim_ecu_run(sim, node->context, CANSIM_LINK_FRAME, frame);
+}
+
+static void cansim_ecu_wake(cansim_t *sim, cansim_node_t *node)
+{
+	cansim_ecu_run(sim, node->context, CANSIM_LINK_WAKE, NULL);
+}
+
+static const cansim_node_ops_t cansim_ecu_ops = {
+	.receive = cansim_ecu_receive,
+	.wake = cansim_ecu_wake,
+};
+
+static int cansim_ecu_start(cansim_t *sim, cansim_ecu_t *ecu, const char *vecu, const char *flash_dir,
+		uint32_t erase_us, uint32_t program_us, bool log)
+{
+	int link[2];
+	char flash[PATH_MAX];
+	char bus[32];
+	char ecu_id[8];
+	char erase[16];
+	char program[16];
+
+	snprintf(flash, sizeof(flash), "%s/cansim_ecu%u.bin", flash_dir, ecu->ecu_id);
+	if (unlink(flash) != 0 && errno != ENOENT) {
+		perror(flash);
+		return -1;
+	}
+
+	if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, link) != 0) {
+		perror("socketpair");
+		return -1;
+	}
+
+	snprintf(bus, sizeof(bus), "%s%d", CANSIM_LINK_BUS_PREFIX, link[1]);
+	snprintf(ecu_id, sizeof(ecu_id), "%u", ecu->ecu_id);
+	snprintf(erase, sizeof(erase), "%u", erase_us);
+	snprintf(program, sizeof(program), "%u", program_us);
+
+	fflush(stdout);
+	ecu->pid = fork();
+	if (ecu->pid < 0) {
+		perror("fork");
+		return -1;
+	}
+
+	if (ecu->pid == 0) {
+		close(link[0]);
+		execl(vecu, vecu, "--flash", flash, "--bus", bus, "--board", ecu->board, "--ecu", ecu_id,
+				"--erase-us", erase, "--program-us", program, log ? "--log" : NULL, (char *)NULL);
+		perror(vecu);
+		_exit(EXIT_FAILURE);
+	}
+
+	close(link[1]);
+	ecu->fd = link[0];
+	snprintf(ecu->name, sizeof(ecu->name), "ecu%u", ecu->ecu_id);
+	if (cansim_attach(sim, &ecu->node, ecu->name, &cansim_ecu_ops, ecu) != 0) {
+		return -1;
+	}
+
+	/* Boot up to the first wait of the main loop */
+	cansim_ecu_collect(sim, ecu);
+
+	return ecu->exited ? -1 : 0;
+}
+
+/* Tester -------------------------------------------------------------------------*/
+static void cansim_tester_arm(cansim_t *sim, cansim_tester_t *tester, uint64_t time_ns)
+{
+	if (!tester->node.wake_armed || time_ns < tester->node.wake_ns) {
+		cansim_wake(sim, &tester->node, time_ns);
+	}
+}
+
+/* Pulls the next frame when the adapter is free */
+static void cansim_tester_pump(cansim_t *sim, cansim_tester_t *tester)
+{
+	uint64_t now_us = cansim_us(sim);
+	uint64_t next_us = now_us + CANSIM_TESTER_POLL_US;
+	host_can_frame_t frame;
+
+	if (!tester->parallel) {
+		while (tester->next < tester->session_count && flash_session_finished(&tester->sessions[tester->next])) {
+			tester->next++;
+		}
+		if (tester->next < tester->session_count) {
+			flash_session_release(&tester->sessions[tester->next], now_us);
+		}
+	}
+
+	if (!tester->busy && flash_scheduler_next_frame(&tester->scheduler, now_us, &frame, NULL)) {
+		(void)cansim_send(sim, &tester->node, &frame, sim->now_ns);
+		tester->busy = true;
+	}
+
+	if (flash_scheduler_finished(&tester->scheduler)) {
+		if (!tester->done) {
+			tester->done = true;
+			tester->done_ns = sim->now_ns;
+			cansim_tester_arm(sim, tester, sim->now_ns + (CANSIM_END_GRACE_US * CANSIM_NS_PER_US));
+		} else if (sim->now_ns >= tester->done_ns + (CANSIM_END_GRACE_US * CANSIM_NS_PER_US)) {
+			cansim_stop(sim);
+		}
+		cansim_check_end(sim);
+		return;
+	}
+
+	if (!tester->busy) {
+		uint64_t due_us = flash_scheduler_next_due_us(&tester->scheduler, now_us);
+
+		cansim_tester_arm(sim, tester, ((due_us > now_us && due_us < next_us) ? due_us : next_us) * CANSIM_NS_PER_US);
+	}
+}
+
+static void cansim_tester_receive(cansim_t *sim, cansim_node_t *node, const host_can_frame_t *frame)
+{
+	cansim_tester_t *tester = node->context;
+
+	if (tester->capture != NULL) {
+		(void)can_log_write(tester->capture, cansim_us(sim), CANSIM_CAPTURE_INTERFACE, frame);
+	}
+	flash_scheduler_rx(&tester->scheduler, frame, cansim_us(sim));
+
+	if (!tester->busy) {
+		cansim_tester_arm(sim, tester, sim->now_ns + tester->latency_ns);
+	}
+}
+
+static void cansim_tester_wake(cansim_t *sim, cansim_node_t *node)
+{
+	cansim_tester_pump(sim, node->context);
+}
+
+static void cansim_tester_transmitted(cansim_t *sim, cansim_node_t *node, const host_can_frame_t *frame)
+{
+	cansim_tester_t *tester = node->context;
+
+	if (tester->capture != NULL) {
+		(void)can_log_write(tester->capture, cansim_us(sim), CANSIM_CAPTURE_INTERFACE, frame);
+	}
+	tester->busy = false;
+	cansim_tester_pump(sim, tester);
+}
+
+static const cansim_node_ops_t cansim_tester_ops = {
+	.receive = cansim_tester_receive,
+	.wake = cansim_tester_wake,
+	.transmitted = cansim_tester_transmitted,
+};
+
+/* Other traffic ------------------------------------------------------------------*/
+static void cansim_traffic_receive(cansim_t *sim, cansim_node_t *node, const host_can_frame_t *frame)
+{
+	(void)sim;
+	(void)node;
+	(void)frame;
+}
+
+static void cansim_traffic_wake(cansim_t *sim, cansim_node_t *node)
+{
+	cansim_traffic_t *traffic = node->context;
+
+	if (node->tx_count == 0U) {
+		(void)cansim_send(sim, node, &traffic->frame, sim->now_ns);
+	} else {
+		traffic->skipped++;
+	}
+	cansim_wake(sim, node, sim->now_ns + traffic->period_ns);
+}
+
+static const cansim_node_ops_t cansim_traffic_ops = {
+	.receive = cansim_traffic_receive,
+	.wake = cansim_traffic_wake,
+};
+
+/* <identifier>:<period ms>:<length>, extended above 0x7FF */
+static int cansim_traffic_parse(const char *text, cansim_traffic_t *traffic)
+{
+	char *end;
+	unsigned long identifier = strtoul(text, &end, 0);
+	unsigned long period_ms;
+	unsigned long length;
+
+	if (*end != ':' || identifier > 0x1FFFFFFFUL) {
+		return -1;
+	}
+	period_ms = strtoul(end + 1, &end, 0);
+	if (*end != ':' || period_ms == 0UL) {
+		return -1;
+	}
+	length = strtoul(end + 1, &end, 0);
+	if (*end != '\0' || length > HOST_CAN_MAX_DATA_LENGTH) {
+		return -1;
+	}
+
+	memset(traffic, 0, sizeof(*traffic));
+	traffic->frame.identifier = (uint32_t)identifier;
+	traffic->frame.extended = (identifier > 0x7FFUL);
+	traffic->frame.fd = (length > 8UL);
+	traffic->frame.length = (uint8_t)length;
+	traffic->period_ns = (uint64_t)period_ms * 1000000ULL;
+	snprintf(traffic->name, sizeof(traffic->name), "0x%lx", identifier);
+
+	return 0;
+}
+
+/* Report -------------------------------------------------------------------------*/
+static double cansim_seconds(uint64_t ns)
+{
+	return (double)ns / 1e9;
+}
+
+static void cansim_report(const cansim_t *sim)
+{
+	const cansim_bus_stats_t *bus = &sim->stats;
+	double elapsed_s = cansim_seconds(sim->now_ns);
+
+	printf("\nbus: %u bit/s", sim->config.timing.nominal_bps);
+	if (sim->config.fd) {
+		printf(", FD data %u bit/s", (sim->config.timing.data_bps != 0U) ? sim->config.timing.data_bps : sim->config.timing.nominal_bps);
+	}
+	printf(", %.3f s simulated\n", elapsed_s);
+	printf("  utilization %.1f %%, %u frames, %u error frames, %u frames lost, stuff bits %.1f %% of frame bits\n",
+			(sim->now_ns != 0U) ? (100.0 * (double)bus->busy_ns / (double)sim->now_ns) : 0.0,
+			bus->frames, bus->error_frames, bus->frames_lost,
+			(bus->frame_bits != 0U) ? (100.0 * (double)bus->stuff_bits / (double)bus->frame_bits) : 0.0);
+
+	printf("\n%-10s %10s %10s %9s %10s %7s %7s %7s %7s\n", "node", "frames_tx", "bytes_tx", "bus_%", "frames_rx",
+			"lost", "errors", "tec_max", "txq_max");
+	for (uint32_t i = 0; i < sim->node_count; i++) {
+		const cansim_node_t *node = sim->nodes[i];
+
+		printf("%-10s %10u %10llu %9.1f %10u %7u %7u %7u %7u\n", node->name, node->stats.frames_sent,
+				(unsigned long long)node->stats.bytes_sent,
+				(sim->now_ns != 0U) ? (100.0 * (double)node->stats.bus_ns / (double)sim->now_ns) : 0.0,
+				node->stats.frames_received, node->stats.frames_lost, node->stats.errors, node->stats.tec_max,
+				node->stats.tx_queue_max);
+	}
+
+	uint64_t first_us = UINT64_MAX;
+	uint64_t last_us = 0;
+
+	printf("\n%-5s %-9s %10s %10s %12s %8s %9s %13s %13s %7s\n", "ecu", "state", "ready_s", "update_s", "image_B/s",
+			"bursts", "repeated", "req_avg_us", "req_max_us", "window");
+	for (uint32_t i = 0; i < cansim_tester.session_count; i++) {
+		const flash_session_t *session = &cansim_tester.sessions[i];
+		const flash_session_stats_t *stats = &session->stats;
+		uint64_t end_us = flash_session_finished(session) ? stats->end_us : cansim_us(sim);
+		double update_s = (session->state != FLASH_SESSION_IDLE) ? (double)(end_us - stats->release_us) / 1e6 : 0.0;
+
+		if (session->state != FLASH_SESSION_IDLE) {
+			first_us = (stats->start_us < first_us) ? stats->start_us : first_us;
+			last_us = (end_us > last_us) ? end_us : last_us;
+		}
+
+		printf("%-5u %-9s %10.3f %10.3f %12.0f %8u %9u %13llu %13u %7u\n", session->ecu_id,
+				flash_session_state_name(session->state),
+				(stats->ready_us != 0U) ? (double)(stats->ready_us - stats->start_us) / 1e6 : 0.0, update_s,
+				(session->state == FLASH_SESSION_DONE && update_s > 0.0) ? (double)session->image_size / update_s : 0.0,
+				stats->bursts, stats->repeated_packets,
+				(stats->request_latency_count != 0U) ?
+						(unsigned long long)(stats->request_latency_total_us / stats->request_latency_count) : 0ULL,
+				stats->request_latency_max_us, cansim_tester.scheduler.nodes[i].window);
+	}
+
+	if (first_us != UINT64_MAX) {
+		uint64_t image_bytes = 0;
+
+		for (uint32_t i = 0; i < cansim_tester.session_count; i++) {
+			if (cansim_tester.sessions[i].state == FLASH_SESSION_DONE) {
+				image_bytes += cansim_tester.sessions[i].image_size;
+			}
+		}
+		printf("\nfleet update: %.3f s for %u ECUs, %s scheduling, %.0f image B/s\n", (double)(last_us - first_us) / 1e6,
+				cansim_tester.session_count, flash_scheduler_policy_name(cansim_tester.scheduler.policy),
+				(last_us > first_us) ? ((double)image_bytes * 1e6) / (double)(last_us - first_us) : 0.0);
+	}
+
+	for (uint32_t i = 0; i < cansim_traffic_count; i++) {
+		if (cansim_traffic[i].skipped != 0U) {
+			printf("traffic %s: %u periods skipped, the previous frame was still queued\n", cansim_traffic[i].name,
+					cansim_traffic[i].skipped);
+		}
+	}
+}
+
+static uint8_t *read_file(const char *path, size_t *size)
+{
+	FILE *file = fopen(path, "rb");
+	uint8_t *data = NULL;
+	long length;
+
+	if (file == NULL) {
+		fprintf(stderr, "cannot open %s\n", path);
+		return NULL;
+	}
+
+	if (fseek(file, 0, SEEK_END) == 0 && (length = ftell(file)) >= 0 && fseek(file, 0, SEEK_SET) == 0) {
+		data = malloc((size_t)length + 1U);
+		if (data != NULL && fread(data, 1, (size_t)length, file) != (size_t)length) {
+			free(data);
+			data = NULL;
+		}
+		*size = (size_t)length;
+	}
+
+	fclose(file);
+
+	if (data == NULL) {
+		fprintf(stderr, "cannot read %s\n", path);
+	}
+
+	return data;
+}
+
+static void usage(const char *name)
+{
+	fprintf(stderr,
+			"usage: %s --image <file> [--ecu <code>[:<board>]]... [--parallel [--round-robin]] [--burst <bytes>]\n"
+			"          [--bitrate <bit/s>] [--fd] [--data-bitrate <bit/s>] [--error-rate <p>] [--loss-rate <p>]\n"
+			"          [--traffic <id>:<period ms>:<length>]... [--tester-latency-us <us>] [--erase-us <us>]\n"
+			"          [--program-us <us>] [--seed <n>] [--time-limit <s>] [--vecu <path>] [--flash-dir <dir>] [--log]\n"
+			"          [--capture <file>]\n"
+			"  --image              update file sent to every ECU\n"
+			"  --ecu                ECU to update, board charger by default, repeat for a fleet (default 4)\n"
+			"  --parallel           update the ECUs at the same time, frames interleaved\n"
+			"  --round-robin        interleave a frame of each ECU in turn instead of whole bursts\n"
+			"  --burst              burst size asked in the INFO, default the largest the ECU accepts\n"
+			"  --bitrate            nominal bit rate, default %u\n"
+			"  --fd                 send every frame as CAN FD, with a bit rate switch if --data-bitrate is higher\n"
+			"  --error-rate         probability of an error frame per frame\n"
+			"  --loss-rate          probability for a node to miss a frame\n"
+			"  --traffic            periodic frame of other equipment, extended identifier above 0x7FF\n"
+			"  --tester-latency-us  time for the tester to answer a frame, default %u\n"
+			"  --erase-us           FLASH sector erase time of the ECUs\n"
+			"  --program-us         FLASH quad-word program time of the ECUs\n"
+			"  --seed               seed of the error and loss draws\n"
+			"  --time-limit         simulated seconds before giving up, default %u\n"
+			"  --vecu               vecu_sim program, default next to this one\n"
+			"  --flash-dir          directory of the FLASH files of the ECUs, default .\n"
+			"  --log                print the bootloader core log of the ECUs\n"
+			"  --capture            trace of the frames of the tester, candump -l format\n",
+			name, CANSIM_DEFAULT_BITRATE, CANSIM_DEFAULT_TESTER_LATENCY_US, CANSIM_DEFAULT_TIME_LIMIT_S);
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+int main(int argc, char **argv)
+{
+	static const struct option options[] = {
+		{ "image", required_argument, NULL, 'i' },
+		{ "ecu", required_argument, NULL, 'e' },
+		{ "parallel", no_argument, NULL, 'p' },
+		{ "round-robin", no_argument, NULL, 'R' },
+		{ "burst", required_argument, NULL, 'w' },
+		{ "bitrate", required_argument, NULL, 'b' },
+		{ "fd", no_argument, NULL, 'f' },
+		{ "data-bitrate", required_argument, NULL, 'd' },
+		{ "error-rate", required_argument, NULL, 'r' },
+		{ "loss-rate", required_argument, NULL, 'l' },
+		{ "traffic", required_argument, NULL, 't' },
+		{ "tester-latency-us", required_argument, NULL, 'L' },
+		{ "erase-us", required_argument, NULL, 'E' },
+		{ "program-us", required_argument, NULL, 'P' },
+		{ "seed", required_argument, NULL, 's' },
+		{ "time-limit", required_argument, NULL, 'T' },
+		{ "vecu", required_argument, NULL, 'v' },
+		{ "flash-dir", required_argument, NULL, 'D' },
+		{ "log", no_argument, NULL, 'g' },
+		{ "capture", required_argument, NULL, 'c' },
+		{ NULL, 0, NULL, 0 },
+	};
+	cansim_config_t config = {
+		.timing = { .nominal_bps = CANSIM_DEFAULT_BITRATE },
+		.seed = 1U,
+		.time_limit_ns = (uint64_t)CANSIM_DEFAULT_TIME_LIMIT_S * 1000000000ULL,
+	};
+	const char *image_path = NULL;
+	const char *flash_dir = ".";
+	const char *capture_path = NULL;
+	char vecu[PATH_MAX];
+	uint16_t burst_bytes = 0;
+	uint32_t erase_us = 0;
+	uint32_t program_us = 0;
+	uint32_t tester_latency_us = CANSIM_DEFAULT_TESTER_LATENCY_US;
+	bool log = false;
+	flash_scheduler_policy_e policy = FLASH_SCHEDULER_ADAPTIVE;
+	int option;
+	cansim_t sim;
+
+	snprintf(vecu, sizeof(vecu), "%s/vecu_sim", dirname(strdup(argv[0])));
+
+	while ((option = getopt_long(argc, argv, "", options, NULL)) != -1) {
+		switch (option) {
+			case 'i': image_path = optarg; break;
+			case 'e': {
+				char *end;
+				unsigned long ecu_id = strtoul(optarg, &end, 0);
+
+				if (cansim_ecu_count == CANSIM_MAX_ECUS || ecu_id > 0xFFUL || (*end != '\0' && *end != ':')) {
+					usage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				cansim_ecus[cansim_ecu_count].ecu_id = (uint8_t)ecu_id;
+				cansim_ecus[cansim_ecu_count].board = (*end == ':') ? end + 1 : "charger";
+				cansim_ecu_count++;
+				break;
+			}
+			case 'p': cansim_tester.parallel = true; break;
+			case 'R': policy = FLASH_SCHEDULER_ROUND_ROBIN; break;
+			case 'w': burst_bytes = (uint16_t)strtoul(optarg, NULL, 0); break;
+			case 'b': config.timing.nominal_bps = (uint32_t)strtoul(optarg, NULL, 0); break;
+			case 'f': config.fd = true; break;
+			case 'd': config.timing.data_bps = (uint32_t)strtoul(optarg, NULL, 0); break;
+			case 'r': config.error_rate = strtod(optarg, NULL); break;
+			case 'l': config.loss_rate = strtod(optarg, NULL); break;
+			case 't':
+				if (cansim_traffic_count == CANSIM_MAX_TRAFFIC || cansim_traffic_parse(optarg, &cansim_traffic[cansim_traffic_count]) != 0) {
+					usage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				cansim_traffic_count++;
+				break;
+			case 'L': tester_latency_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+			case 'E': erase_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+			case 'P': program_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+			case 's': config.seed = strtoull(optarg, NULL, 0); break;
+			case 'T': config.time_limit_ns = strtoull(optarg, NULL, 0) * 1000000000ULL; break;
+			case 'v': snprintf(vecu, sizeof(vecu), "%s", optarg); break;
+			case 'D': flash_dir = optarg; break;
+			case 'g': log = true; break;
+			case 'c': capture_path = optarg; break;
+			default:
+				usage(argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+
+	if (image_path == NULL || config.timing.nominal_bps == 0U) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	if (cansim_ecu_count == 0U) {
+		cansim_ecus[0].ecu_id = CANSIM_DEFAULT_ECU;
+		cansim_ecus[0].board = "charger";
+		cansim_ecu_count = 1;
+	}
+
+	size_t image_size;
+	uint8_t *image = read_file(image_path, &image_size);
+	if (image == NULL) {
+		return EXIT_FAILURE;
+	}
+
+	if (capture_path != NULL && (cansim_tester.capture = fopen(capture_path, "w")) == NULL) {
+		perror(capture_path);
+		return EXIT_FAILURE;
+	}
+
+	if (cansim_init(&sim, &config) != 0) {
+		return EXIT_FAILURE;
+	}
+
+	/* The tester first, it wins the arbitration ties */
+	cansim_tester.latency_ns = (uint64_t)tester_latency_us * CANSIM_NS_PER_US;
+	if (cansim_attach(&sim, &cansim_tester.node, "tester", &cansim_tester_ops, &cansim_tester) != 0) {
+		return EXIT_FAILURE;
+	}
+	/* Every ECU is kept in the bootloader from the start, when sequential the
+	   others wait for their turn after their READY_REPORT */
+	for (uint32_t i = 0; i < cansim_ecu_count; i++) {
+		flash_session_init(&cansim_tester.sessions[i], cansim_ecus[i].ecu_id, image, (uint32_t)image_size, burst_bytes);
+		flash_session_start(&cansim_tester.sessions[i], 0U);
+		if (!cansim_tester.parallel && i > 0U) {
+			flash_session_hold(&cansim_tester.sessions[i]);
+		}
+	}
+	cansim_tester.session_count = cansim_ecu_count;
+
+	host_can_frame_t packet = {
+		.identifier = CAN_MSG_RECV_BURST_DATA_ID,
+		.extended = true,
+		.fd = config.fd,
+		.length = CAN_MSG_RECV_DATA_OFFSET + FLASH_SESSION_PACKET_SIZE,
+	};
+	can_timing_frame_t packet_timing;
+
+	can_timing_frame(&config.timing, &packet, &packet_timing);
+	if (flash_scheduler_init(&cansim_tester.scheduler, cansim_tester.sessions, cansim_tester.session_count, policy,
+			(uint32_t)(packet_timing.duration_ns / CANSIM_NS_PER_US)) != 0) {
+		return EXIT_FAILURE;
+	}
+
+	for (uint32_t i = 0; i < cansim_traffic_count; i++) {
+		if (cansim_attach(&sim, &cansim_traffic[i].node, cansim_traffic[i].name, &cansim_traffic_ops, &cansim_traffic[i]) != 0) {
+			return EXIT_FAILURE;
+		}
+		cansim_wake(&sim, &cansim_traffic[i].node, 0U);
+	}
+
+	int status = EXIT_SUCCESS;
+	for (uint32_t i = 0; i < cansim_ecu_count; i++) {
+		if (cansim_ecu_start(&sim, &cansim_ecus[i], vecu, flash_dir, erase_us, program_us, log) != 0) {
+			fprintf(stderr, "ecu %u did not start\n", cansim_ecus[i].ecu_id);
+			status = EXIT_FAILURE;
+			break;
+		}
+	}
+
+	if (status == EXIT_SUCCESS) {
+		cansim_wake(&sim, &cansim_tester.node, 0U);
+		cansim_run(&sim);
+		fflush(stdout);
+		cansim_report(&sim);
+
+		for (uint32_t i = 0; i < cansim_tester.session_count; i++) {
+			if (cansim_tester.sessions[i].state != FLASH_SESSION_DONE) {
+				status = EXIT_FAILURE;
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < cansim_ecu_count; i++) {
+		if (cansim_ecus[i].pid > 0 && !cansim_ecus[i].exited) {
+			kill(cansim_ecus[i].pid, SIGTERM);
+			close(cansim_ecus[i].fd);
+			(void)waitpid(cansim_ecus[i].pid, NULL, 0);
+		}
+	}
+
+	cansim_deinit(&sim);
+	free(image);
+	if (cansim_tester.capture != NULL) {
+		fclose(cansim_tester.capture);
+	}
+
+	return status;
+}
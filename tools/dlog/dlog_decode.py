@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+"""Decode the deferred log of the bootloader (services/log/dlog.h).
+
+The records only hold the address of their format string and raw 32-bit
+arguments; the strings are read from the ELF of the same build: DLOG() formats
+from the .dlog_fmt section, dlog_printf() formats and %s arguments from the
+loaded sections.
+
+Two sources are accepted:
+
+  - a dump of the dlog_ring variable, e.g. from gdb after a reset:
+        dump binary value dlog_ring.bin dlog_ring
+        python3 tools/dlog/dlog_decode.py bootloader.elf --ram dlog_ring.bin
+
+  - a candump -L capture of the drain reply (request 0x1F110, reply 0x1F111):
+        cansend can0 0001F110#04
+        candump -L can0 > drain.log
+        python3 tools/dlog/dlog_decode.py bootloader.elf --candump drain.log
+
+Only the standard library is used.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+DLOG_MAGIC = 0x474F4C44
+DLOG_VERSION = 1
+DLOG_MAX_ARGS = 4
+DLOG_ID_ARGC_SHIFT = 28
+DLOG_ID_ADDRESS_MASK = 0x0FFFFFFF
+RECORD = struct.Struct('<II%dI' % DLOG_MAX_ARGS)
+RING_HEADER = struct.Struct('<IHHII')
+
+CAN_ID_DLOG = 0x1F111
+SEQUENCE_HEADER = 0xFF
+PART_SIZE = 6
+PARTS = RECORD.size // PART_SIZE
+
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+CONVERSION = re.compile(r'%([-+ #0]*)(\d*)(?:\.(\d+))?(hh|h|ll|l|z|j|t)?([diouxXcsp%])')
+
+
+class Elf:
+    """Section contents of a 32-bit little-endian ELF, enough to read strings."""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF' or self.data[4] != 1 or self.data[5] != 1:
+            raise SystemExit('%s: not a 32-bit little-endian ELF' % path)
+        shoff, = struct.unpack_from('<I', self.data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from('<HHH', self.data, 0x2E)
+        headers = [struct.unpack_from('<IIIIIIIIII', self.data, shoff + i * shentsize) for i in range(shnum)]
+        names = headers[shstrndx]
+        self.sections = {}
+        self.loaded = []
+        for name, sh_type, flags, addr, offset, size, *_ in headers:
+            end = self.data.index(b'\0', names[4] + name)
+            section_name = self.data[names[4] + name:end].decode()
+            if sh_type == SHT_NOBITS:
+                continue
+            self.sections[section_name] = (addr, offset, size)
+            if flags & SHF_ALLOC:
+                self.loaded.append((addr, offset, size))
+
+    def string(self, address, fmt_section=False):
+        """The NUL-terminated string at address, or None if it is not in the ELF."""
+        candidates = [self.sections['.dlog_fmt']] if fmt_section and '.dlog_fmt' in self.sections else self.loaded
+        for addr, offset, size in candidates:
+            if addr <= address < addr + size:
+                start = offset + address - addr
+                end = self.data.find(b'\0', start, offset + size)
+                if end < 0:
+                    return None
+                return self.data[start:end].decode('utf-8', errors='replace')
+        return None
+
+
+def to_signed(value):
+    return value - (1 << 32) if value & 0x80000000 else value
+
+
+def format_record(elf, fmt, args):
+    """printf of 32-bit arguments, missing ones shown as ?."""
+    values = iter(args)
+
+    def convert(match):
+        flags, width, precision, _, conv = match.groups()
+        if conv == '%':
+            return '%'
+        value = next(values, None)
+        if value is None:
+            return '?'
+        spec = '%' + flags + width + ('.' + precision if precision else '')
+        if conv in 'di':
+            return (spec + 'd') % to_signed(value)
+        if conv == 'u':
+            return (spec + 'd') % value
+        if conv in 'oxX':
+            return (spec + conv) % value
+        if conv == 'c':
+            return (spec + 'c') % chr(value & 0xFF)
+        if conv == 'p':
+            return '0x%08x' % value
+        text = elf.string(value)
+        return (spec + 's') % (text if text is not None else '<0x%08x>' % value)
+
+    return CONVERSION.sub(convert, fmt)
+
+
+def decode(elf, index, raw):
+    timestamp, ident, *args = RECORD.unpack(raw)
+    argc = ident >> DLOG_ID_ARGC_SHIFT
+    address = ident & DLOG_ID_ADDRESS_MASK
+    fmt = elf.string(address, fmt_section=True)
+    if fmt is None:
+        fmt = elf.string(address)
+    if fmt is None:
+        text = '<unknown format 0x%08x> %s' % (address, ' '.join('0x%08x' % a for a in args[:argc]))
+    else:
+        text = format_record(elf, fmt, args[:argc])
+    return '%8d %12.6f  %s' % (index, timestamp / 1e6, text)
+
+
+def from_ram(elf, path):
+    with open(path, 'rb') as f:
+        data = f.read()
+    magic, version, count, head, tail = RING_HEADER.unpack_from(data, 0)
+    if magic != DLOG_MAGIC or version != DLOG_VERSION:
+        raise SystemExit('%s: no valid ring (magic 0x%08x, version %d)' % (path, magic, version))
+    first = max(head - count, 0)
+    lines = []
+    for index in range(first, head):
+        offset = RING_HEADER.size + (index % count) * RECORD.size
+        lines.append(decode(elf, index, data[offset:offset + RECORD.size]))
+    return lines, head - tail
+
+
+def from_candump(elf, path):
+    """Reassemble the drain frames: a header, then PARTS frames per record."""
+    line_re = re.compile(r'\s([0-9A-Fa-f]{8})#([0-9A-Fa-f]*)')
+    lines = []
+    first = None
+    parts = {}
+    with open(path, encoding='utf-8', errors='replace') as f:
+        for line in f:
+            match = line_re.search(line)
+            if not match or int(match.group(1), 16) != CAN_ID_DLOG:
+                continue
+            data = bytes.fromhex(match.group(2))
+            if len(data) != 8:
+                continue
+            if data[1] == SEQUENCE_HEADER:
+                first, = struct.unpack_from('<I', data, 2)
+                parts = {}
+                continue
+            if first is None:
+                continue
+            low, part = data[1] >> 2, data[1] & 0x3
+            parts[part] = data[2:2 + PART_SIZE]
+            if part == PARTS - 1 and len(parts) == PARTS:
+                # The low 5 bits of the index follow the header's first index
+                index = first + ((low - first) & 0x1F)
+                first = index + 1
+                lines.append(decode(elf, index, b''.join(parts[p] for p in range(PARTS))))
+                parts = {}
+    return lines, None
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('elf', help='ELF of the running bootloader build')
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument('--ram', help='binary dump of dlog_ring')
+    source.add_argument('--candump', help='candump -L log of the drain reply')
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+    if args.ram:
+        lines, pending = from_ram(elf, args.ram)
+    else:
+        lines, pending = from_candump(elf, args.candump)
+
+    print('%8s %12s  %s' % ('record', 'time [s]', 'message'))
+    for line in lines:
+        print(line)
+    if pending is not None:
+        print('%d record(s) not drained over CAN' % pending, file=sys.stderr)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+"""Generate the base point comb table used by services/crypto/ed25519.c, and the
+RFC 8032 known-answer tests used by the benchmark.
+
+The signing code below follows the reference implementation of RFC 8032 and is
+only used to produce the test vectors; test 1 is checked against the values
+printed in the RFC.
+
+    python3 tools/ed25519_tables/gen_ed25519_tables.py
+"""
+
+import hashlib
+import os
+import sys
+
+P = 2 ** 255 - 19
+L = 2 ** 252 + 27742317777372353535851937790883648493
+D = -121665 * pow(121666, -1, P) % P
+SQRT_M1 = pow(2, (P - 1) // 4, P)
+
+COMB_TEETH = 4
+COMB_SPACING = 256 // COMB_TEETH
+
+REPO_ROOT = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..'))
+TABLES_C = os.path.join(REPO_ROOT, 'services', 'crypto', 'ed25519_tables.c')
+VECTOR_H = os.path.join(REPO_ROOT, 'services', 'bench', 'bench_ed25519_vector.h')
+
+# RFC 8032 section 7.1, tests 1 to 3: (secret key, message)
+RFC8032_TESTS = [
+    ('9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60', ''),
+    ('4ccd089b28ff96da9db6c346ec114e0f5b8a319f35aba624da8cf6ed4fb8a6fb', '72'),
+    ('c5aa8df43f9f837bedb7442f31dcb7b166d38535076f094b85ce3a2e0b4458f7', 'af82'),
+]
+RFC8032_TEST1_PUBLIC = 'd75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a'
+RFC8032_TEST1_SIGNATURE = ('e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e06522490155'
+                           '5fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b')
+
+
+def recover_x(y, sign):
+    x2 = (y * y - 1) * pow(D * y * y + 1, -1, P) % P
+    x = pow(x2, (P + 3) // 8, P)
+    if (x * x - x2) % P != 0:
+        x = x * SQRT_M1 % P
+    if (x * x - x2) % P != 0:
+        return None
+    if (x & 1) != sign:
+        x = P - x
+    return x
+
+
+BASE_Y = 4 * pow(5, -1, P) % P
+BASE = (recover_x(BASE_Y, 0), BASE_Y)
+
+
+def add(p1, p2):
+    (x1, y1), (x2, y2) = p1, p2
+    t = D * x1 * x2 * y1 * y2 % P
+    return ((x1 * y2 + x2 * y1) * pow(1 + t, -1, P) % P,
+            (y1 * y2 + x1 * x2) * pow(1 - t, -1, P) % P)
+
+
+def mul(k, point):
+    result = (0, 1)
+    while k:
+        if k & 1:
+            result = add(result, point)
+        point = add(point, point)
+        k >>= 1
+    return result
+
+
+def encode(point):
+    x, y = point
+    return (y | ((x & 1) << 255)).to_bytes(32, 'little')
+
+
+def sha512_int(data):
+    return int.from_bytes(hashlib.sha512(data).digest(), 'little')
+
+
+def sign(secret, message):
+    h = hashlib.sha512(secret).digest()
+    a = int.from_bytes(h[:32], 'little')
+    a &= (1 << 254) - 8
+    a |= 1 << 254
+    public = encode(mul(a, BASE))
+    r = sha512_int(h[32:] + message) % L
+    big_r = encode(mul(r, BASE))
+    s = (r + sha512_int(big_r + public + message) * a) % L
+    return public, big_r + s.to_bytes(32, 'little')
+
+
+def comb_table(point):
+    bases = [mul(1 << (COMB_SPACING * j), point) for j in range(COMB_TEETH)]
+    table = []
+    for i in range(1, 1 << COMB_TEETH):
+        acc = (0, 1)
+        for j in range(COMB_TEETH):
+            if i & (1 << j):
+                acc = add(acc, bases[j])
+        table.append(acc)
+    return table
+
+
+def c_words(value):
+    return '{ ' + ', '.join('0x%08X' % ((value >> (32 * i)) & 0xFFFFFFFF) for i in range(8)) + ' }'
+
+
+def c_bytes(data, indent):
+    if not data:
+        return indent + '0x00,'
+    return '\n'.join(indent + ', '.join('0x%02x' % b for b in data[i:i + 16]) + ','
+                     for i in range(0, len(data), 16))
+
+
+def main():
+    vectors = []
+    for secret_hex, message_hex in RFC8032_TESTS:
+        public, signature = sign(bytes.fromhex(secret_hex), bytes.fromhex(message_hex))
+        vectors.append((public, bytes.fromhex(message_hex), signature))
+
+    if vectors[0][0].hex() != RFC8032_TEST1_PUBLIC or vectors[0][2].hex() != RFC8032_TEST1_SIGNATURE:
+        sys.exit('RFC 8032 test 1 does not match, the generator is broken')
+
+    # Cached form (Y + X, Y - X, Z, 2d * T) with Z = 1, as used by ed25519_point_add()
+    entries = []
+    for x, y in comb_table(BASE):
+        entries.append('    {\n        .y_plus_x = %s,\n        .y_minus_x = %s,\n        .z = %s,\n        .t2d = %s,\n    },'
+                       % (c_words((y + x) % P), c_words((y - x) % P), c_words(1), c_words(2 * D * x * y % P)))
+
+    with open(TABLES_C, 'w', newline='\n') as out:
+        out.write('''/**
+ * @file ed25519_tables.c
+ * @brief Comb table of the Ed25519 base point
+ * @details Generated by tools/ed25519_tables/gen_ed25519_tables.py, do not edit.
+ */
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "ed25519_tables.h"
+
+/* Public Variables -----------------------------------------------------------------*/
+const ed25519_cached_t ed25519_base_table[ED25519_COMB_TABLE_SIZE] = {
+%s
+};
+''' % '\n'.join(entries))
+
+    tests = []
+    for index, (public, message, signature) in enumerate(vectors):
+        tests.append('''    {
+        /* RFC 8032 test %d */
+        .public_key = {
+%s
+        },
+        .message = {
+%s
+        },
+        .message_size = %d,
+        .signature = {
+%s
+        },
+    },''' % (index + 1, c_bytes(public, '            '), c_bytes(message, '            '), len(message),
+             c_bytes(signature, '            ')))
+
+    with open(VECTOR_H, 'w', newline='\n') as out:
+        out.write('''/**
+ * @file bench_ed25519_vector.h
+ * @brief Ed25519 known-answer tests (RFC 8032 section 7.1)
+ * @details Generated by tools/ed25519_tables/gen_ed25519_tables.py, do not edit.
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Types ------------------------------------------------------------------*/
+typedef struct {
+    uint8_t public_key[32];
+    uint8_t message[2];
+    uint32_t message_size;
+    uint8_t signature[64];
+} bench_ed25519_vector_t;
+
+/* Public Variables -----------------------------------------------------------------*/
+static const bench_ed25519_vector_t bench_ed25519_vectors[] = {
+%s
+};
+''' % '\n'.join(tests))
+
+    print('%s, %s' % (os.path.relpath(TABLES_C, REPO_ROOT), os.path.relpath(VECTOR_H, REPO_ROOT)))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,399 @@
+/**
+ * @file flasher_main.c
+ * @brief Update of several ECUs at once on one CAN bus
+ * @details Sends the image given to every ECU listed, each by its ECU code, with
+ *          the sessions of flash_session.h. The frames of the sessions are
+ *          interleaved by flash_scheduler.h: while an ECU writes a burst to its
+ *          FLASH the bus carries the bursts of the others.
+ *
+ *            flasher --bus can0 --image update.bin --ecu 4 --ecu 5 --ecu 6
+ *
+ *          Start the flasher, then power the ECUs on: each one is kept in the
+ *          bootloader by the PREPARE_REQUEST sent during its listen window.
+ *          --sequential updates them one after the other instead, as the line does
+ *          today, for comparison.
+ *
+ *          The bus time of the frames seen, sent and received, is computed with
+ *          can_timing.h at the bit rate given, to report the utilization of the bus
+ *          and its efficiency: the share of the bit rate that carried image bytes.
+ *          The udp bus of host_can.h has no bit rate, the frames sent on it are
+ *          paced at the bit rate given, as the controller of a real bus would.
+ *
+ *          --capture writes the frames sent and received to a trace in the format
+ *          of candump -l, from the start of the flasher, for a replay by vecu_sim.
+ * @date 19/10/2026
+ */
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <errno.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "host_can.h"
+#include "can_log.h"
+#include "can_timing.h"
+#include "flash_scheduler.h"
+#include "flash_session.h"
+#include "can_message_handler.h"
+
+/* Private defines ------------------------------------------------------------------*/
+#define FLASHER_DEFAULT_BITRATE             250000U     /* fdcan.c: 240 MHz / 24 / 40 tq */
+#define FLASHER_POLL_MS                     10
+#define FLASHER_RETRY_MS                    1           /* Transmit queue of the interface full */
+#define FLASHER_PACE_BACKLOG_US             2000U       /* Lateness of the pacing made up for */
+#define FLASHER_NS_PER_US                   1000ULL
+
+/* Private types --------------------------------------------------------------------*/
+typedef struct {
+	host_can_t bus;
+	const char *bus_name;
+	can_timing_t timing;
+	bool pace;                              /* Frames sent at the bit rate, for the udp bus */
+	uint64_t start_ns;
+	uint64_t next_tx_us;                    /* Paced: the bus is free from then on */
+
+	uint32_t frames_sent;
+	uint32_t frames_received;
+	uint64_t bus_ns;                        /* Bus time of the frames sent and received */
+	FILE *capture;                          /* Trace of the frames, NULL if none */
+} flasher_t;
+
+/* Static Variables -----------------------------------------------------------------*/
+static flasher_t flasher;
+static flash_session_t flasher_sessions[FLASH_SCHEDULER_MAX_SESSIONS];
+static uint32_t flasher_session_count;
+static flash_scheduler_t flasher_scheduler;
+
+/* Private Functions ----------------------------------------------------------------*/
+static uint64_t flasher_now_ns(void)
+{
+	struct timespec now;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+static uint64_t flasher_us(void)
+{
+	return (flasher_now_ns() - flasher.start_ns) / FLASHER_NS_PER_US;
+}
+
+static uint64_t flasher_frame_ns(const host_can_frame_t *frame)
+{
+	can_timing_frame_t timing;
+
+	can_timing_frame(&flasher.timing, frame, &timing);
+	return timing.duration_ns;
+}
+
+static int flasher_send(const host_can_frame_t *frame, uint64_t now_us)
+{
+	uint64_t frame_ns = flasher_frame_ns(frame);
+
+	if (host_can_send(&flasher.bus, frame) != 0) {
+		return -1;
+	}
+
+	flasher.frames_sent++;
+	flasher.bus_ns += frame_ns;
+	if (flasher.capture != NULL) {
+		(void)can_log_write(flasher.capture, now_us, flasher.bus_name, frame);
+	}
+	if (flasher.pace) {
+		/* The wake-ups are late by up to a millisecond: the frames then go back to
+		   back, as queued frames would on the bus, unless the bus was idle */
+		if (flasher.next_tx_us + FLASHER_PACE_BACKLOG_US < now_us) {
+			flasher.next_tx_us = now_us;
+		}
+		flasher.next_tx_us += (frame_ns + FLASHER_NS_PER_US - 1U) / FLASHER_NS_PER_US;
+	}
+
+	return 0;
+}
+
+/* Take every frame received within timeout_ms */
+static int flasher_receive(int timeout_ms)
+{
+	host_can_frame_t frame;
+	int result;
+
+	while ((result = host_can_receive(&flasher.bus, &frame, timeout_ms)) == 1) {
+		uint64_t now_us = flasher_us();
+
+		flasher.frames_received++;
+		flasher.bus_ns += flasher_frame_ns(&frame);
+		if (flasher.capture != NULL) {
+			(void)can_log_write(flasher.capture, now_us, flasher.bus_name, &frame);
+		}
+		flash_scheduler_rx(&flasher_scheduler, &frame, now_us);
+		timeout_ms = 0;
+	}
+
+	return result;
+}
+
+/* Release the next session when the previous one is finished */
+static void flasher_sequential(uint64_t now_us)
+{
+	for (uint32_t i = 0; i < flasher_session_count; i++) {
+		if (!flash_session_finished(&flasher_sessions[i])) {
+			flash_session_release(&flasher_sessions[i], now_us);
+			return;
+		}
+	}
+}
+
+static int flasher_run(bool sequential)
+{
+	host_can_frame_t frame;
+	bool pending = false;
+
+	while (!flash_scheduler_finished(&flasher_scheduler)) {
+		uint64_t now_us = flasher_us();
+		int timeout_ms = FLASHER_POLL_MS;
+
+		if (sequential) {
+			flasher_sequential(now_us);
+		}
+
+		if (!flasher.pace || now_us >= flasher.next_tx_us) {
+			if (!pending) {
+				pending = flash_scheduler_next_frame(&flasher_scheduler, now_us, &frame, NULL);
+			}
+			if (pending) {
+				if (flasher_send(&frame, now_us) == 0) {
+					pending = false;
+				} else if (errno != ENOBUFS && errno != EAGAIN) {
+					perror("send");
+					return -1;
+				}
+			}
+		}
+
+		/* Until the next frame can go */
+		if (pending) {
+			timeout_ms = FLASHER_RETRY_MS;
+		} else {
+			uint64_t due_us = flash_scheduler_next_due_us(&flasher_scheduler, now_us);
+
+			if (flasher.pace && due_us < flasher.next_tx_us) {
+				due_us = flasher.next_tx_us;
+			}
+			if (due_us <= now_us) {
+				timeout_ms = 0;
+			} else if (due_us < now_us + ((uint64_t)FLASHER_POLL_MS * 1000U)) {
+				timeout_ms = (int)((due_us - now_us + 999U) / 1000U);
+			}
+		}
+
+		if (flasher_receive(timeout_ms) < 0) {
+			perror("receive");
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static void flasher_report(const char *bus_name)
+{
+	double elapsed_s = (double)flasher_us() / 1e6;
+	uint64_t image_bytes = 0;
+
+	printf("\n%-5s %-9s %10s %12s %8s %9s %13s %13s %7s %10s %10s\n", "ecu", "state", "update_s", "image_B/s",
+			"bursts", "repeated", "req_avg_us", "req_max_us", "window", "preempted", "frames");
+	for (uint32_t i = 0; i < flasher_session_count; i++) {
+		const flash_session_t *session = &flasher_sessions[i];
+		const flash_session_stats_t *stats = &session->stats;
+		const flash_scheduler_node_t *node = &flasher_scheduler.nodes[i];
+		double update_s = (double)(stats->end_us - stats->release_us) / 1e6;
+
+		if (session->state == FLASH_SESSION_DONE) {
+			image_bytes += session->image_size;
+		}
+
+		printf("%-5u %-9s %10.3f %12.0f %8u %9u %13llu %13u %7u %10u %10u\n", session->ecu_id,
+				flash_session_state_name(session->state), update_s,
+				(session->state == FLASH_SESSION_DONE && update_s > 0.0) ? (double)session->image_size / update_s : 0.0,
+				stats->bursts, stats->repeated_packets,
+				(stats->request_latency_count != 0U) ?
+						(unsigned long long)(stats->request_latency_total_us / stats->request_latency_count) : 0ULL,
+				stats->request_latency_max_us, node->window, node->preempted, node->frames);
+		if (session->state == FLASH_SESSION_FAILED && session->error != 0U) {
+			printf("      error code %u\n", session->error);
+		}
+	}
+
+	printf("\nbus %s at %u bit/s, %s scheduling%s, %.3f s\n", bus_name, flasher.timing.nominal_bps,
+			flash_scheduler_policy_name(flasher_scheduler.policy), flasher.pace ? ", paced" : "", elapsed_s);
+	printf("  %u frames sent, %u received, utilization %.1f %%\n", flasher.frames_sent, flasher.frames_received,
+			(elapsed_s > 0.0) ? (100.0 * (double)flasher.bus_ns / 1e9) / elapsed_s : 0.0);
+	printf("  %llu image bytes, %.0f B/s, efficiency %.1f %% of the bit rate, %.1f %% of the bus time used\n",
+			(unsigned long long)image_bytes, (elapsed_s > 0.0) ? (double)image_bytes / elapsed_s : 0.0,
+			(elapsed_s > 0.0) ? (100.0 * (double)image_bytes * 8.0) / (elapsed_s * (double)flasher.timing.nominal_bps) : 0.0,
+			(flasher.bus_ns != 0U) ? (100.0 * (double)image_bytes * 8.0 * 1e9) /
+					((double)flasher.bus_ns * (double)flasher.timing.nominal_bps) : 0.0);
+}
+
+static uint8_t *read_file(const char *path, size_t *size)
+{
+	FILE *file = fopen(path, "rb");
+	uint8_t *data = NULL;
+	long length;
+
+	if (file == NULL) {
+		fprintf(stderr, "cannot open %s\n", path);
+		return NULL;
+	}
+
+	if (fseek(file, 0, SEEK_END) == 0 && (length = ftell(file)) >= 0 && fseek(file, 0, SEEK_SET) == 0) {
+		data = malloc((size_t)length + 1U);
+		if (data != NULL && fread(data, 1, (size_t)length, file) != (size_t)length) {
+			free(data);
+			data = NULL;
+		}
+		*size = (size_t)length;
+	}
+
+	fclose(file);
+
+	if (data == NULL) {
+		fprintf(stderr, "cannot read %s\n", path);
+	}
+
+	return data;
+}
+
+static void usage(const char *name)
+{
+	fprintf(stderr,
+			"usage: %s --image <file> --ecu <code>... [--bus udp[:<port>]|<can interface>] [--burst <bytes>]\n"
+			"          [--bitrate <bit/s>] [--sequential | --round-robin] [--capture <file>]\n"
+			"  --image        update file sent to every ECU\n"
+			"  --ecu          ECU code to update, repeat for each ECU\n"
+			"  --bus          bus of the ECUs, default udp\n"
+			"  --burst        burst size asked in the INFO, default the largest each ECU accepts\n"
+			"  --bitrate      classic CAN bit rate of the bus, default %u\n"
+			"  --sequential   update the ECUs one after the other\n"
+			"  --round-robin  interleave a frame of each ECU in turn instead of whole bursts\n"
+			"  --capture      trace of the frames sent and received, candump -l format\n",
+			name, FLASHER_DEFAULT_BITRATE);
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+int main(int argc, char **argv)
+{
+	static const struct option options[] = {
+		{ "image", required_argument, NULL, 'i' },
+		{ "ecu", required_argument, NULL, 'e' },
+		{ "bus", required_argument, NULL, 'b' },
+		{ "burst", required_argument, NULL, 'w' },
+		{ "bitrate", required_argument, NULL, 'r' },
+		{ "sequential", no_argument, NULL, 's' },
+		{ "round-robin", no_argument, NULL, 'R' },
+		{ "capture", required_argument, NULL, 'c' },
+		{ NULL, 0, NULL, 0 },
+	};
+	const char *image_path = NULL;
+	const char *bus_name = "udp";
+	const char *capture_path = NULL;
+	uint8_t ecu_ids[FLASH_SCHEDULER_MAX_SESSIONS];
+	uint16_t burst_bytes = 0;
+	bool sequential = false;
+	flash_scheduler_policy_e policy = FLASH_SCHEDULER_ADAPTIVE;
+	int option;
+
+	flasher.timing.nominal_bps = FLASHER_DEFAULT_BITRATE;
+
+	while ((option = getopt_long(argc, argv, "", options, NULL)) != -1) {
+		switch (option) {
+			case 'i': image_path = optarg; break;
+			case 'e': {
+				char *end;
+				unsigned long ecu_id = strtoul(optarg, &end, 0);
+
+				if (flasher_session_count == FLASH_SCHEDULER_MAX_SESSIONS || ecu_id > 0xFFUL || *end != '\0') {
+					usage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				ecu_ids[flasher_session_count++] = (uint8_t)ecu_id;
+				break;
+			}
+			case 'b': bus_name = optarg; break;
+			case 'w': burst_bytes = (uint16_t)strtoul(optarg, NULL, 0); break;
+			case 'r': flasher.timing.nominal_bps = (uint32_t)strtoul(optarg, NULL, 0); break;
+			case 's': sequential = true; break;
+			case 'R': policy = FLASH_SCHEDULER_ROUND_ROBIN; break;
+			case 'c': capture_path = optarg; break;
+			default:
+				usage(argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+
+	if (image_path == NULL || flasher_session_count == 0U || flasher.timing.nominal_bps == 0U) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	size_t image_size;
+	uint8_t *image = read_file(image_path, &image_size);
+	if (image == NULL) {
+		return EXIT_FAILURE;
+	}
+
+	if (host_can_open(&flasher.bus, bus_name) != 0) {
+		free(image);
+		return EXIT_FAILURE;
+	}
+	flasher.bus_name = bus_name;
+	flasher.pace = flasher.bus.udp;
+
+	if (capture_path != NULL && (flasher.capture = fopen(capture_path, "w")) == NULL) {
+		perror(capture_path);
+		host_can_close(&flasher.bus);
+		free(image);
+		return EXIT_FAILURE;
+	}
+
+	host_can_frame_t packet = {
+		.identifier = CAN_MSG_RECV_BURST_DATA_ID,
+		.extended = true,
+		.length = CAN_MSG_RECV_DATA_OFFSET + FLASH_SESSION_PACKET_SIZE,
+	};
+	(void)flash_scheduler_init(&flasher_scheduler, flasher_sessions, flasher_session_count, policy,
+			(uint32_t)(flasher_frame_ns(&packet) / FLASHER_NS_PER_US));
+
+	flasher.start_ns = flasher_now_ns();
+	for (uint32_t i = 0; i < flasher_session_count; i++) {
+		flash_session_init(&flasher_sessions[i], ecu_ids[i], image, (uint32_t)image_size, burst_bytes);
+		flash_session_start(&flasher_sessions[i], 0U);
+		if (sequential) {
+			flash_session_hold(&flasher_sessions[i]);
+		}
+	}
+
+	printf("updating %u ECUs with %s (%zu bytes) on %s\n", flasher_session_count, image_path, image_size, bus_name);
+	fflush(stdout);
+
+	int status = (flasher_run(sequential) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+	flasher_report(bus_name);
+	for (uint32_t i = 0; i < flasher_session_count; i++) {
+		if (flasher_sessions[i].state != FLASH_SESSION_DONE) {
+			status = EXIT_FAILURE;
+		}
+	}
+
+	if (flasher.capture != NULL) {
+		fclose(flasher.capture);
+	}
+	host_can_close(&flasher.bus);
+	free(image);
+
+	return status;
+}
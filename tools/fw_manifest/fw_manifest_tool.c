@@ -0,0 +1,388 @@
+/**
+ * @file fw_manifest_tool.c
+ * @brief Host packer/verifier for the signed segment manifest
+ * @details pack:    builds and signs (ECDSA P-256) the manifest of an upgrade image
+ *          prepare: builds an unsigned manifest and prints the SHA-256 of its header,
+ *                   the message to have signed by an external signer (Ed25519)
+ *          attach:  stores a 64-byte signature made by the external signer
+ *          verify:  checks a manifest against an image and a public key, the same
+ *                   way the bootloader does (see services/manifest/fw_manifest.c)
+ *
+ *          Keys and signatures are raw binary files: ECDSA 32 bytes private key and
+ *          64 bytes public key (X|Y) as used by tinycrypt, Ed25519 32 bytes public key.
+ * @date 19/10/2026
+ */
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include <tinycrypt/sha256.h>
+#include <tinycrypt/ecc.h>
+#include <tinycrypt/ecc_dsa.h>
+#include "ed25519.h"
+#include "fw_manifest_format.h"
+
+/* Private defines ------------------------------------------------------------------*/
+#define FW_MANIFEST_TOOL_DEFAULT_SEGMENT_SIZE   0x2000U     /* One flash sector */
+#define FW_MANIFEST_TOOL_SLOT_SIZE              0x72000U    /* MEM_UPGRADE_END_ADDRESS - MEM_UPGRADE_START_ADDRESS */
+#define FW_MANIFEST_TOOL_CHUNK_SIZE             0x2000U     /* btea_chunk_size of the bootloader */
+
+/* Private Functions ----------------------------------------------------------------*/
+static uint8_t *read_file(const char *path, size_t *size)
+{
+	FILE *file = fopen(path, "rb");
+	uint8_t *data = NULL;
+	long length;
+
+	if (file == NULL) {
+		fprintf(stderr, "cannot open %s\n", path);
+		return NULL;
+	}
+
+	if (fseek(file, 0, SEEK_END) == 0 && (length = ftell(file)) >= 0 && fseek(file, 0, SEEK_SET) == 0) {
+		data = malloc((size_t)length + 1U);
+		if (data != NULL && fread(data, 1, (size_t)length, file) != (size_t)length) {
+			free(data);
+			data = NULL;
+		}
+		*size = (size_t)length;
+	}
+
+	fclose(file);
+
+	if (data == NULL) {
+		fprintf(stderr, "cannot read %s\n", path);
+	}
+
+	return data;
+}
+
+static int write_file(const char *path, const uint8_t *data, size_t size)
+{
+	FILE *file = fopen(path, "wb");
+
+	if (file == NULL || fwrite(data, 1, size, file) != size) {
+		fprintf(stderr, "cannot write %s\n", path);
+		if (file != NULL) {
+			fclose(file);
+		}
+		return -1;
+	}
+
+	return fclose(file);
+}
+
+static void sha256(const void *data, size_t size, uint8_t digest[TC_SHA256_DIGEST_SIZE])
+{
+	struct tc_sha256_state_struct sha;
+
+	(void)tc_sha256_init(&sha);
+	(void)tc_sha256_update(&sha, (const uint8_t *)data, size);
+	(void)tc_sha256_final(digest, &sha);
+}
+
+static int urandom_rng(uint8_t *dest, unsigned int size)
+{
+	FILE *file = fopen("/dev/urandom", "rb");
+	size_t read = 0;
+
+	if (file != NULL) {
+		read = fread(dest, 1, size, file);
+		fclose(file);
+	}
+
+	return read == size;
+}
+
+static uint32_t segment_length(const fw_manifest_header_t *header, uint32_t segment)
+{
+	uint32_t remaining = header->image_size - (segment * header->segment_size);
+
+	return (remaining < header->segment_size) ? remaining : header->segment_size;
+}
+
+/* Fill header and segment hashes, the signature is left zeroed; returns the manifest size or 0 */
+static size_t build(uint8_t manifest[FW_MANIFEST_MAX_SIZE], const char *image_path, uint16_t sig_alg,
+		uint32_t fw_version, uint32_t segment_size)
+{
+	fw_manifest_header_t *header = (fw_manifest_header_t *)manifest;
+	uint8_t *hashes = &manifest[sizeof(fw_manifest_header_t)];
+	size_t image_size, size = 0;
+
+	uint8_t *image = read_file(image_path, &image_size);
+
+	if (image == NULL) {
+		return 0;
+	}
+
+	if (image_size == 0 || image_size > FW_MANIFEST_TOOL_SLOT_SIZE) {
+		fprintf(stderr, "image size %zu does not fit the upgrade slot\n", image_size);
+		goto out;
+	}
+
+	if (segment_size == 0 || (segment_size % 16U) != 0 || (FW_MANIFEST_TOOL_CHUNK_SIZE % segment_size) != 0) {
+		fprintf(stderr, "segment size must be a multiple of 16 dividing the %u bytes BTEA chunk\n", FW_MANIFEST_TOOL_CHUNK_SIZE);
+		goto out;
+	}
+
+	memset(manifest, 0, FW_MANIFEST_MAX_SIZE);
+	header->magic = FW_MANIFEST_MAGIC;
+	header->version = FW_MANIFEST_VERSION;
+	header->sig_alg = sig_alg;
+	header->image_size = (uint32_t)image_size;
+	header->segment_size = segment_size;
+	header->segment_count = (uint32_t)((image_size + segment_size - 1U) / segment_size);
+	header->fw_version = fw_version;
+
+	if (header->segment_count > FW_MANIFEST_MAX_SEGMENTS) {
+		fprintf(stderr, "%u segments, at most %u are supported: increase the segment size\n",
+				header->segment_count, FW_MANIFEST_MAX_SEGMENTS);
+		goto out;
+	}
+
+	for (uint32_t segment = 0; segment < header->segment_count; segment++) {
+		sha256(&image[segment * segment_size], segment_length(header, segment),
+				&hashes[segment * FW_MANIFEST_HASH_SIZE]);
+	}
+	sha256(hashes, header->segment_count * FW_MANIFEST_HASH_SIZE, header->root);
+	size = FW_MANIFEST_SIZE(header->segment_count);
+
+out:
+	free(image);
+	return size;
+}
+
+static uint8_t *signature_of(uint8_t *manifest)
+{
+	const fw_manifest_header_t *header = (const fw_manifest_header_t *)manifest;
+
+	return &manifest[sizeof(fw_manifest_header_t) + (header->segment_count * FW_MANIFEST_HASH_SIZE)];
+}
+
+static int write_manifest(const char *out_path, const uint8_t *manifest, size_t size)
+{
+	const fw_manifest_header_t *header = (const fw_manifest_header_t *)manifest;
+
+	if (write_file(out_path, manifest, size) != 0) {
+		return EXIT_FAILURE;
+	}
+
+	printf("%s: %u segments of %u bytes, %zu bytes\n", out_path, header->segment_count, header->segment_size, size);
+	return EXIT_SUCCESS;
+}
+
+static int pack(const char *image_path, const char *key_path, const char *out_path,
+		uint32_t fw_version, uint32_t segment_size)
+{
+	uint8_t manifest[FW_MANIFEST_MAX_SIZE];
+	uint8_t digest[TC_SHA256_DIGEST_SIZE];
+	size_t key_size;
+	int result = EXIT_FAILURE;
+
+	uint8_t *key = read_file(key_path, &key_size);
+	size_t size = build(manifest, image_path, FW_MANIFEST_SIG_ECDSA_P256, fw_version, segment_size);
+
+	if (key == NULL || size == 0) {
+		goto out;
+	}
+
+	if (key_size != NUM_ECC_BYTES) {
+		fprintf(stderr, "private key must be %u bytes\n", NUM_ECC_BYTES);
+		goto out;
+	}
+
+	sha256(manifest, sizeof(fw_manifest_header_t), digest);
+	uECC_set_rng(urandom_rng);
+	if (uECC_sign(key, digest, sizeof(digest), signature_of(manifest), uECC_secp256r1()) != TC_CRYPTO_SUCCESS) {
+		fprintf(stderr, "signing failed\n");
+		goto out;
+	}
+
+	result = write_manifest(out_path, manifest, size);
+
+out:
+	free(key);
+	return result;
+}
+
+static int prepare(const char *image_path, const char *algorithm, const char *out_path,
+		uint32_t fw_version, uint32_t segment_size)
+{
+	uint8_t manifest[FW_MANIFEST_MAX_SIZE];
+	uint8_t digest[TC_SHA256_DIGEST_SIZE];
+	uint16_t sig_alg;
+
+	if (strcmp(algorithm, "ed25519") == 0) {
+		sig_alg = FW_MANIFEST_SIG_ED25519;
+	} else if (strcmp(algorithm, "ecdsa") == 0) {
+		sig_alg = FW_MANIFEST_SIG_ECDSA_P256;
+	} else {
+		fprintf(stderr, "unknown algorithm %s\n", algorithm);
+		return EXIT_FAILURE;
+	}
+
+	size_t size = build(manifest, image_path, sig_alg, fw_version, segment_size);
+
+	if (size == 0 || write_manifest(out_path, manifest, size) != EXIT_SUCCESS) {
+		return EXIT_FAILURE;
+	}
+
+	/* The message to sign, as hex */
+	sha256(manifest, sizeof(fw_manifest_header_t), digest);
+	for (uint32_t i = 0; i < sizeof(digest); i++) {
+		printf("%02x", digest[i]);
+	}
+	printf("\n");
+
+	return EXIT_SUCCESS;
+}
+
+static int attach(const char *manifest_path, const char *signature_path)
+{
+	size_t manifest_size, signature_size;
+	int result = EXIT_FAILURE;
+
+	uint8_t *manifest = read_file(manifest_path, &manifest_size);
+	uint8_t *signature = read_file(signature_path, &signature_size);
+
+	if (manifest == NULL || signature == NULL) {
+		goto out;
+	}
+
+	const fw_manifest_header_t *header = (const fw_manifest_header_t *)manifest;
+
+	if (manifest_size < sizeof(*header) || header->segment_count > FW_MANIFEST_MAX_SEGMENTS ||
+			manifest_size != FW_MANIFEST_SIZE(header->segment_count) || signature_size != FW_MANIFEST_SIGNATURE_SIZE) {
+		fprintf(stderr, "malformed manifest or signature\n");
+		goto out;
+	}
+
+	memcpy(signature_of(manifest), signature, FW_MANIFEST_SIGNATURE_SIZE);
+	result = write_manifest(manifest_path, manifest, manifest_size);
+
+out:
+	free(manifest);
+	free(signature);
+	return result;
+}
+
+static int verify(const char *image_path, const char *manifest_path, const char *key_path)
+{
+	uint8_t digest[TC_SHA256_DIGEST_SIZE];
+	size_t image_size, manifest_size, key_size;
+	int result = EXIT_FAILURE;
+
+	uint8_t *image = read_file(image_path, &image_size);
+	uint8_t *manifest = read_file(manifest_path, &manifest_size);
+	uint8_t *key = read_file(key_path, &key_size);
+
+	if (image == NULL || manifest == NULL || key == NULL) {
+		goto out;
+	}
+
+	const fw_manifest_header_t *header = (const fw_manifest_header_t *)manifest;
+	const uint8_t *hashes = &manifest[sizeof(fw_manifest_header_t)];
+
+	if (manifest_size < sizeof(*header) || header->magic != FW_MANIFEST_MAGIC ||
+			header->version != FW_MANIFEST_VERSION || header->segment_count == 0 ||
+			header->segment_count > FW_MANIFEST_MAX_SEGMENTS ||
+			manifest_size != FW_MANIFEST_SIZE(header->segment_count)) {
+		fprintf(stderr, "malformed manifest\n");
+		goto out;
+	}
+
+	sha256(hashes, header->segment_count * FW_MANIFEST_HASH_SIZE, digest);
+	if (memcmp(digest, header->root, sizeof(digest)) != 0) {
+		fprintf(stderr, "root does not match the segment hashes\n");
+		goto out;
+	}
+
+	sha256(header, sizeof(*header), digest);
+	if (header->sig_alg == FW_MANIFEST_SIG_ECDSA_P256) {
+		if (key_size != 2U * NUM_ECC_BYTES) {
+			fprintf(stderr, "ECDSA public key must be %u bytes\n", 2U * NUM_ECC_BYTES);
+			goto out;
+		}
+		if (uECC_verify(key, digest, sizeof(digest), signature_of(manifest), uECC_secp256r1()) != TC_CRYPTO_SUCCESS) {
+			fprintf(stderr, "bad signature\n");
+			goto out;
+		}
+	} else if (header->sig_alg == FW_MANIFEST_SIG_ED25519) {
+		ed25519_public_key_t ed25519_key;
+
+		if (key_size != ED25519_PUBLIC_KEY_SIZE) {
+			fprintf(stderr, "Ed25519 public key must be %u bytes\n", ED25519_PUBLIC_KEY_SIZE);
+			goto out;
+		}
+		memcpy(ed25519_key.key, key, sizeof(ed25519_key.key));
+		if (ed25519_verify(&ed25519_key, digest, sizeof(digest), signature_of(manifest)) != ED25519_VERIFY_OK) {
+			fprintf(stderr, "bad signature\n");
+			goto out;
+		}
+	} else {
+		fprintf(stderr, "unsupported signature algorithm %u\n", header->sig_alg);
+		goto out;
+	}
+
+	if (image_size != header->image_size) {
+		fprintf(stderr, "image is %zu bytes, manifest expects %u\n", image_size, header->image_size);
+		goto out;
+	}
+
+	result = EXIT_SUCCESS;
+	for (uint32_t segment = 0; segment < header->segment_count; segment++) {
+		sha256(&image[segment * header->segment_size], segment_length(header, segment), digest);
+		if (memcmp(digest, &hashes[segment * FW_MANIFEST_HASH_SIZE], sizeof(digest)) != 0) {
+			fprintf(stderr, "segment %u does not match\n", segment);
+			result = EXIT_FAILURE;
+		}
+	}
+
+	if (result == EXIT_SUCCESS) {
+		printf("OK: %u segments, fw version 0x%08X\n", header->segment_count, header->fw_version);
+	}
+
+out:
+	free(image);
+	free(manifest);
+	free(key);
+	return result;
+}
+
+static void usage(const char *name)
+{
+	fprintf(stderr,
+			"usage: %s pack <image> <private_key> <manifest> [fw_version] [segment_size]\n"
+			"       %s prepare <image> ecdsa|ed25519 <manifest> [fw_version] [segment_size]\n"
+			"       %s attach <manifest> <signature>\n"
+			"       %s verify <image> <manifest> <public_key>\n", name, name, name, name);
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+int main(int argc, char **argv)
+{
+	if (argc >= 5 && argc <= 7 && (strcmp(argv[1], "pack") == 0 || strcmp(argv[1], "prepare") == 0)) {
+		uint32_t fw_version = (argc > 5) ? (uint32_t)strtoul(argv[5], NULL, 0) : 0U;
+		uint32_t segment_size = (argc > 6) ? (uint32_t)strtoul(argv[6], NULL, 0) : FW_MANIFEST_TOOL_DEFAULT_SEGMENT_SIZE;
+
+		if (strcmp(argv[1], "pack") == 0) {
+			return pack(argv[2], argv[3], argv[4], fw_version, segment_size);
+		}
+		return prepare(argv[2], argv[3], argv[4], fw_version, segment_size);
+	}
+
+	if (argc == 4 && strcmp(argv[1], "attach") == 0) {
+		return attach(argv[2], argv[3]);
+	}
+
+	if (argc == 5 && strcmp(argv[1], "verify") == 0) {
+		return verify(argv[2], argv[3], argv[4]);
+	}
+
+	usage(argv[0]);
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file can_log.c
+ * @brief CAN traces in the log format of candump -l, read by canplayer
+ * @date 19/10/2026
+ */
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <ctype.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "can_log.h"
+
+/* Private defines ------------------------------------------------------------------*/
+#define CAN_LOG_STANDARD_DIGITS             3U
+#define CAN_LOG_EXTENDED_DIGITS             8U
+#define CAN_LOG_STANDARD_ID_MAX             0x7FFU
+#define CAN_LOG_EXTENDED_ID_MAX             0x1FFFFFFFU
+#define CAN_LOG_CLASSIC_MAX_LENGTH          8U
+#define CAN_LOG_FRACTION_DIGITS             6U          /* Microseconds */
+
+/* Private Functions ----------------------------------------------------------------*/
+static int can_log_hex_digit(char c)
+{
+	if (c >= '0' && c <= '9') {
+		return c - '0';
+	}
+	c = (char)tolower((unsigned char)c);
+
+	return (c >= 'a' && c <= 'f') ? (c - 'a' + 10) : -1;
+}
+
+/**
+ * @return 1 for a frame, 0 for a line to skip, -1 if malformed.
+ */
+static int can_log_parse(const char *line, uint64_t *time_us, host_can_frame_t *frame)
+{
+	unsigned long long seconds;
+	char fraction[CAN_LOG_FRACTION_DIGITS + 1U];
+	uint64_t micros = 0;
+	int offset = 0;
+	const char *text;
+	uint32_t digits = 0;
+	uint32_t identifier = 0;
+
+	while (isspace((unsigned char)*line)) {
+		line++;
+	}
+	if (*line == '\0' || *line == '#') {
+		return 0;
+	}
+
+	/* The interface is read and dropped */
+	if (sscanf(line, "(%llu.%6[0-9]) %*s %n", &seconds, fraction, &offset) != 2 || offset == 0) {
+		return -1;
+	}
+	/* canplayer takes fewer digits, as a decimal fraction */
+	size_t fraction_digits = strlen(fraction);
+	for (uint32_t i = 0; i < CAN_LOG_FRACTION_DIGITS; i++) {
+		micros = (micros * 10U) + ((i < fraction_digits) ? (uint64_t)(fraction[i] - '0') : 0U);
+	}
+	*time_us = ((uint64_t)seconds * 1000000ULL) + micros;
+	text = &line[offset];
+
+	for (; can_log_hex_digit(*text) >= 0 && digits <= CAN_LOG_EXTENDED_DIGITS; text++, digits++) {
+		identifier = (identifier << 4) | (uint32_t)can_log_hex_digit(*text);
+	}
+	if (*text != '#' || digits == 0U || digits > CAN_LOG_EXTENDED_DIGITS) {
+		return -1;
+	}
+	text++;
+
+	memset(frame, 0, sizeof(*frame));
+	frame->extended = (digits > CAN_LOG_STANDARD_DIGITS) || (identifier > CAN_LOG_STANDARD_ID_MAX);
+	frame->identifier = identifier;
+
+	/* Error frames carry CAN_ERR_FLAG in their identifier */
+	if (identifier > CAN_LOG_EXTENDED_ID_MAX || *text == 'R' || *text == 'r') {
+		return 0;
+	}
+
+	if (*text == '#') {
+		frame->fd = true;
+		if (can_log_hex_digit(text[1]) < 0) {
+			return -1;
+		}
+		text += 2;
+	}
+
+	while (*text != '\0' && !isspace((unsigned char)*text)) {
+		/* Bytes can be separated by dots (candump -ta ...) */
+		if (*text == '.') {
+			text++;
+			continue;
+		}
+
+		int high = can_log_hex_digit(text[0]);
+		int low = (high >= 0) ? can_log_hex_digit(text[1]) : -1;
+
+		if (low < 0 || frame->length == HOST_CAN_MAX_DATA_LENGTH) {
+			return -1;
+		}
+		frame->data[frame->length++] = (uint8_t)((high << 4) | low);
+		text += 2;
+	}
+
+	if (!frame->fd && frame->length > CAN_LOG_CLASSIC_MAX_LENGTH) {
+		return -1;
+	}
+
+	return 1;
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @brief Append a frame received or sent at time_us.
+ */
+int can_log_write(FILE *file, uint64_t time_us, const char *interface, const host_can_frame_t *frame)
+{
+	char data[(HOST_CAN_MAX_DATA_LENGTH * 2U) + 1U];
+
+	for (uint32_t i = 0; i < frame->length && i < HOST_CAN_MAX_DATA_LENGTH; i++) {
+		snprintf(&data[i * 2U], 3, "%02X", frame->data[i]);
+	}
+	data[(frame->length < HOST_CAN_MAX_DATA_LENGTH ? frame->length : HOST_CAN_MAX_DATA_LENGTH) * 2U] = '\0';
+
+	int written = fprintf(file, "(%llu.%06llu) %s %0*X%s%s\n",
+			(unsigned long long)(time_us / 1000000U), (unsigned long long)(time_us % 1000000U), interface,
+			frame->extended ? (int)CAN_LOG_EXTENDED_DIGITS : (int)CAN_LOG_STANDARD_DIGITS, (unsigned int)frame->identifier,
+			frame->fd ? "##0" : "#", data);
+
+	return (written < 0) ? -1 : 0;
+}
+
+/**
+ * @brief Read the next frame, skipping the lines which are not one.
+ * @return 1 for a frame, 0 at the end of the file, -1 on a malformed line.
+ */
+int can_log_read(FILE *file, uint64_t *time_us, host_can_frame_t *frame)
+{
+	char line[CAN_LOG_LINE_MAX];
+
+	while (fgets(line, sizeof(line), file) != NULL) {
+		int result = can_log_parse(line, time_us, frame);
+
+		if (result != 0) {
+			return result;
+		}
+	}
+
+	return 0;
+}
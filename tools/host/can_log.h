@@ -0,0 +1,29 @@
+/**
+ * @file can_log.h
+ * @brief CAN traces in the log format of candump -l, read by canplayer
+ * @details One frame per line, its time in seconds with microseconds, the interface
+ *          and the frame:
+ *
+ *            (0.012345) can0 0001F105#05A1B2C3D4E5F607
+ *            (0.012891) can0 0001F105##105A1B2C3D4E5F607
+ *
+ *          The identifier has 3 hex digits when standard and 8 when extended, a CAN
+ *          FD frame has a second '#' and its flags digit (1 for the bit rate switch)
+ *          before the data. A trace of a real bus taken with candump -l reads the
+ *          same as one written here; remote and error frames are skipped.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include "host_can.h"
+
+/* General defines ------------------------------------------------------------------*/
+#define CAN_LOG_LINE_MAX                    256U
+
+/* Public Functions ------------------------------------------------------------------*/
+int can_log_write(FILE *file, uint64_t time_us, const char *interface, const host_can_frame_t *frame);
+int can_log_read(FILE *file, uint64_t *time_us, host_can_frame_t *frame);
@@ -0,0 +1,229 @@
+/**
+ * @file flash_scheduler.c
+ * @brief Choice of the next frame among the update sessions of several ECUs on one bus
+ * @date 19/10/2026
+ */
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "flash_scheduler.h"
+
+/* Static Variables -----------------------------------------------------------------*/
+static const char *const flash_scheduler_policy_names[] = {
+	"adaptive", "round-robin",
+};
+
+/* Private Functions ----------------------------------------------------------------*/
+static bool flash_scheduler_has_packet(const flash_scheduler_t *scheduler, uint32_t index)
+{
+	return flash_session_pending_packets(&scheduler->sessions[index]) > 0U;
+}
+
+/* A single frame to send now */
+static bool flash_scheduler_has_single(const flash_scheduler_t *scheduler, uint32_t index, uint64_t now_us)
+{
+	const flash_session_t *session = &scheduler->sessions[index];
+
+	return flash_session_has_frame(session, now_us) && !flash_scheduler_has_packet(scheduler, index);
+}
+
+static uint32_t flash_scheduler_window(const flash_scheduler_t *scheduler, uint32_t latency_us)
+{
+	uint32_t window = (latency_us + scheduler->frame_us - 1U) / scheduler->frame_us;
+
+	if (window < FLASH_SCHEDULER_WINDOW_MIN) {
+		return FLASH_SCHEDULER_WINDOW_MIN;
+	}
+
+	return (window > FLASH_SCHEDULER_WINDOW_MAX) ? FLASH_SCHEDULER_WINDOW_MAX : window;
+}
+
+/* Whether session a gets the bus before session b */
+static bool flash_scheduler_before(const flash_scheduler_t *scheduler, uint32_t a, uint32_t b)
+{
+	int64_t due_a = (int64_t)scheduler->sessions[a].burst_request_us - (int64_t)scheduler->nodes[a].latency_us;
+	int64_t due_b = (int64_t)scheduler->sessions[b].burst_request_us - (int64_t)scheduler->nodes[b].latency_us;
+
+	if (due_a != due_b) {
+		return due_a < due_b;
+	}
+
+	return flash_session_pending_packets(&scheduler->sessions[a]) < flash_session_pending_packets(&scheduler->sessions[b]);
+}
+
+static uint32_t flash_scheduler_pick_packet(flash_scheduler_t *scheduler)
+{
+	uint32_t best = scheduler->count;
+
+	if (scheduler->policy == FLASH_SCHEDULER_ROUND_ROBIN) {
+		for (uint32_t n = 0; n < scheduler->count; n++) {
+			uint32_t i = (scheduler->next + n) % scheduler->count;
+
+			if (flash_scheduler_has_packet(scheduler, i)) {
+				return i;
+			}
+		}
+		return scheduler->count;
+	}
+
+	if (scheduler->current < scheduler->count && flash_scheduler_has_packet(scheduler, scheduler->current) &&
+			scheduler->run < scheduler->nodes[scheduler->current].window) {
+		return scheduler->current;
+	}
+
+	/* Ties go to the first one from the round robin start */
+	for (uint32_t n = 0; n < scheduler->count; n++) {
+		uint32_t i = (scheduler->next + n) % scheduler->count;
+
+		if (flash_scheduler_has_packet(scheduler, i) && (best == scheduler->count || flash_scheduler_before(scheduler, i, best))) {
+			best = i;
+		}
+	}
+
+	if (best != scheduler->current) {
+		if (scheduler->current < scheduler->count && flash_scheduler_has_packet(scheduler, scheduler->current)) {
+			scheduler->nodes[scheduler->current].preempted++;
+		}
+		scheduler->current = best;
+	}
+	scheduler->run = 0;
+
+	return best;
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @param frame_us Bus time of a BURST_DATA frame, to express the latencies in frames.
+ */
+int flash_scheduler_init(flash_scheduler_t *scheduler, flash_session_t *sessions, uint32_t count,
+		flash_scheduler_policy_e policy, uint32_t frame_us)
+{
+	if (count == 0U || count > FLASH_SCHEDULER_MAX_SESSIONS) {
+		return -1;
+	}
+
+	memset(scheduler, 0, sizeof(*scheduler));
+	scheduler->sessions = sessions;
+	scheduler->count = count;
+	scheduler->policy = policy;
+	scheduler->frame_us = (frame_us != 0U) ? frame_us : 1U;
+	scheduler->current = count;
+
+	for (uint32_t i = 0; i < count; i++) {
+		scheduler->nodes[i].window = FLASH_SCHEDULER_WINDOW_MIN;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief A frame was received from the bus, for every session.
+ */
+void flash_scheduler_rx(flash_scheduler_t *scheduler, const host_can_frame_t *frame, uint64_t now_us)
+{
+	for (uint32_t i = 0; i < scheduler->count; i++) {
+		const flash_session_stats_t *stats = &scheduler->sessions[i].stats;
+		flash_scheduler_node_t *node = &scheduler->nodes[i];
+
+		flash_session_rx(&scheduler->sessions[i], frame, now_us);
+
+		if (stats->request_latency_count == node->latency_samples) {
+			continue;
+		}
+
+		if (node->latency_samples == 0U) {
+			node->latency_us = stats->request_latency_last_us;
+		} else {
+			node->latency_us = node->latency_us - (node->latency_us >> FLASH_SCHEDULER_LATENCY_SHIFT) +
+					(stats->request_latency_last_us >> FLASH_SCHEDULER_LATENCY_SHIFT);
+		}
+		node->latency_samples = stats->request_latency_count;
+		node->window = flash_scheduler_window(scheduler, node->latency_us);
+	}
+}
+
+/**
+ * @brief The next frame to send, if any, and the index of its session.
+ */
+bool flash_scheduler_next_frame(flash_scheduler_t *scheduler, uint64_t now_us, host_can_frame_t *frame,
+		uint32_t *session)
+{
+	uint32_t chosen = scheduler->count;
+
+	/* The sessions with nothing to send check their ECU is still answering */
+	for (uint32_t i = 0; i < scheduler->count; i++) {
+		if (!flash_session_has_frame(&scheduler->sessions[i], now_us)) {
+			(void)flash_session_next_frame(&scheduler->sessions[i], now_us, frame);
+		}
+	}
+
+	for (uint32_t n = 0; n < scheduler->count && chosen == scheduler->count; n++) {
+		uint32_t i = (scheduler->next + n) % scheduler->count;
+
+		if (flash_scheduler_has_single(scheduler, i, now_us)) {
+			chosen = i;
+		}
+	}
+
+	if (chosen == scheduler->count) {
+		chosen = flash_scheduler_pick_packet(scheduler);
+		if (chosen == scheduler->count) {
+			return false;
+		}
+		scheduler->run++;
+	}
+
+	if (!flash_session_next_frame(&scheduler->sessions[chosen], now_us, frame)) {
+		return false;
+	}
+
+	scheduler->nodes[chosen].frames++;
+	scheduler->next = (chosen + 1U) % scheduler->count;
+	if (session != NULL) {
+		*session = chosen;
+	}
+
+	return true;
+}
+
+/**
+ * @brief When a session has a frame to send at the latest, without any frame
+ *        received: now, the next PREPARE_REQUEST, or UINT64_MAX.
+ */
+uint64_t flash_scheduler_next_due_us(const flash_scheduler_t *scheduler, uint64_t now_us)
+{
+	uint64_t due_us = UINT64_MAX;
+
+	for (uint32_t i = 0; i < scheduler->count; i++) {
+		const flash_session_t *session = &scheduler->sessions[i];
+
+		if (session->state == FLASH_SESSION_PREPARE) {
+			if (session->prepare_due_us < due_us) {
+				due_us = session->prepare_due_us;
+			}
+		} else if (flash_session_has_frame(session, now_us)) {
+			return now_us;
+		}
+	}
+
+	return (due_us < now_us) ? now_us : due_us;
+}
+
+bool flash_scheduler_finished(const flash_scheduler_t *scheduler)
+{
+	for (uint32_t i = 0; i < scheduler->count; i++) {
+		if (!flash_session_finished(&scheduler->sessions[i])) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+const char *flash_scheduler_policy_name(flash_scheduler_policy_e policy)
+{
+	return ((uint32_t)policy < (sizeof(flash_scheduler_policy_names) / sizeof(flash_scheduler_policy_names[0]))) ?
+			flash_scheduler_policy_names[policy] : "?";
+}
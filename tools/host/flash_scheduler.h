@@ -0,0 +1,79 @@
+/**
+ * @file flash_scheduler.h
+ * @brief Choice of the next frame among the update sessions of several ECUs on one bus
+ * @details An ECU that received a whole burst is busy for a while, writing it to its
+ *          FLASH, before it requests the next one: the burst request latency. On a
+ *          shared bus that time is filled with the bursts of the other ECUs.
+ *
+ *          The adaptive policy sends:
+ *            1. the single frames first (PREPARE_REQUEST, INFO, BURST_CRC,
+ *               BURST_COMPLETION), they start or end the work of an ECU. Each
+ *               session waiting for its ECU repeats its PREPARE_REQUEST every
+ *               FLASH_SESSION_PREPARE_PERIOD_US, as a legacy tester does;
+ *            2. then the packets of one burst in a row, so that its ECU starts
+ *               writing as early as possible, rather than all the bursts finishing
+ *               together and all the ECUs writing while the bus is idle.
+ *          When a burst has used its window the burst to continue is chosen
+ *          again: the one requested first, its request time moved earlier by the
+ *          average latency of its ECU, since a long write has the most to hide
+ *          behind the bursts of the others, then the one with the fewest packets
+ *          left. Every burst gets the bus in the end, however long the latencies
+ *          of the others. The window of an ECU is its average latency in frames,
+ *          at least FLASH_SCHEDULER_WINDOW_MIN: an ECU that writes quickly gains
+ *          little from getting its burst early and gives the bus away sooner.
+ *
+ *          The round robin policy sends a frame of each session in turn, as a
+ *          simple tool would, for comparison.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "flash_session.h"
+#include "host_can.h"
+
+/* General defines ------------------------------------------------------------------*/
+#define FLASH_SCHEDULER_MAX_SESSIONS        32U
+#define FLASH_SCHEDULER_WINDOW_MIN          8U          /* Frames */
+#define FLASH_SCHEDULER_WINDOW_MAX          255U        /* Largest burst of a BURST_REQUEST */
+#define FLASH_SCHEDULER_LATENCY_SHIFT       2U          /* A new latency weighs 1/4 of the average */
+
+/* Public Types ---------------------------------------------------------------------*/
+typedef enum {
+	FLASH_SCHEDULER_ADAPTIVE = 0,
+	FLASH_SCHEDULER_ROUND_ROBIN,
+} flash_scheduler_policy_e;
+
+typedef struct {
+	uint32_t latency_us;                    /* Average burst request latency */
+	uint32_t latency_samples;               /* Latencies of the session taken in the average */
+	uint32_t window;                        /* Packets of a burst sent in a row */
+	uint32_t frames;                        /* Frames sent */
+	uint32_t preempted;                     /* Bursts interrupted at the end of their window */
+} flash_scheduler_node_t;
+
+typedef struct {
+	flash_session_t *sessions;
+	uint32_t count;
+	flash_scheduler_policy_e policy;
+	uint32_t frame_us;                      /* Bus time of a BURST_DATA frame */
+
+	uint32_t next;                          /* Round robin start */
+	uint32_t current;                       /* Session of the burst being sent, count if none */
+	uint32_t run;                           /* Packets of the current burst sent in a row */
+
+	flash_scheduler_node_t nodes[FLASH_SCHEDULER_MAX_SESSIONS];
+} flash_scheduler_t;
+
+/* Public Functions ------------------------------------------------------------------*/
+int flash_scheduler_init(flash_scheduler_t *scheduler, flash_session_t *sessions, uint32_t count,
+		flash_scheduler_policy_e policy, uint32_t frame_us);
+void flash_scheduler_rx(flash_scheduler_t *scheduler, const host_can_frame_t *frame, uint64_t now_us);
+bool flash_scheduler_next_frame(flash_scheduler_t *scheduler, uint64_t now_us, host_can_frame_t *frame,
+		uint32_t *session);
+uint64_t flash_scheduler_next_due_us(const flash_scheduler_t *scheduler, uint64_t now_us);
+bool flash_scheduler_finished(const flash_scheduler_t *scheduler);
+const char *flash_scheduler_policy_name(flash_scheduler_policy_e policy);
@@ -0,0 +1,312 @@
+/**
+ * @file flash_session.c
+ * @brief Tester side of the bootloader update protocol, for one ECU
+ * @details The burst CRC is CRC-16/CCITT-FALSE (polynomial 0x1021, initial value
+ *          0xFFFF, no reflection, no final XOR).
+ * @date 19/10/2026
+ */
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <string.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "flash_session.h"
+#include "can_message_handler.h"
+
+/* Private defines ------------------------------------------------------------------*/
+#define FLASH_SESSION_CRC16_POLYNOMIAL      0x1021U
+#define FLASH_SESSION_CRC16_INIT            0xFFFFU
+
+/* Static Variables -----------------------------------------------------------------*/
+static const char *const flash_session_state_names[] = {
+	"idle", "prepare", "info", "transfer", "complete", "done", "failed",
+};
+
+/* Private Functions ----------------------------------------------------------------*/
+static void flash_session_frame(const flash_session_t *session, host_can_frame_t *frame, uint32_t identifier,
+		uint8_t length)
+{
+	memset(frame, 0, sizeof(*frame));
+	frame->identifier = identifier;
+	frame->extended = true;
+	frame->length = length;
+	frame->data[CAN_MSG_ECU_CODE_BYTE_INDEX] = session->ecu_id;
+}
+
+static void flash_session_fail(flash_session_t *session, uint64_t now_us)
+{
+	session->state = FLASH_SESSION_FAILED;
+	session->stats.end_us = now_us;
+}
+
+static bool flash_session_active(const flash_session_t *session)
+{
+	return session->state >= FLASH_SESSION_PREPARE && session->state <= FLASH_SESSION_COMPLETE;
+}
+
+static void flash_session_burst_request(flash_session_t *session, const host_can_frame_t *frame, uint64_t now_us)
+{
+	if (frame->length < CAN_MSG_SEND_PACKET_REQUEST_LENGTH) {
+		return;
+	}
+
+	uint32_t first = (uint32_t)frame->data[CAN_MSG_SEND_PACKET_REQ_SEQUENCE_NUM_BYTE_0_INDEX] |
+			((uint32_t)frame->data[CAN_MSG_SEND_PACKET_REQ_SEQUENCE_NUM_BYTE_1_INDEX] << 8) |
+			((uint32_t)frame->data[CAN_MSG_SEND_PACKET_REQ_SEQUENCE_NUM_BYTE_2_INDEX] << 16);
+	uint32_t count = frame->data[CAN_MSG_SEND_PACKET_REQ_PACKETS_NUM_BYTE_INDEX];
+	uint32_t end = first + count;
+
+	if (count == 0U || end > session->total_packets) {
+		flash_session_fail(session, now_us);
+		return;
+	}
+
+	if (first < session->requested_end) {
+		session->stats.repeated_packets += ((end < session->requested_end) ? end : session->requested_end) - first;
+	}
+	if (end > session->requested_end) {
+		session->requested_end = end;
+	}
+
+	/* The time the ECU took to store the previous burst */
+	if (session->crc_sent_us != 0U) {
+		uint32_t latency_us = (uint32_t)(now_us - session->crc_sent_us);
+
+		session->stats.request_latency_last_us = latency_us;
+		session->stats.request_latency_total_us += latency_us;
+		session->stats.request_latency_count++;
+		if (latency_us > session->stats.request_latency_max_us) {
+			session->stats.request_latency_max_us = latency_us;
+		}
+		session->crc_sent_us = 0U;
+	}
+
+	/* A request replaces a burst not sent yet, the ECU gave up waiting for it */
+	session->burst_first = first;
+	session->burst_count = count;
+	session->burst_sent = 0U;
+	session->burst_request_us = now_us;
+	session->crc_pending = false;
+	session->stats.bursts++;
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @param burst_bytes Burst size asked in the INFO, capped by the ECU; 0 for the
+ *                    largest one the ECU accepts.
+ */
+void flash_session_init(flash_session_t *session, uint8_t ecu_id, const uint8_t *image, uint32_t image_size,
+		uint16_t burst_bytes)
+{
+	memset(session, 0, sizeof(*session));
+	session->ecu_id = ecu_id;
+	session->image = image;
+	session->image_size = image_size;
+	session->burst_bytes = burst_bytes;
+	session->total_packets = (image_size + FLASH_SESSION_PACKET_SIZE - 1U) / FLASH_SESSION_PACKET_SIZE;
+	session->state = FLASH_SESSION_IDLE;
+}
+
+void flash_session_start(flash_session_t *session, uint64_t now_us)
+{
+	session->state = FLASH_SESSION_PREPARE;
+	session->prepare_due_us = now_us;
+	session->last_rx_us = now_us;
+	session->stats.start_us = now_us;
+	session->stats.release_us = now_us;
+}
+
+/**
+ * @brief Stop before the INFO, the ECU being kept in the bootloader.
+ */
+void flash_session_hold(flash_session_t *session)
+{
+	session->held = true;
+}
+
+void flash_session_release(flash_session_t *session, uint64_t now_us)
+{
+	if (!session->held) {
+		return;
+	}
+
+	session->held = false;
+	session->last_rx_us = now_us;
+	session->stats.release_us = now_us;
+}
+
+/**
+ * @brief A frame was received from the bus, frames of other ECUs are ignored.
+ */
+void flash_session_rx(flash_session_t *session, const host_can_frame_t *frame, uint64_t now_us)
+{
+	if (!flash_session_active(session) || !frame->extended || frame->length < CAN_MSG_ECU_CODE_SIZE ||
+			frame->data[CAN_MSG_ECU_CODE_BYTE_INDEX] != session->ecu_id) {
+		return;
+	}
+
+	switch (frame->identifier) {
+		case CAN_MSG_SEND_READY_REPORT_ID:
+			if (session->state == FLASH_SESSION_PREPARE && frame->length >= CAN_MSG_SEND_START_ACK_LENGTH) {
+				uint16_t max_bytes = (uint16_t)frame->data[CAN_MSG_SEND_START_ACK_BUFF_MAX_SIZE_BYTE_0_INDEX] |
+						((uint16_t)frame->data[CAN_MSG_SEND_START_ACK_BUFF_MAX_SIZE_BYTE_1_INDEX] << 8);
+
+				if (session->burst_bytes == 0U || session->burst_bytes > max_bytes) {
+					session->burst_bytes = max_bytes;
+				}
+				session->state = FLASH_SESSION_INFO;
+				session->stats.ready_us = now_us;
+			}
+			break;
+
+		case CAN_MSG_SEND_BURST_REQUEST_ID:
+			if (session->state == FLASH_SESSION_TRANSFER) {
+				flash_session_burst_request(session, frame, now_us);
+			}
+			break;
+
+		case CAN_MSG_SEND_COMPLETION_MESSAGE_ID:
+			if (session->state == FLASH_SESSION_TRANSFER) {
+				session->state = FLASH_SESSION_COMPLETE;
+				session->completion_pending = true;
+			}
+			break;
+
+		case CAN_MSG_SEND_FINISH_REPORT_ID:
+			session->state = FLASH_SESSION_DONE;
+			session->stats.end_us = now_us;
+			break;
+
+		case CAN_MSG_SEND_ERROR_MESSAGE_ID:
+			session->error = (frame->length > 1U) ? frame->data[1] : 0U;
+			flash_session_fail(session, now_us);
+			break;
+
+		default:
+			return;
+	}
+
+	session->last_rx_us = now_us;
+}
+
+/**
+ * @brief Whether flash_session_next_frame() has a frame to give now.
+ */
+bool flash_session_has_frame(const flash_session_t *session, uint64_t now_us)
+{
+	switch (session->state) {
+		case FLASH_SESSION_PREPARE:
+			return now_us >= session->prepare_due_us;
+		case FLASH_SESSION_INFO:
+			return !session->held;
+		case FLASH_SESSION_TRANSFER:
+			return session->burst_sent < session->burst_count || session->crc_pending;
+		case FLASH_SESSION_COMPLETE:
+			return session->completion_pending;
+		default:
+			return false;
+	}
+}
+
+/**
+ * @brief The next frame to send, also checks the ECU is still answering.
+ * @return false if there is nothing to send now.
+ */
+bool flash_session_next_frame(flash_session_t *session, uint64_t now_us, host_can_frame_t *frame)
+{
+	if (flash_session_active(session) && !session->held && (now_us - session->last_rx_us) >= FLASH_SESSION_TIMEOUT_US) {
+		flash_session_fail(session, now_us);
+	}
+
+	if (!flash_session_has_frame(session, now_us)) {
+		return false;
+	}
+
+	switch (session->state) {
+		case FLASH_SESSION_PREPARE:
+			flash_session_frame(session, frame, CAN_MSG_RECV_PREPARE_REQUEST_ID, CAN_MSG_ECU_CODE_SIZE);
+			session->prepare_due_us = now_us + FLASH_SESSION_PREPARE_PERIOD_US;
+			return true;
+
+		case FLASH_SESSION_INFO:
+			flash_session_frame(session, frame, CAN_MSG_RECV_INFO_MESSAGE_ID, CAN_MSG_RECV_START_MSG_MAX_BUFF_BYTE_1_INDEX + 1U);
+			frame->data[CAN_MSG_RECV_START_MSG_FW_SIZE_BYTE_0_INDEX] = (uint8_t)(session->image_size & 0xFF);
+			frame->data[CAN_MSG_RECV_START_MSG_FW_SIZE_BYTE_1_INDEX] = (uint8_t)((session->image_size >> 8) & 0xFF);
+			frame->data[CAN_MSG_RECV_START_MSG_FW_SIZE_BYTE_2_INDEX] = (uint8_t)((session->image_size >> 16) & 0xFF);
+			frame->data[CAN_MSG_RECV_START_MSG_FW_SIZE_BYTE_3_INDEX] = (uint8_t)((session->image_size >> 24) & 0xFF);
+			frame->data[CAN_MSG_RECV_START_MSG_MAX_BUFF_BYTE_0_INDEX] = (uint8_t)(session->burst_bytes & 0xFF);
+			frame->data[CAN_MSG_RECV_START_MSG_MAX_BUFF_BYTE_1_INDEX] = (uint8_t)((session->burst_bytes >> 8) & 0xFF);
+			session->state = FLASH_SESSION_TRANSFER;
+			return true;
+
+		case FLASH_SESSION_TRANSFER:
+			if (session->burst_sent < session->burst_count) {
+				uint32_t offset = (session->burst_first + session->burst_sent) * FLASH_SESSION_PACKET_SIZE;
+				uint32_t size = session->image_size - offset;
+
+				if (size > FLASH_SESSION_PACKET_SIZE) {
+					size = FLASH_SESSION_PACKET_SIZE;
+				}
+				flash_session_frame(session, frame, CAN_MSG_RECV_BURST_DATA_ID, (uint8_t)(CAN_MSG_RECV_DATA_OFFSET + size));
+				memcpy(&frame->data[CAN_MSG_RECV_DATA_OFFSET], &session->image[offset], size);
+
+				session->stats.packets++;
+				session->crc_pending = (++session->burst_sent == session->burst_count);
+				return true;
+			} else {
+				uint32_t offset = session->burst_first * FLASH_SESSION_PACKET_SIZE;
+				uint32_t end = (session->burst_first + session->burst_count) * FLASH_SESSION_PACKET_SIZE;
+				uint16_t crc = flash_session_crc16(&session->image[offset],
+						((end < session->image_size) ? end : session->image_size) - offset);
+
+				flash_session_frame(session, frame, CAN_MSG_RECV_BURST_CRC_ID, CAN_MSG_RECV_PACKET_CRC_BYTE_1_INDEX + 1U);
+				frame->data[CAN_MSG_RECV_PACKET_CRC_BYTE_0_INDEX] = (uint8_t)(crc & 0xFF);
+				frame->data[CAN_MSG_RECV_PACKET_CRC_BYTE_1_INDEX] = (uint8_t)((crc >> 8) & 0xFF);
+
+				session->crc_pending = false;
+				session->crc_sent_us = now_us;
+				return true;
+			}
+
+		case FLASH_SESSION_COMPLETE:
+			flash_session_frame(session, frame, CAN_MSG_RECV_DATABURST_COMPLETE_MESSAGE_ID, CAN_MSG_ECU_CODE_SIZE);
+			session->completion_pending = false;
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+bool flash_session_finished(const flash_session_t *session)
+{
+	return session->state == FLASH_SESSION_DONE || session->state == FLASH_SESSION_FAILED;
+}
+
+/**
+ * @brief Packets of the current burst not sent yet.
+ */
+uint32_t flash_session_pending_packets(const flash_session_t *session)
+{
+	return (session->state == FLASH_SESSION_TRANSFER) ? (session->burst_count - session->burst_sent) : 0U;
+}
+
+const char *flash_session_state_name(flash_session_state_e state)
+{
+	return ((uint32_t)state < (sizeof(flash_session_state_names) / sizeof(flash_session_state_names[0]))) ?
+			flash_session_state_names[state] : "?";
+}
+
+uint16_t flash_session_crc16(const uint8_t *data, uint32_t size)
+{
+	uint16_t crc = FLASH_SESSION_CRC16_INIT;
+
+	for (uint32_t i = 0; i < size; i++) {
+		crc ^= (uint16_t)((uint16_t)data[i] << 8);
+		for (uint32_t bit = 0; bit < 8U; bit++) {
+			crc = (uint16_t)(((crc & 0x8000U) != 0U) ? (((uint32_t)crc << 1) ^ FLASH_SESSION_CRC16_POLYNOMIAL) : ((uint32_t)crc << 1));
+		}
+	}
+
+	return crc;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file flash_session.h
+ * @brief Tester side of the bootloader update protocol, for one ECU
+ * @details The session follows the messages of can_message_handler.h:
+ *            1. PREPARE_REQUEST [ecu], repeated until the READY_REPORT
+ *               [ecu][max burst bytes LE16];
+ *            2. INFO [ecu][image size LE32][burst bytes LE16];
+ *            3. for each BURST_REQUEST [ecu][first packet LE24][packet count], the
+ *               packets as BURST_DATA [ecu][7 image bytes], the last one shorter,
+ *               then BURST_CRC [ecu][CRC-16 of the burst LE16];
+ *            4. on the COMPLETION [ecu], once the ECU has the whole image, the
+ *               BURST_COMPLETION [ecu];
+ *            5. the FINISH_REPORT [ecu] ends the session, an ERROR [ecu][code]
+ *               fails it.
+ *          The session does no I/O: received frames are passed to
+ *          flash_session_rx() and the frames to send are pulled one at a time with
+ *          flash_session_next_frame(), when the transmitter can take one. A tool
+ *          driving several sessions on one bus chooses which one sends next.
+ *
+ *          A held session keeps its ECU in the bootloader with the PREPARE_REQUEST
+ *          but sends the INFO only once flash_session_release() is called, for
+ *          ECUs updated one after the other that would jump to their application
+ *          while waiting for their turn.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include "host_can.h"
+
+/* General defines ------------------------------------------------------------------*/
+#define FLASH_SESSION_PACKET_SIZE           7U          /* Image bytes per BURST_DATA */
+#define FLASH_SESSION_PREPARE_PERIOD_US     50000U      /* Of a legacy tester, within the quiet time of listen_window.h */
+#define FLASH_SESSION_TIMEOUT_US            5000000U    /* Silence of the ECU that fails the session */
+
+/* Public Types ---------------------------------------------------------------------*/
+typedef enum {
+	FLASH_SESSION_IDLE = 0,
+	FLASH_SESSION_PREPARE,                  /* Waiting for the READY_REPORT */
+	FLASH_SESSION_INFO,                     /* INFO to send */
+	FLASH_SESSION_TRANSFER,                 /* Answering burst requests */
+	FLASH_SESSION_COMPLETE,                 /* Waiting for the FINISH_REPORT */
+	FLASH_SESSION_DONE,
+	FLASH_SESSION_FAILED,
+} flash_session_state_e;
+
+typedef struct {
+	uint32_t bursts;
+	uint32_t packets;                       /* BURST_DATA sent, repeated ones included */
+	uint32_t repeated_packets;              /* Requested again */
+	uint64_t start_us;
+	uint64_t ready_us;                      /* READY_REPORT received */
+	uint64_t release_us;                    /* Start, or release of a held session */
+	uint64_t end_us;                        /* FINISH_REPORT or failure */
+	uint32_t request_latency_last_us;       /* From a BURST_CRC to the next BURST_REQUEST */
+	uint32_t request_latency_max_us;
+	uint64_t request_latency_total_us;
+	uint32_t request_latency_count;
+} flash_session_stats_t;
+
+typedef struct {
+	uint8_t ecu_id;
+	const uint8_t *image;
+	uint32_t image_size;
+	uint16_t burst_bytes;                   /* Asked in the INFO, 0 for the size of the READY_REPORT */
+	flash_session_state_e state;
+	uint8_t error;                          /* Code of the ERROR message */
+	bool held;                              /* The INFO waits for flash_session_release() */
+
+	uint32_t total_packets;
+	uint32_t requested_end;                 /* One past the highest packet requested */
+	uint32_t burst_first;
+	uint32_t burst_count;
+	uint32_t burst_sent;                    /* Packets of the burst sent, burst_count then the CRC is due */
+	uint64_t burst_request_us;              /* BURST_REQUEST of the burst */
+	bool crc_pending;
+	bool completion_pending;
+	uint64_t crc_sent_us;
+	uint64_t prepare_due_us;
+	uint64_t last_rx_us;
+
+	flash_session_stats_t stats;
+} flash_session_t;
+
+/* Public Functions ------------------------------------------------------------------*/
+void flash_session_init(flash_session_t *session, uint8_t ecu_id, const uint8_t *image, uint32_t image_size,
+		uint16_t burst_bytes);
+void flash_session_start(flash_session_t *session, uint64_t now_us);
+void flash_session_hold(flash_session_t *session);
+void flash_session_release(flash_session_t *session, uint64_t now_us);
+void flash_session_rx(flash_session_t *session, const host_can_frame_t *frame, uint64_t now_us);
+bool flash_session_next_frame(flash_session_t *session, uint64_t now_us, host_can_frame_t *frame);
+bool flash_session_has_frame(const flash_session_t *session, uint64_t now_us);
+bool flash_session_finished(const flash_session_t *session);
+uint32_t flash_session_pending_packets(const flash_session_t *session);
+const char *flash_session_state_name(flash_session_state_e state);
+uint16_t flash_session_crc16(const uint8_t *data, uint32_t size);
@@ -0,0 +1,286 @@
+/**
+ * @file host_can.c
+ * @brief CAN access for the host tools
+ * @details UDP frames carry the tag of their sender, so that its own frames looped
+ *          back by the multicast group can be dropped. They never leave the machine:
+ *          the group is joined and sent to on the loopback interface only.
+ * @date 19/10/2026
+ */
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <errno.h>
+#include <poll.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "host_can.h"
+
+/* Private defines ------------------------------------------------------------------*/
+#define HOST_CAN_UDP_GROUP                  "239.255.67.1"
+#define HOST_CAN_UDP_MAGIC                  0x4E414355U     /* "UCAN" */
+
+#define HOST_CAN_UDP_FLAG_EXTENDED          0x01U
+#define HOST_CAN_UDP_FLAG_FD                0x02U
+
+/* Private types --------------------------------------------------------------------*/
+typedef struct {
+	uint32_t magic;
+	uint32_t source;
+	uint32_t identifier;
+	uint8_t flags;
+	uint8_t length;
+	uint8_t reserved[2];
+	uint8_t data[HOST_CAN_MAX_DATA_LENGTH];
+} host_can_udp_frame_t;
+
+/* Private Functions ----------------------------------------------------------------*/
+static int64_t host_can_now_ms(void)
+{
+	struct timespec now;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((int64_t)now.tv_sec * 1000) + (now.tv_nsec / 1000000);
+}
+
+static int host_can_open_udp(host_can_t *bus, uint16_t port)
+{
+	struct sockaddr_in address = {0};
+	struct ip_mreq membership = {0};
+	struct in_addr loopback = { .s_addr = htonl(INADDR_LOOPBACK) };
+	int enable = 1;
+	struct timespec now;
+
+	bus->fd = socket(AF_INET, SOCK_DGRAM, 0);
+	if (bus->fd < 0) {
+		return -1;
+	}
+
+	address.sin_family = AF_INET;
+	address.sin_port = htons(port);
+	address.sin_addr.s_addr = inet_addr(HOST_CAN_UDP_GROUP);
+	membership.imr_multiaddr.s_addr = address.sin_addr.s_addr;
+	membership.imr_interface = loopback;
+
+	if (setsockopt(bus->fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) != 0 ||
+			setsockopt(bus->fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) != 0 ||
+			bind(bus->fd, (const struct sockaddr *)&address, sizeof(address)) != 0 ||
+			setsockopt(bus->fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) != 0 ||
+			setsockopt(bus->fd, IPPROTO_IP, IP_MULTICAST_IF, &loopback, sizeof(loopback)) != 0 ||
+			setsockopt(bus->fd, IPPROTO_IP, IP_MULTICAST_LOOP, &enable, sizeof(enable)) != 0) {
+		close(bus->fd);
+		bus->fd = -1;
+		return -1;
+	}
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &now);
+	bus->udp = true;
+	bus->port = port;
+	bus->source = ((uint32_t)getpid() << 16) ^ (uint32_t)now.tv_nsec;
+
+	return 0;
+}
+
+static int host_can_open_socketcan(host_can_t *bus, const char *interface)
+{
+	struct sockaddr_can address = {0};
+	struct ifreq request = {0};
+	int enable = 1;
+
+	bus->fd = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+	if (bus->fd < 0) {
+		return -1;
+	}
+
+	/* Classic only interfaces refuse FD frames, they are then simply not used */
+	(void)setsockopt(bus->fd, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &enable, sizeof(enable));
+
+	snprintf(request.ifr_name, sizeof(request.ifr_name), "%s", interface);
+	if (ioctl(bus->fd, SIOCGIFINDEX, &request) != 0) {
+		close(bus->fd);
+		bus->fd = -1;
+		return -1;
+	}
+
+	address.can_family = AF_CAN;
+	address.can_ifindex = request.ifr_ifindex;
+	if (bind(bus->fd, (const struct sockaddr *)&address, sizeof(address)) != 0) {
+		close(bus->fd);
+		bus->fd = -1;
+		return -1;
+	}
+
+	bus->udp = false;
+
+	return 0;
+}
+
+static int host_can_read_udp(host_can_t *bus, host_can_frame_t *frame)
+{
+	host_can_udp_frame_t datagram;
+	ssize_t size = recv(bus->fd, &datagram, sizeof(datagram), 0);
+
+	if (size < 0) {
+		return -1;
+	}
+
+	if ((size_t)size < offsetof(host_can_udp_frame_t, data) || datagram.magic != HOST_CAN_UDP_MAGIC ||
+			datagram.source == bus->source || datagram.length > HOST_CAN_MAX_DATA_LENGTH ||
+			(size_t)size < offsetof(host_can_udp_frame_t, data) + datagram.length) {
+		return 0;
+	}
+
+	frame->identifier = datagram.identifier;
+	frame->extended = (datagram.flags & HOST_CAN_UDP_FLAG_EXTENDED) != 0U;
+	frame->fd = (datagram.flags & HOST_CAN_UDP_FLAG_FD) != 0U;
+	frame->length = datagram.length;
+	memcpy(frame->data, datagram.data, datagram.length);
+
+	return 1;
+}
+
+static int host_can_read_socketcan(host_can_t *bus, host_can_frame_t *frame)
+{
+	struct canfd_frame raw;
+	ssize_t size = read(bus->fd, &raw, sizeof(raw));
+
+	if (size < 0) {
+		return -1;
+	}
+
+	if ((size != CAN_MTU && size != CANFD_MTU) || (raw.can_id & (CAN_RTR_FLAG | CAN_ERR_FLAG)) != 0U) {
+		return 0;
+	}
+
+	frame->extended = (raw.can_id & CAN_EFF_FLAG) != 0U;
+	frame->identifier = raw.can_id & (frame->extended ? CAN_EFF_MASK : CAN_SFF_MASK);
+	frame->fd = (size == CANFD_MTU);
+	frame->length = (raw.len > HOST_CAN_MAX_DATA_LENGTH) ? HOST_CAN_MAX_DATA_LENGTH : raw.len;
+	memcpy(frame->data, raw.data, frame->length);
+
+	return 1;
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/**
+ * @brief Join the bus "udp[:<port>]" or the SocketCAN interface of that name.
+ * @return 0, or -1 with errno set.
+ */
+int host_can_open(host_can_t *bus, const char *name)
+{
+	memset(bus, 0, sizeof(*bus));
+	bus->fd = -1;
+
+	if (strcmp(name, "udp") == 0) {
+		return host_can_open_udp(bus, HOST_CAN_UDP_DEFAULT_PORT);
+	}
+
+	if (strncmp(name, "udp:", 4) == 0) {
+		char *end;
+		unsigned long port = strtoul(&name[4], &end, 10);
+
+		if (*end != '\0' || port == 0UL || port > 0xFFFFUL) {
+			errno = EINVAL;
+			return -1;
+		}
+		return host_can_open_udp(bus, (uint16_t)port);
+	}
+
+	return host_can_open_socketcan(bus, name);
+}
+
+void host_can_close(host_can_t *bus)
+{
+	if (bus->fd >= 0) {
+		close(bus->fd);
+		bus->fd = -1;
+	}
+}
+
+/**
+ * @return 0, or -1 with errno set.
+ */
+int host_can_send(host_can_t *bus, const host_can_frame_t *frame)
+{
+	if (frame->length > (frame->fd ? HOST_CAN_MAX_DATA_LENGTH : 8U)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (bus->udp) {
+		host_can_udp_frame_t datagram = {0};
+		struct sockaddr_in address = {0};
+		size_t size = offsetof(host_can_udp_frame_t, data) + frame->length;
+
+		datagram.magic = HOST_CAN_UDP_MAGIC;
+		datagram.source = bus->source;
+		datagram.identifier = frame->identifier;
+		datagram.flags = (frame->extended ? HOST_CAN_UDP_FLAG_EXTENDED : 0U) | (frame->fd ? HOST_CAN_UDP_FLAG_FD : 0U);
+		datagram.length = frame->length;
+		memcpy(datagram.data, frame->data, frame->length);
+
+		address.sin_family = AF_INET;
+		address.sin_port = htons(bus->port);
+		address.sin_addr.s_addr = inet_addr(HOST_CAN_UDP_GROUP);
+
+		return (sendto(bus->fd, &datagram, size, 0, (const struct sockaddr *)&address, sizeof(address)) == (ssize_t)size) ? 0 : -1;
+	}
+
+	struct canfd_frame raw = {0};
+	size_t size = frame->fd ? CANFD_MTU : CAN_MTU;
+
+	raw.can_id = frame->identifier | (frame->extended ? CAN_EFF_FLAG : 0U);
+	raw.len = frame->length;
+	memcpy(raw.data, frame->data, frame->length);
+
+	return (write(bus->fd, &raw, size) == (ssize_t)size) ? 0 : -1;
+}
+
+/**
+ * @brief Wait up to timeout_ms (-1: forever) for a frame.
+ * @return 1 when a frame was received, 0 on timeout, -1 on error.
+ */
+int host_can_receive(host_can_t *bus, host_can_frame_t *frame, int timeout_ms)
+{
+	int64_t deadline = host_can_now_ms() + timeout_ms;
+
+	for (;;) {
+		struct pollfd poll_fd = { .fd = bus->fd, .events = POLLIN };
+		int wait_ms = timeout_ms;
+
+		if (timeout_ms > 0) {
+			int64_t left = deadline - host_can_now_ms();
+			wait_ms = (left > 0) ? (int)left : 0;
+		}
+
+		int ready = poll(&poll_fd, 1, wait_ms);
+		if (ready < 0 && errno != EINTR) {
+			return -1;
+		}
+		if (ready <= 0) {
+			if (ready == 0 || timeout_ms == 0) {
+				return 0;
+			}
+			continue;
+		}
+
+		int result = bus->udp ? host_can_read_udp(bus, frame) : host_can_read_socketcan(bus, frame);
+		if (result != 0) {
+			return result;
+		}
+		if (timeout_ms == 0) {
+			return 0;
+		}
+	}
+}
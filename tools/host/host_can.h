@@ -0,0 +1,43 @@
+/**
+ * @file host_can.h
+ * @brief CAN access for the host tools
+ * @details Two kinds of bus, chosen by name:
+ *            udp[:<port>]  a bus between processes of this machine: every frame is a
+ *                          UDP datagram to a multicast group on the loopback
+ *                          interface, received by all the other members.
+ *            <interface>   a SocketCAN interface (can0, vcan0, ...), real or virtual.
+ *          A member never receives its own frames, as on a CAN bus.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+/* General defines ------------------------------------------------------------------*/
+#define HOST_CAN_UDP_DEFAULT_PORT           29536U
+#define HOST_CAN_MAX_DATA_LENGTH            64U
+
+/* Public Types ---------------------------------------------------------------------*/
+typedef struct {
+	uint32_t identifier;
+	bool extended;
+	bool fd;
+	uint8_t length;
+	uint8_t data[HOST_CAN_MAX_DATA_LENGTH];
+} host_can_frame_t;
+
+typedef struct {
+	int fd;
+	bool udp;
+	uint32_t source;                        /* UDP: tag of the frames of this member */
+	uint16_t port;
+} host_can_t;
+
+/* Public Functions ------------------------------------------------------------------*/
+int host_can_open(host_can_t *bus, const char *name);
+void host_can_close(host_can_t *bus);
+int host_can_send(host_can_t *bus, const host_can_frame_t *frame);
+int host_can_receive(host_can_t *bus, host_can_frame_t *frame, int timeout_ms);
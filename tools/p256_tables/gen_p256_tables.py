@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+"""Generate the fixed-key comb tables used by services/crypto/p256_verify.c.
+
+The public keys are read from Core/Src/main.c (every `public_key_t public_key`
+definition, one per board), so the tables follow the keys without manual edits.
+A test key and a signature made with it are also emitted for the benchmark,
+only compiled with BOOTLOADER_BENCHMARK.
+
+Run from anywhere after changing a key:
+    python3 tools/p256_tables/gen_p256_tables.py
+"""
+
+import hashlib
+import os
+import re
+import sys
+
+P = 0xFFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF
+N = 0xFFFFFFFF00000000FFFFFFFFFFFFFFFFBCE6FAADA7179E84F3B9CAC2FC632551
+B = 0x5AC635D8AA3A93E7B3EBBD55769886BC651D06B0CC53B0F63BCE3C3E27D2604B
+G = (0x6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296,
+     0x4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5)
+
+COMB_TEETH = 4
+COMB_SPACING = 256 // COMB_TEETH
+R = 1 << 256
+
+REPO_ROOT = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..'))
+MAIN_C = os.path.join(REPO_ROOT, 'Core', 'Src', 'main.c')
+TABLES_C = os.path.join(REPO_ROOT, 'services', 'crypto', 'p256_tables.c')
+VECTOR_H = os.path.join(REPO_ROOT, 'services', 'bench', 'bench_ecdsa_vector.h')
+
+# Test key only, never used to sign firmware
+TEST_PRIVATE_KEY = int(hashlib.sha256(b'varg bootloader p256 benchmark key').hexdigest(), 16) % N
+TEST_MESSAGE = b'varg bootloader p256 benchmark message'
+
+
+def on_curve(point):
+    x, y = point
+    return (y * y - (x * x * x - 3 * x + B)) % P == 0
+
+
+def add(p1, p2):
+    if p1 is None:
+        return p2
+    if p2 is None:
+        return p1
+    if p1[0] == p2[0]:
+        if (p1[1] + p2[1]) % P == 0:
+            return None
+        lam = (3 * p1[0] * p1[0] - 3) * pow(2 * p1[1], -1, P) % P
+    else:
+        lam = (p2[1] - p1[1]) * pow(p2[0] - p1[0], -1, P) % P
+    x = (lam * lam - p1[0] - p2[0]) % P
+    return (x, (lam * (p1[0] - x) - p1[1]) % P)
+
+
+def mul(k, point):
+    result = None
+    while k:
+        if k & 1:
+            result = add(result, point)
+        point = add(point, point)
+        k >>= 1
+    return result
+
+
+def comb_table(point):
+    """table[i - 1] = sum over the set bits j of i of 2^(64 j) * point, i = 1..15"""
+    bases = [mul(1 << (COMB_SPACING * j), point) for j in range(COMB_TEETH)]
+    table = []
+    for i in range(1, 1 << COMB_TEETH):
+        acc = None
+        for j in range(COMB_TEETH):
+            if i & (1 << j):
+                acc = add(acc, bases[j])
+        table.append(acc)
+    return table
+
+
+def limbs(value):
+    return [(value >> (32 * i)) & 0xFFFFFFFF for i in range(8)]
+
+
+def c_words(value):
+    return '{ ' + ', '.join('0x%08X' % w for w in limbs(value)) + ' }'
+
+
+def c_bytes(data, indent):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append(indent + ', '.join('0x%02x' % b for b in data[i:i + 16]) + ',')
+    return '\n'.join(lines)
+
+
+def c_table(table, indent):
+    # Affine points in the Montgomery domain of the field, as used by p256_verify.c
+    return '\n'.join('%s{ %s,\n%s  %s },' % (indent, c_words(x * R % P), indent, c_words(y * R % P))
+                     for x, y in table)
+
+
+def read_public_keys():
+    source = open(MAIN_C).read()
+    keys = []
+    for match in re.finditer(r'public_key_t\s+public_key\s*=\s*\{\s*\.key\s*=\s*\{([^}]*)\}', source):
+        data = bytes(int(b, 16) for b in re.findall(r'0x([0-9a-fA-F]{2})', match.group(1)))
+        if len(data) != 64:
+            sys.exit('public key in main.c is not 64 bytes')
+        point = (int.from_bytes(data[:32], 'big'), int.from_bytes(data[32:], 'big'))
+        if not on_curve(point):
+            sys.exit('public key %s is not on P-256' % data.hex())
+        keys.append((data, point))
+    if not keys:
+        sys.exit('no public key found in %s' % MAIN_C)
+    return keys
+
+
+def sign(private_key, message):
+    digest = hashlib.sha256(message).digest()
+    e = int.from_bytes(digest, 'big')
+    # Deterministic nonce, good enough for a test vector
+    k = int.from_bytes(hashlib.sha256(private_key.to_bytes(32, 'big') + digest).digest(), 'big') % N
+    r = mul(k, G)[0] % N
+    s = pow(k, -1, N) * (e + r * private_key) % N
+    return digest, r.to_bytes(32, 'big') + s.to_bytes(32, 'big')
+
+
+def key_entry(data, point, indent):
+    return ('%s{\n%s    .public_key = {\n%s\n%s    },\n%s    .table = {\n%s\n%s    },\n%s},'
+            % (indent, indent, c_bytes(data, indent + '        '), indent, indent,
+               c_table(comb_table(point), indent + '        '), indent, indent))
+
+
+def main():
+    keys = read_public_keys()
+    test_point = mul(TEST_PRIVATE_KEY, G)
+    test_key = test_point[0].to_bytes(32, 'big') + test_point[1].to_bytes(32, 'big')
+    digest, signature = sign(TEST_PRIVATE_KEY, TEST_MESSAGE)
+
+    with open(TABLES_C, 'w', newline='\n') as out:
+        out.write('''/**
+ * @file p256_tables.c
+ * @brief Comb tables for P-256 verification with fixed keys
+ * @details Generated by tools/p256_tables/gen_p256_tables.py from the public keys
+ *          in main.c, do not edit. Points are affine, in the Montgomery domain.
+ */
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "p256_tables.h"
+
+/* Public Variables -----------------------------------------------------------------*/
+const p256_affine_t p256_base_table[P256_COMB_TABLE_SIZE] = {
+%s
+};
+
+const p256_fixed_key_t p256_fixed_keys[] = {
+%s
+#ifdef BOOTLOADER_BENCHMARK
+    /* Benchmark test key */
+%s
+#endif
+};
+
+const uint32_t p256_fixed_key_count = sizeof(p256_fixed_keys) / sizeof(p256_fixed_keys[0]);
+''' % (c_table(comb_table(G), '    '),
+       '\n'.join(key_entry(data, point, '    ') for data, point in keys),
+       key_entry(test_key, test_point, '    ')))
+
+    with open(VECTOR_H, 'w', newline='\n') as out:
+        out.write('''/**
+ * @file bench_ecdsa_vector.h
+ * @brief P-256 signature made with the benchmark test key
+ * @details Generated by tools/p256_tables/gen_p256_tables.py, do not edit.
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Public Variables -----------------------------------------------------------------*/
+static const uint8_t bench_ecdsa_public_key[64] = {
+%s
+};
+
+/* SHA-256("%s") */
+static const uint8_t bench_ecdsa_hash[32] = {
+%s
+};
+
+static const uint8_t bench_ecdsa_signature[64] = {
+%s
+};
+''' % (c_bytes(test_key, '    '), TEST_MESSAGE.decode(), c_bytes(digest, '    '), c_bytes(signature, '    ')))
+
+    print('%d board key(s) -> %s' % (len(keys), os.path.relpath(TABLES_C, REPO_ROOT)))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,46 @@
+/**
+ * @file crc.c
+ * @brief Host CRC32 of the virtual ECU
+ * @date 19/10/2026
+ */
+
+/* Private Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include "crc.h"
+
+/* Static Variables -----------------------------------------------------------------*/
+static uint32_t crc32_table[256];
+
+/* Private Functions ----------------------------------------------------------------*/
+static void crc32_table_init(void)
+{
+	for (uint32_t i = 0; i < 256U; i++) {
+		uint32_t crc = i << 24;
+
+		for (uint32_t bit = 0; bit < 8U; bit++) {
+			crc = ((crc & 0x80000000U) != 0U) ? ((crc << 1) ^ 0x04C11DB7U) : (crc << 1);
+		}
+		crc32_table[i] = crc;
+	}
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+uint32_t crc32_continue(uint32_t crc, const void *data, uint32_t size)
+{
+	const uint8_t *bytes = (const uint8_t *)data;
+
+	if (crc32_table[1] == 0U) {
+		crc32_table_init();
+	}
+
+	for (uint32_t i = 0; i < size; i++) {
+		crc = (crc << 8) ^ crc32_table[(crc >> 24) ^ bytes[i]];
+	}
+
+	return crc;
+}
+
+uint32_t crc32_continue_dma(uint32_t crc, const void *data, uint32_t size)
+{
+	return crc32_continue(crc, data, size);
+}
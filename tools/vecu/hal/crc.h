@@ -0,0 +1,21 @@
+/**
+ * @file crc.h
+ * @brief Host CRC32 of the virtual ECU
+ * @details Stands for Core/Inc/crc.h: the same CRC as the CRC unit set up in
+ *          MX_CRC_Init() (polynomial 0x04C11DB7, no reflection, no final XOR),
+ *          computed in software.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+/* General defines ------------------------------------------------------------------*/
+#define CRC32_INIT_VALUE                    0xFFFFFFFFU
+
+/* Public Functions ------------------------------------------------------------------*/
+uint32_t crc32_continue(uint32_t crc, const void *data, uint32_t size);
+uint32_t crc32_continue_dma(uint32_t crc, const void *data, uint32_t size);
@@ -0,0 +1,29 @@
+/**
+ * @file mem_cache.c
+ * @brief Host stand-in of the FLASH instruction cache
+ * @details There is no cache to keep coherent with the mapped FLASH file.
+ * @date 19/10/2026
+ */
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "mem_cache.h"
+
+/* Public Functions -----------------------------------------------------------------*/
+void mem_cache_init(void)
+{
+}
+
+void mem_cache_deinit(void)
+{
+}
+
+void mem_cache_enable(bool enable)
+{
+	(void)enable;
+}
+
+void mem_cache_invalidate_range(uint32_t address, uint32_t size)
+{
+	(void)address;
+	(void)size;
+}
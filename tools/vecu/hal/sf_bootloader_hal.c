@@ -0,0 +1,95 @@
+/**
+ * @file sf_bootloader_hal.c
+ * @brief Host bootloader HAL of the virtual ECU
+ * @date 19/10/2026
+ */
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "sf_bootloader_hal.h"
+#include "sf_can_hal.h"
+#include "can_message_handler.h"
+#include "crc.h"
+#include "timebase.h"
+
+/* Private defines ------------------------------------------------------------------*/
+#define FDCAN_PERIPHERAL                    1
+
+/* Private Functions ----------------------------------------------------------------*/
+static uint32_t sf_bootloader_hal_identifier(data_comm_msg_type_t type)
+{
+	switch (type) {
+		case DATA_COMM_MSG_TYPE_READY_REPORT:
+			return CAN_MSG_SEND_READY_REPORT_ID;
+		case DATA_COMM_MSG_TYPE_BURST_REQUEST:
+			return CAN_MSG_SEND_BURST_REQUEST_ID;
+		case DATA_COMM_MSG_TYPE_COMPLETION:
+			return CAN_MSG_SEND_COMPLETION_MESSAGE_ID;
+		case DATA_COMM_MSG_TYPE_ERROR:
+			return CAN_MSG_SEND_ERROR_MESSAGE_ID;
+		case DATA_COMM_MSG_TYPE_FINISH_REPORT:
+			return CAN_MSG_SEND_FINISH_REPORT_ID;
+		default:
+			return 0U;
+	}
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+void sf_bootloader_hal_init(void)
+{
+}
+
+/**
+ * @brief The application cannot run on the host: report the jump and exit.
+ */
+void sf_bootloader_hal_jump_to_app(uint32_t address)
+{
+	printf("jump to application at 0x%08x\n", address);
+	exit(EXIT_SUCCESS);
+}
+
+uint32_t sf_bootloader_hal_crc32_func(const void *data, uint32_t size)
+{
+	return crc32_continue(CRC32_INIT_VALUE, data, size);
+}
+
+/* Follows the microsecond timebase, as on target once TIM2 runs */
+uint32_t sf_bootloader_hal_get_1ms_counter(void)
+{
+	return timebase_ms();
+}
+
+/**
+ * @brief Send a bootloader message: the ECU code, then data and extra.
+ * @return 0, or -1 for an unknown type or a payload longer than a classic frame.
+ */
+int sf_bootloader_hal_send_bootloader_message(data_comm_msg_type_t type, uint8_t ecu_id,
+		const uint8_t *data, uint16_t size, const uint8_t *extra, uint16_t extra_size, void *context)
+{
+	can_message_tx_t frame = {0};
+	uint32_t identifier = sf_bootloader_hal_identifier(type);
+
+	(void)context;
+
+	if (identifier == 0U || (CAN_MSG_ECU_CODE_SIZE + size + extra_size) > CAN_MSG_MAX_LENGTH) {
+		return -1;
+	}
+
+	frame.identifier = identifier;
+	frame.identifier_type = SF_FDCAN_EXTENDED_ID;
+	frame.tx_frame_type = SF_FDCAN_DATA_FRAME;
+	frame.data_length = CAN_MSG_ECU_CODE_SIZE + size + extra_size;
+	frame.data[CAN_MSG_ECU_CODE_BYTE_INDEX] = ecu_id;
+	if (size != 0U) {
+		memcpy(&frame.data[CAN_MSG_RECV_DATA_OFFSET], data, size);
+	}
+	if (extra_size != 0U) {
+		memcpy(&frame.data[CAN_MSG_RECV_DATA_OFFSET + size], extra, extra_size);
+	}
+
+	return (sf_can_send_message(FDCAN_PERIPHERAL, frame) == CAN_STATUS_OK) ? 0 : -1;
+}
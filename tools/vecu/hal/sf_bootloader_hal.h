@@ -0,0 +1,22 @@
+/**
+ * @file sf_bootloader_hal.h
+ * @brief Host bootloader HAL of the virtual ECU
+ * @details Same API as the bootloader HAL of sf_hal_stm32h5. Bootloader messages
+ *          are sent as CAN frames whose first byte is the ECU code, like the
+ *          requests of the tester. The jump to the application ends the process.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "bootloader.h"
+
+/* Public Functions ------------------------------------------------------------------*/
+void sf_bootloader_hal_init(void);
+void sf_bootloader_hal_jump_to_app(uint32_t address);
+uint32_t sf_bootloader_hal_crc32_func(const void *data, uint32_t size);
+uint32_t sf_bootloader_hal_get_1ms_counter(void);
+int sf_bootloader_hal_send_bootloader_message(data_comm_msg_type_t type, uint8_t ecu_id,
+		const uint8_t *data, uint16_t size, const uint8_t *extra, uint16_t extra_size, void *context);
@@ -0,0 +1,413 @@
+/**
+ * @file sf_can_hal.c
+ * @brief Host CAN HAL of the virtual ECU
+ * @details Frames are read from the bus by sf_can_host_receive(), called while the
+ *          main loop sleeps: accepted ones are queued and signalled as the FDCAN
+ *          interrupt does. A full queue drops the frame, like an RX FIFO overrun.
+ *
+ *          Builds with TIMEBASE_SIMULATED (vecu_sim) take the bus "sim:<fd>" instead,
+ *          the link to the bus simulator, and follow its time: see cansim_link.h.
+ *          They also take "replay:<trace>", a trace in the format of candump -l
+ *          (can_log.h): its frames are received at the simulated time of the trace,
+ *          from the first receive on, and the time jumps over the gaps, so that a
+ *          captured session runs at the speed of the host. The frames the bootloader
+ *          sends are left out of the input, they are its expected output: the ECU
+ *          writes the frames it sends to stdout in the same format, on the time of
+ *          the trace. A replay ends SF_CAN_HOST_REPLAY_END_US after the last frame.
+ * @date 19/10/2026
+ */
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(TIMEBASE_SIMULATED)
+#include <unistd.h>
+#endif
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "sf_can_hal.h"
+#include "host_can.h"
+#include "can_message_handler.h"
+#include "event_loop.h"
+#include "update_report.h"
+#include "cansim_link.h"
+#include "timebase.h"
+#if defined(TIMEBASE_SIMULATED)
+#include "can_log.h"
+#endif
+
+/* Private defines ------------------------------------------------------------------*/
+#define SF_CAN_HOST_REPLAY_INTERFACE        "vecu"
+
+/* Private types --------------------------------------------------------------------*/
+typedef struct {
+	FILE *file;
+	host_can_frame_t frame;                 /* Next frame of the trace */
+	uint64_t frame_us;                      /* Its time in the trace */
+	bool pending;                           /* frame holds a frame to receive */
+	bool started;                           /* The time of the trace is set */
+	uint64_t first_us;                      /* Trace time of the first frame */
+	uint32_t base_us;                       /* Simulated time of the first frame */
+	uint32_t end_us;                        /* Simulated time the replay ends, once the trace is read */
+	bool ended;
+	sf_can_host_replay_stats_t stats;
+} sf_can_host_replay_t;
+
+typedef struct {
+	host_can_t bus;
+	int sim_fd;                             /* Link to the bus simulator, -1 on a real bus */
+	sf_can_host_replay_t replay;            /* Trace replayed, file NULL if none */
+	bool open;
+	bool started;
+	bool notify;
+	can_filter_message_t filter;
+	can_general_filter_t general_filter;
+	host_can_frame_t fifo[SF_CAN_HOST_RX_FIFO_SIZE];
+	uint32_t head;
+	uint32_t tail;
+	uint32_t dropped;
+} sf_can_host_t;
+
+/* Static Variables -----------------------------------------------------------------*/
+static sf_can_host_t sf_can_host = { .sim_fd = -1 };
+
+/* Private Functions ----------------------------------------------------------------*/
+#if defined(TIMEBASE_SIMULATED)
+static void sf_can_host_sim_write(cansim_link_type_e type, uint32_t time_us, const host_can_frame_t *frame)
+{
+	cansim_link_message_t message = { .type = type, .time_us = time_us };
+
+	if (frame != NULL) {
+		message.frame = *frame;
+	}
+
+	if (write(sf_can_host.sim_fd, &message, sizeof(message)) != (ssize_t)sizeof(message)) {
+		exit(EXIT_FAILURE);
+	}
+}
+
+/* The simulator answers a wait with a frame, or wakes the ECU up at the time asked */
+static int sf_can_host_sim_receive(host_can_frame_t *frame, int timeout_ms)
+{
+	cansim_link_message_t message;
+
+	sf_can_host_sim_write(CANSIM_LINK_WAIT, timebase_us() + ((uint32_t)timeout_ms * 1000U), NULL);
+
+	/* The simulator is gone, as a powered off ECU would be */
+	if (read(sf_can_host.sim_fd, &message, sizeof(message)) != (ssize_t)sizeof(message)) {
+		exit(EXIT_FAILURE);
+	}
+
+	if (timebase_after(message.time_us, timebase_simulated_us)) {
+		timebase_simulated_us = message.time_us;
+	}
+
+	if (message.type != CANSIM_LINK_FRAME) {
+		return 0;
+	}
+	*frame = message.frame;
+
+	return 1;
+}
+
+/* The frames the bootloader sends, any ECU */
+static bool sf_can_host_replay_output(const host_can_frame_t *frame)
+{
+	switch (frame->identifier) {
+		case CAN_MSG_SEND_ECU_STATUS_PERIODIC_ID:
+		case CAN_MSG_SEND_READY_REPORT_ID:
+		case CAN_MSG_SEND_BURST_REQUEST_ID:
+		case CAN_MSG_SEND_COMPLETION_MESSAGE_ID:
+		case CAN_MSG_SEND_ERROR_MESSAGE_ID:
+		case CAN_MSG_SEND_FINISH_REPORT_ID:
+		case CAN_MSG_SEND_MANIFEST_STATUS_ID:
+		case CAN_MSG_SEND_BOOT_TIMELINE_ID:
+		case CAN_MSG_SEND_LOOP_STATS_ID:
+		case CAN_MSG_SEND_DLOG_ID:
+		case CAN_MSG_SEND_UPDATE_REPORT_ID:
+		case CAN_MSG_SEND_PROFILE_ZONE_ID:
+			return frame->extended;
+		default:
+			return false;
+	}
+}
+
+static void sf_can_host_replay_next(void)
+{
+	sf_can_host_replay_t *replay = &sf_can_host.replay;
+	int result;
+
+	while ((result = can_log_read(replay->file, &replay->frame_us, &replay->frame)) > 0) {
+		if (!sf_can_host_replay_output(&replay->frame)) {
+			replay->pending = true;
+			return;
+		}
+		replay->stats.skipped++;
+	}
+
+	if (result < 0) {
+		fprintf(stderr, "replay: malformed line after %u frames, end of the trace\n", replay->stats.frames);
+	}
+	replay->pending = false;
+}
+
+/* A frame of the trace when its time comes within the wait, the time jumps to it */
+static int sf_can_host_replay_receive(host_can_frame_t *frame, int timeout_ms)
+{
+	sf_can_host_replay_t *replay = &sf_can_host.replay;
+	uint32_t deadline_us = timebase_us() + ((uint32_t)timeout_ms * 1000U);
+
+	if (!replay->started) {
+		replay->started = true;
+		replay->first_us = replay->frame_us;
+		replay->base_us = timebase_us();
+		replay->end_us = replay->base_us + SF_CAN_HOST_REPLAY_END_US;
+	}
+
+	if (!replay->pending) {
+		timebase_simulated_us = deadline_us;
+		replay->ended = !timebase_after(replay->end_us, timebase_simulated_us);
+		return 0;
+	}
+
+	uint32_t due_us = replay->base_us + (uint32_t)(replay->frame_us - replay->first_us);
+
+	if (timebase_after(due_us, deadline_us)) {
+		timebase_simulated_us = deadline_us;
+		return 0;
+	}
+
+	if (timebase_after(due_us, timebase_simulated_us)) {
+		timebase_simulated_us = due_us;
+	}
+	*frame = replay->frame;
+	replay->stats.frames++;
+	replay->end_us = due_us + SF_CAN_HOST_REPLAY_END_US;
+	sf_can_host_replay_next();
+
+	return 1;
+}
+#endif
+
+static int sf_can_host_read(host_can_frame_t *frame, int timeout_ms)
+{
+#if defined(TIMEBASE_SIMULATED)
+	if (sf_can_host.sim_fd >= 0) {
+		return sf_can_host_sim_receive(frame, timeout_ms);
+	}
+	if (sf_can_host.replay.file != NULL) {
+		return sf_can_host_replay_receive(frame, timeout_ms);
+	}
+#endif
+
+	return host_can_receive(&sf_can_host.bus, frame, timeout_ms);
+}
+
+static bool sf_can_host_accepted(const host_can_frame_t *frame)
+{
+	uint32_t identifier_type = frame->extended ? SF_FDCAN_EXTENDED_ID : SF_FDCAN_STANDARD_ID;
+	uint32_t non_matching = frame->extended ? sf_can_host.general_filter.non_matching_ext : sf_can_host.general_filter.non_matching_std;
+
+	if (sf_can_host.filter.filter_config == SF_FDCAN_FILTER_TO_RXFIFO0 &&
+			sf_can_host.filter.identifier_type == identifier_type &&
+			frame->identifier >= sf_can_host.filter.filter_id1 && frame->identifier <= sf_can_host.filter.filter_id2) {
+		return true;
+	}
+
+	return non_matching != SF_FDCAN_REJECT;
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+can_status_e sf_can_configure_filters(uint8_t peripheral, can_filter_message_t filter)
+{
+	(void)peripheral;
+
+	if (filter.filter_type != SF_FDCAN_FILTER_RANGE) {
+		return CAN_STATUS_ERROR;
+	}
+	sf_can_host.filter = filter;
+
+	return CAN_STATUS_OK;
+}
+
+can_status_e sf_can_configure_general_filter(uint8_t peripheral, can_general_filter_t filter)
+{
+	(void)peripheral;
+	sf_can_host.general_filter = filter;
+
+	return CAN_STATUS_OK;
+}
+
+can_status_e sf_can_activate_notification(uint8_t peripheral, can_activate_notification_t notification)
+{
+	(void)peripheral;
+	sf_can_host.notify = (notification.rx_fifo0_interrupts & SF_FDCAN_IT_RX_FIFO0_NEW_MESSAGE) != 0U;
+
+	return CAN_STATUS_OK;
+}
+
+can_status_e sf_can_start(uint8_t peripheral)
+{
+	(void)peripheral;
+
+	if (!sf_can_host.open) {
+		return CAN_STATUS_ERROR;
+	}
+	sf_can_host.started = true;
+
+	return CAN_STATUS_OK;
+}
+
+/* The target sees the frames sent through a --wrap, see update_report.c */
+can_status_e sf_can_send_message(uint8_t peripheral, can_message_tx_t frame)
+{
+	host_can_frame_t host_frame = {0};
+
+	(void)peripheral;
+
+	if (!sf_can_host.started || frame.data_length > MAX_DATA_LENGTH) {
+		return CAN_STATUS_ERROR;
+	}
+
+	update_report_tx(frame.identifier, frame.data, frame.data_length);
+
+	host_frame.identifier = frame.identifier;
+	host_frame.extended = (frame.identifier_type == SF_FDCAN_EXTENDED_ID);
+	host_frame.fd = (frame.data_length > 8U);
+	host_frame.length = (uint8_t)frame.data_length;
+	memcpy(host_frame.data, frame.data, frame.data_length);
+
+#if defined(TIMEBASE_SIMULATED)
+	if (sf_can_host.sim_fd >= 0) {
+		sf_can_host_sim_write(CANSIM_LINK_SEND, timebase_us(), &host_frame);
+		return CAN_STATUS_OK;
+	}
+	if (sf_can_host.replay.file != NULL) {
+		const sf_can_host_replay_t *replay = &sf_can_host.replay;
+
+		sf_can_host.replay.stats.sent++;
+		return (can_log_write(stdout, replay->first_us + (uint32_t)(timebase_us() - replay->base_us),
+				SF_CAN_HOST_REPLAY_INTERFACE, &host_frame) == 0) ? CAN_STATUS_OK : CAN_STATUS_ERROR;
+	}
+#endif
+
+	return (host_can_send(&sf_can_host.bus, &host_frame) == 0) ? CAN_STATUS_OK : CAN_STATUS_ERROR;
+}
+
+can_status_e sf_can_get_last_rx_filtered_message(can_message_rx_t *frame)
+{
+	if (sf_can_host.head == sf_can_host.tail) {
+		return CAN_STATUS_EMPTY;
+	}
+
+	const host_can_frame_t *host_frame = &sf_can_host.fifo[sf_can_host.tail % SF_CAN_HOST_RX_FIFO_SIZE];
+
+	frame->identifier = host_frame->identifier;
+	frame->identifier_type = host_frame->extended ? SF_FDCAN_EXTENDED_ID : SF_FDCAN_STANDARD_ID;
+	frame->data_length = host_frame->length;
+	memcpy(frame->data, host_frame->data, host_frame->length);
+	sf_can_host.tail++;
+
+	return CAN_STATUS_OK;
+}
+
+/**
+ * @brief Join the bus, see host_can_open(), the bus simulator or a trace to replay.
+ */
+int sf_can_host_open(const char *bus)
+{
+	if (strncmp(bus, CANSIM_LINK_BUS_PREFIX, strlen(CANSIM_LINK_BUS_PREFIX)) == 0) {
+#if defined(TIMEBASE_SIMULATED)
+		sf_can_host.sim_fd = atoi(&bus[strlen(CANSIM_LINK_BUS_PREFIX)]);
+		sf_can_host.open = true;
+		return 0;
+#else
+		fprintf(stderr, "%s: the bus simulator needs the vecu_sim build\n", bus);
+		return -1;
+#endif
+	}
+
+	if (strncmp(bus, SF_CAN_HOST_REPLAY_PREFIX, strlen(SF_CAN_HOST_REPLAY_PREFIX)) == 0) {
+#if defined(TIMEBASE_SIMULATED)
+		const char *path = &bus[strlen(SF_CAN_HOST_REPLAY_PREFIX)];
+
+		sf_can_host.replay.file = fopen(path, "r");
+		if (sf_can_host.replay.file == NULL) {
+			perror(path);
+			return -1;
+		}
+		sf_can_host_replay_next();
+		sf_can_host.open = true;
+		return 0;
+#else
+		fprintf(stderr, "%s: a replay needs the vecu_sim build\n", bus);
+		return -1;
+#endif
+	}
+
+	if (host_can_open(&sf_can_host.bus, bus) != 0) {
+		perror(bus);
+		return -1;
+	}
+	sf_can_host.open = true;
+
+	return 0;
+}
+
+/**
+ * @brief Queue the frames received within timeout_ms, the first one ends the wait.
+ * @return true if a frame was queued.
+ */
+bool sf_can_host_receive(int timeout_ms)
+{
+	host_can_frame_t frame;
+	bool queued = false;
+
+	while (sf_can_host.started && sf_can_host_read(&frame, queued ? 0 : timeout_ms) > 0) {
+		if (!sf_can_host_accepted(&frame)) {
+			continue;
+		}
+
+		if ((sf_can_host.head - sf_can_host.tail) == SF_CAN_HOST_RX_FIFO_SIZE) {
+			sf_can_host.dropped++;
+			continue;
+		}
+
+		sf_can_host.fifo[sf_can_host.head % SF_CAN_HOST_RX_FIFO_SIZE] = frame;
+		sf_can_host.head++;
+		queued = true;
+	}
+
+	if (queued && sf_can_host.notify) {
+		can_message_handler_rx_irq();
+		event_loop_post(EVENT_LOOP_CAN_RX);
+	}
+
+	return queued;
+}
+
+/**
+ * @brief Frames lost to a full queue.
+ */
+uint32_t sf_can_host_dropped(void)
+{
+	return sf_can_host.dropped;
+}
+
+/**
+ * @brief Whether the replay of a trace is over, false on a bus.
+ */
+bool sf_can_host_replay_ended(void)
+{
+	return sf_can_host.replay.ended;
+}
+
+/**
+ * @brief Frames of the trace replayed, the statistics are zero on a bus.
+ */
+void sf_can_host_replay_get_stats(sf_can_host_replay_stats_t *stats)
+{
+	*stats = sf_can_host.replay.stats;
+	stats->simulated_us = sf_can_host.replay.started ? (timebase_us() - sf_can_host.replay.base_us) : 0U;
+}
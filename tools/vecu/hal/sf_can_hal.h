@@ -0,0 +1,118 @@
+/**
+ * @file sf_can_hal.h
+ * @brief Host CAN HAL of the virtual ECU
+ * @details Same API as the FDCAN HAL of sf_hal_stm32h5, over a host_can bus. The
+ *          range filter and the general filter are applied in software, accepted
+ *          frames are queued like in the RX FIFO 0.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+
+/* General defines ------------------------------------------------------------------*/
+#define MAX_DATA_LENGTH                     64U
+#define SF_CAN_HOST_RX_FIFO_SIZE            64U
+#define SF_CAN_HOST_REPLAY_PREFIX           "replay:"
+#define SF_CAN_HOST_REPLAY_END_US           1000000U    /* Run after the last frame of a trace */
+
+/* Public Types ---------------------------------------------------------------------*/
+typedef enum {
+	CAN_STATUS_OK = 0,
+	CAN_STATUS_ERROR,
+	CAN_STATUS_EMPTY,
+} can_status_e;
+
+enum {
+	SF_FDCAN_STANDARD_ID = 0,
+	SF_FDCAN_EXTENDED_ID,
+};
+
+enum {
+	SF_FDCAN_DATA_FRAME = 0,
+	SF_FDCAN_REMOTE_FRAME,
+};
+
+enum {
+	SF_FDCAN_ACCEPT_IN_RX_FIFO0 = 0,
+	SF_FDCAN_REJECT,
+};
+
+enum {
+	SF_FDCAN_FILTER_REMOTE = 0,
+	SF_FDCAN_REJECT_REMOTE,
+};
+
+enum {
+	SF_FDCAN_FILTER_RANGE = 0,
+	SF_FDCAN_FILTER_DUAL,
+};
+
+enum {
+	SF_FDCAN_FILTER_TO_RXFIFO0 = 0,
+	SF_FDCAN_FILTER_DISABLE,
+};
+
+enum {
+	SF_FDCAN_IT_RX_FIFO0_NEW_MESSAGE = 1,
+};
+
+typedef struct {
+	uint32_t identifier;
+	uint32_t identifier_type;
+	uint32_t data_length;
+	uint8_t *data;                          /* MAX_DATA_LENGTH bytes, provided by the caller */
+} can_message_rx_t;
+
+typedef struct {
+	uint32_t identifier;
+	uint32_t identifier_type;
+	uint32_t tx_frame_type;
+	uint32_t data_length;
+	uint8_t data[MAX_DATA_LENGTH];
+} can_message_tx_t;
+
+typedef struct {
+	uint32_t identifier_type;
+	uint32_t filter_index;
+	uint32_t filter_type;
+	uint32_t filter_config;
+	uint32_t filter_id1;
+	uint32_t filter_id2;
+} can_filter_message_t;
+
+typedef struct {
+	uint32_t non_matching_std;
+	uint32_t non_matching_ext;
+	uint32_t reject_remote_std;
+	uint32_t reject_remote_ext;
+} can_general_filter_t;
+
+typedef struct {
+	uint32_t rx_fifo0_interrupts;
+} can_activate_notification_t;
+
+typedef struct {
+	uint32_t frames;                        /* Frames of the trace received */
+	uint32_t skipped;                       /* Frames of the bootloaders left out */
+	uint32_t sent;                          /* Frames sent by the ECU */
+	uint32_t simulated_us;                  /* Simulated time from the first frame */
+} sf_can_host_replay_stats_t;
+
+/* Public Functions ------------------------------------------------------------------*/
+can_status_e sf_can_configure_filters(uint8_t peripheral, can_filter_message_t filter);
+can_status_e sf_can_configure_general_filter(uint8_t peripheral, can_general_filter_t filter);
+can_status_e sf_can_activate_notification(uint8_t peripheral, can_activate_notification_t notification);
+can_status_e sf_can_start(uint8_t peripheral);
+can_status_e sf_can_send_message(uint8_t peripheral, can_message_tx_t frame);
+can_status_e sf_can_get_last_rx_filtered_message(can_message_rx_t *frame);
+
+/* Host only */
+int sf_can_host_open(const char *bus);
+bool sf_can_host_receive(int timeout_ms);
+uint32_t sf_can_host_dropped(void);
+bool sf_can_host_replay_ended(void);
+void sf_can_host_replay_get_stats(sf_can_host_replay_stats_t *stats);
@@ -0,0 +1,202 @@
+/**
+ * @file sf_flash_hal.c
+ * @brief Host FLASH HAL of the virtual ECU
+ * @details A missing file is created erased. The mapping is shared, every program
+ *          and erase is in the file as soon as the call returns, so the content
+ *          survives the process like the FLASH survives a reset. With a simulated
+ *          timebase the erase and program times are added to it instead of waited.
+ * @date 19/10/2026
+ */
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "sf_flash_hal.h"
+#include "mem.h"
+#include "update_report.h"
+#if defined(TIMEBASE_SIMULATED)
+#include "timebase.h"
+#endif
+
+/* Private defines ------------------------------------------------------------------*/
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE                 0x100000
+#endif
+
+/* Private types --------------------------------------------------------------------*/
+typedef struct {
+	uint8_t *memory;
+	uint32_t size;
+	uint32_t erase_us;                      /* Per sector */
+	uint32_t program_us;                    /* Per quad-word */
+} sf_flash_host_t;
+
+/* Static Variables -----------------------------------------------------------------*/
+static sf_flash_host_t sf_flash_host;
+
+/* Private Functions ----------------------------------------------------------------*/
+static bool sf_flash_host_in_range(uint32_t address, uint32_t size)
+{
+	return sf_flash_host.memory != NULL && address >= SF_FLASH_HOST_BASE_ADDRESS &&
+			size <= sf_flash_host.size && (address - SF_FLASH_HOST_BASE_ADDRESS) <= (sf_flash_host.size - size);
+}
+
+static void sf_flash_host_busy(uint64_t duration_us)
+{
+#if defined(TIMEBASE_SIMULATED)
+	timebase_simulated_us += (uint32_t)duration_us;
+#else
+	struct timespec start;
+	struct timespec now;
+
+	if (duration_us == 0U) {
+		return;
+	}
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &start);
+	do {
+		(void)clock_gettime(CLOCK_MONOTONIC, &now);
+	} while ((uint64_t)((now.tv_sec - start.tv_sec) * 1000000L + (now.tv_nsec - start.tv_nsec) / 1000L) < duration_us);
+#endif
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+int sf_flash_check(uint32_t address, uint32_t size, void *context)
+{
+	(void)context;
+
+	return sf_flash_host_in_range(address, size) ? SF_FLASH_STATUS_OK : SF_FLASH_STATUS_ERROR;
+}
+
+int sf_flash_get_page_index(uint32_t address, void *context)
+{
+	(void)context;
+
+	if (!sf_flash_host_in_range(address, 1U)) {
+		return -1;
+	}
+
+	return (int)((address - SF_FLASH_HOST_BASE_ADDRESS) / MEM_FLASH_SECTOR_SIZE);
+}
+
+int sf_flash_erase_page(uint32_t page, void *context)
+{
+	uint32_t address = SF_FLASH_HOST_BASE_ADDRESS + (page * MEM_FLASH_SECTOR_SIZE);
+
+	(void)context;
+
+	if (!sf_flash_host_in_range(address, MEM_FLASH_SECTOR_SIZE)) {
+		return SF_FLASH_STATUS_ERROR;
+	}
+
+	/* The target times the erase through a --wrap of HAL_FLASHEx_Erase() */
+	update_report_stage_begin(UPDATE_REPORT_STAGE_ERASE);
+	memset(&sf_flash_host.memory[address - SF_FLASH_HOST_BASE_ADDRESS], 0xFF, MEM_FLASH_SECTOR_SIZE);
+	sf_flash_host_busy(sf_flash_host.erase_us);
+	update_report_stage_end();
+
+	return SF_FLASH_STATUS_OK;
+}
+
+int sf_flash_read(uint32_t address, void *data, uint32_t size, void *context)
+{
+	(void)context;
+
+	if (!sf_flash_host_in_range(address, size)) {
+		return SF_FLASH_STATUS_ERROR;
+	}
+
+	memcpy(data, &sf_flash_host.memory[address - SF_FLASH_HOST_BASE_ADDRESS], size);
+
+	return SF_FLASH_STATUS_OK;
+}
+
+/**
+ * @brief Program whole quad-words, each one must be erased.
+ */
+int sf_flash_write(uint32_t address, const void *data, uint32_t size, void *context)
+{
+	uint8_t *destination = &sf_flash_host.memory[address - SF_FLASH_HOST_BASE_ADDRESS];
+
+	(void)context;
+
+	if (!sf_flash_host_in_range(address, size) || (address % MEM_FLASH_QUAD_WORD_SIZE) != 0U ||
+			(size % MEM_FLASH_QUAD_WORD_SIZE) != 0U) {
+		return SF_FLASH_STATUS_ERROR;
+	}
+
+	for (uint32_t i = 0; i < size; i++) {
+		if (destination[i] != 0xFFU) {
+			fprintf(stderr, "flash: 0x%08x programmed twice\n", address + i);
+			return SF_FLASH_STATUS_ERROR;
+		}
+	}
+
+	memcpy(destination, data, size);
+	sf_flash_host_busy((uint64_t)sf_flash_host.program_us * (size / MEM_FLASH_QUAD_WORD_SIZE));
+
+	return SF_FLASH_STATUS_OK;
+}
+
+/**
+ * @brief Map size bytes of the file at the FLASH address, created erased if needed.
+ * @return 0, or -1 if the file or the mapping failed.
+ */
+int sf_flash_host_open(const char *path, uint32_t size)
+{
+	struct stat status;
+	int fd = open(path, O_RDWR | O_CREAT, 0644);
+
+	if (fd < 0 || fstat(fd, &status) != 0) {
+		perror(path);
+		if (fd >= 0) {
+			close(fd);
+		}
+		return -1;
+	}
+
+	/* A new file is erased FLASH, extend it with 0xFF */
+	for (off_t offset = status.st_size; offset < (off_t)size; ) {
+		uint8_t erased[MEM_FLASH_SECTOR_SIZE];
+		size_t chunk = ((off_t)size - offset < (off_t)sizeof(erased)) ? (size_t)((off_t)size - offset) : sizeof(erased);
+
+		memset(erased, 0xFF, sizeof(erased));
+		if (pwrite(fd, erased, chunk, offset) != (ssize_t)chunk) {
+			perror(path);
+			close(fd);
+			return -1;
+		}
+		offset += (off_t)chunk;
+	}
+
+	void *memory = mmap((void *)(uintptr_t)SF_FLASH_HOST_BASE_ADDRESS, size, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_FIXED_NOREPLACE, fd, 0);
+	close(fd);
+
+	if (memory != (void *)(uintptr_t)SF_FLASH_HOST_BASE_ADDRESS) {
+		fprintf(stderr, "%s: cannot map at 0x%08x\n", path, SF_FLASH_HOST_BASE_ADDRESS);
+		if (memory != MAP_FAILED) {
+			munmap(memory, size);
+		}
+		return -1;
+	}
+
+	sf_flash_host.memory = memory;
+	sf_flash_host.size = size;
+
+	return 0;
+}
+
+void sf_flash_host_set_timing(uint32_t erase_us, uint32_t program_us)
+{
+	sf_flash_host.erase_us = erase_us;
+	sf_flash_host.program_us = program_us;
+}
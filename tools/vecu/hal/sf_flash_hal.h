@@ -0,0 +1,35 @@
+/**
+ * @file sf_flash_hal.h
+ * @brief Host FLASH HAL of the virtual ECU
+ * @details Same API as the FLASH HAL of sf_hal_stm32h5, over a file mapped at the
+ *          address of the FLASH of the STM32H563, so that the bootloader can keep
+ *          reading it through plain pointers. Like the real FLASH, a quad-word can
+ *          only be programmed once after the erase of its sector.
+ *
+ *          Erase and program times can be given to get realistic update times, the
+ *          calls then busy-wait that long, or advance the simulated timebase.
+ * @date 19/10/2026
+ */
+
+#pragma once
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* General defines ------------------------------------------------------------------*/
+#define SF_FLASH_HOST_BASE_ADDRESS          0x08000000U
+#define MEM_FLASH_WRITE_ALIGNMENT           16U
+
+#define SF_FLASH_STATUS_OK                  0
+#define SF_FLASH_STATUS_ERROR               1
+
+/* Public Functions ------------------------------------------------------------------*/
+int sf_flash_check(uint32_t address, uint32_t size, void *context);
+int sf_flash_erase_page(uint32_t page, void *context);
+int sf_flash_get_page_index(uint32_t address, void *context);
+int sf_flash_read(uint32_t address, void *data, uint32_t size, void *context);
+int sf_flash_write(uint32_t address, const void *data, uint32_t size, void *context);
+
+/* Host only */
+int sf_flash_host_open(const char *path, uint32_t size);
+void sf_flash_host_set_timing(uint32_t erase_us, uint32_t program_us);
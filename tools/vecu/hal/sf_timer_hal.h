@@ -0,0 +1,9 @@
+/**
+ * @file sf_timer_hal.h
+ * @brief Host timer HAL of the virtual ECU
+ * @details The bootloader services only use the 1 ms counter of the bootloader HAL,
+ *          nothing is provided here.
+ * @date 19/10/2026
+ */
+
+#pragma once
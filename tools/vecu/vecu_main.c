@@ -0,0 +1,332 @@
+/**
+ * @file vecu_main.c
+ * @brief Virtual ECU: the bootloader main loop on Linux
+ * @details Runs the boot of Core/Src/main.c (services/boot/boot_main.c), the CAN
+ *          message handler, the memory layer and the bootloader core of fw-utils
+ *          over the host HALs of tools/vecu/hal: the FLASH is a file mapped at its
+ *          target address and CAN is a host_can bus. Each process is one ECU, start several on the same bus
+ *          to flash them side by side:
+ *
+ *            vecu --flash ecu4.bin --bus udp &
+ *            vecu --flash ecu5.bin --bus udp --board inverter &
+ *
+ *          The process ends with the jump to the application. The update report of
+ *          the session, if any, is printed then.
+ *
+ *          vecu_sim is the same program on simulated time, started by the bus
+ *          simulator (tools/cansim) for each ECU it simulates. It also replays a
+ *          captured trace (cansim or flasher --capture, candump -l) as fast as the
+ *          host runs it:
+ *
+ *            vecu_sim --flash ecu4.bin --bus replay:session.log > replay.log
+ *
+ *          The frames the ECU sends are written to stdout on the time of the trace,
+ *          a change of the protocol shows as a diff between two replays. The
+ *          update report, the replay rate and the profiling zones of the
+ *          bootloader, timed on the host, are printed to stderr at the end.
+ * @date 19/10/2026
+ */
+
+/* Global Includes ------------------------------------------------------------------*/
+#include <getopt.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Private Includes ------------------------------------------------------------------*/
+#include "bootloader.h"
+#include "sf_bootloader_hal.h"
+#include "sf_can_hal.h"
+#include "sf_flash_hal.h"
+#include "mem.h"
+#include "can_message_handler.h"
+#include "boot_cache.h"
+#include "boot_handoff.h"
+#include "boot_main.h"
+#include "boot_timeline.h"
+#include "event_loop.h"
+#include "scheduler.h"
+#include "timebase.h"
+#include "dlog.h"
+#include "profile_zone.h"
+#include "update_report.h"
+
+/* Private defines ------------------------------------------------------------------*/
+#define VECU_BTEA_BUFFER_SIZE               0x2000U
+#define VECU_BOOTLOADER_VERSION             0x01U
+#define VECU_JUMP_DELAY_MS                  200U
+#define VECU_FLASH_SIZE                     (MEM_FLASH_END_ADDRESS - SF_FLASH_HOST_BASE_ADDRESS)
+
+/* Private types --------------------------------------------------------------------*/
+typedef struct {
+	const char *name;
+	uint8_t ecu_id;
+	public_key_t public_key;
+	btea_key_t btea_key;
+} vecu_board_t;
+
+typedef struct {
+	const vecu_board_t *board;
+	uint8_t ecu_id;
+	bool log;
+	uint32_t last_tick_ms;
+	bool replay;
+	struct timespec replay_start;           /* Host time the replay started */
+} vecu_t;
+
+/* Static Variables -----------------------------------------------------------------*/
+/* The boards of main.c, with their keys */
+static const vecu_board_t vecu_boards[] = {
+	{
+		.name = "charger",
+		.ecu_id = 4U,
+		.public_key = { .key = {
+			0xc4, 0x05, 0xad, 0xcf, 0xbe, 0x78, 0x79, 0x58, 0x6a, 0xbe, 0x6f, 0x5a, 0x20, 0x27, 0x3f, 0xc9,
+			0x4e, 0xf0, 0x7c, 0xc5, 0x7b, 0xbe, 0xcc, 0x43, 0xe9, 0xa0, 0xc3, 0x77, 0x70, 0x0d, 0x69, 0x29,
+			0xb6, 0x9d, 0xae, 0xf1, 0x62, 0x3b, 0x5e, 0x90, 0x32, 0x9b, 0x2b, 0x82, 0x71, 0xd4, 0x55, 0x4e,
+			0x19, 0x2d, 0xfe, 0x31, 0x0c, 0x1d, 0x7d, 0x11, 0x80, 0xf6, 0x0e, 0x25, 0xaa, 0x2e, 0x82, 0xc7
+		} },
+		.btea_key = { .key = { 0x474657E4, 0x11AC1600, 0x4577F6F4, 0x56F4387D } },
+	},
+	{
+		.name = "inverter",
+		.ecu_id = 5U,
+		.public_key = { .key = {
+			0x6e, 0xe7, 0x68, 0x2d, 0x5e, 0x20, 0xea, 0x16, 0x31, 0x21, 0x17, 0x32, 0x0b, 0x36, 0x70, 0x04,
+			0x95, 0x7b, 0x8e, 0xe0, 0x9d, 0x39, 0x02, 0x3c, 0x29, 0xef, 0xb9, 0x3e, 0x1e, 0x45, 0x9c, 0x34,
+			0x81, 0x4a, 0x20, 0x32, 0x2e, 0x03, 0xd1, 0x33, 0x32, 0xfd, 0xad, 0x32, 0xe8, 0xaa, 0x36, 0xb3,
+			0x02, 0xf6, 0x70, 0xa9, 0x46, 0x7d, 0x04, 0x91, 0x5f, 0x65, 0x9e, 0x4f, 0x25, 0xd6, 0x9d, 0x94
+		} },
+		.btea_key = { .key = { 0x8296938A, 0x69226073, 0x63D1A473, 0xC8904B38 } },
+	},
+};
+
+static const char *const vecu_metric_names[UPDATE_REPORT_METRIC_COUNT] = {
+	"state", "duration_ms", "bytes_received", "throughput_bps", "retransmitted_packets",
+	"erase_us", "program_us", "decrypt_us", "hash_us", "verify_us", "max_stall_us", "raw_bytes_received",
+};
+
+#if BOOTLOADER_PROFILING
+static const char *const vecu_zone_names[PROFILE_ZONE_COUNT] = {
+	"can_frame", "bootloader_rx", "decrypt", "mem_write", "mem_copy", "crc", "ecdsa_verify", "manifest_signature",
+};
+#endif
+
+static vecu_t vecu;
+static uint8_t btea_buffer[VECU_BTEA_BUFFER_SIZE];
+static boot_main_platform_t vecu_platform;
+
+/* Private Functions ----------------------------------------------------------------*/
+static void vecu_log(const char *format, ...)
+{
+	va_list args;
+
+	if (!vecu.log) {
+		return;
+	}
+
+	va_start(args, format);
+	printf("[%u] ecu %u: ", sf_bootloader_hal_get_1ms_counter(), vecu.ecu_id);
+	vprintf(format, args);
+	printf("\n");
+	va_end(args);
+}
+
+/* Some metrics are timed on the host: to stderr in a replay, which keeps stdout reproducible */
+static void vecu_print_report(void)
+{
+	FILE *out = vecu.replay ? stderr : stdout;
+
+	if (update_report_get(UPDATE_REPORT_STATE) == UPDATE_REPORT_STATE_NONE) {
+		return;
+	}
+
+	for (uint32_t metric = 0; metric < UPDATE_REPORT_METRIC_COUNT; metric++) {
+		fprintf(out, "report,%u,%s,%u\n", vecu.ecu_id, vecu_metric_names[metric], update_report_get((update_report_metric_e)metric));
+	}
+	fprintf(out, "report,%u,rx_dropped,%u\n", vecu.ecu_id, sf_can_host_dropped());
+	fflush(out);
+}
+
+/* Replay rate and host cost of the zones, the time of the host is not reproducible */
+static void vecu_print_replay(void)
+{
+	sf_can_host_replay_stats_t stats;
+	struct timespec now;
+
+	sf_can_host_replay_get_stats(&stats);
+	(void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+	double host_s = (double)(now.tv_sec - vecu.replay_start.tv_sec) + ((double)(now.tv_nsec - vecu.replay_start.tv_nsec) / 1e9);
+	double simulated_s = (double)stats.simulated_us / 1e6;
+
+	fprintf(stderr, "replay: %u frames received, %u bootloader frames left out, %u sent\n", stats.frames, stats.skipped, stats.sent);
+	fprintf(stderr, "replay: %.3f s simulated in %.3f s, %.0f frames/s, %.1fx real time\n", simulated_s, host_s,
+			(host_s > 0.0) ? ((double)stats.frames / host_s) : 0.0, (host_s > 0.0) ? (simulated_s / host_s) : 0.0);
+
+#if BOOTLOADER_PROFILING
+	fprintf(stderr, "%-20s %10s %10s %10s %10s %12s\n", "zone", "calls", "avg_ns", "min_ns", "max_ns", "total_us");
+	for (uint32_t zone = 0; zone < PROFILE_ZONE_COUNT; zone++) {
+		const profile_zone_stats_t *zone_stats = &profile_zone_table[zone];
+
+		if (zone_stats->count == 0U) {
+			continue;
+		}
+		fprintf(stderr, "%-20s %10u %10llu %10u %10u %12llu\n", vecu_zone_names[zone], zone_stats->count,
+				(unsigned long long)(zone_stats->total_cycles / zone_stats->count), zone_stats->min_cycles,
+				zone_stats->max_cycles, (unsigned long long)(zone_stats->total_cycles / 1000U));
+	}
+#endif
+}
+
+static void usage(const char *name)
+{
+	fprintf(stderr,
+			"usage: %s --flash <file> [--bus udp[:<port>]|<can interface>|sim:<fd>|replay:<trace>]\n"
+			"          [--board charger|inverter] [--ecu <code>] [--stay] [--log] [--erase-us <us>] [--program-us <us>]\n"
+			"  --flash       FLASH image, created erased if missing\n"
+			"  --bus         bus to join, default udp, sim:<fd> is set by cansim, replay:<trace> in vecu_sim\n"
+			"  --board       keys and ECU code, default charger\n"
+			"  --ecu         ECU code instead of the one of the board\n"
+			"  --stay        stay in the bootloader, as asked by the application\n"
+			"  --log         print the bootloader core log\n"
+			"  --erase-us    time of a sector erase\n"
+			"  --program-us  time of a quad-word program\n",
+			name);
+}
+
+/* Public Functions -----------------------------------------------------------------*/
+/* The FDCAN interrupt and the SysTick of the target */
+void event_loop_host_sleep(void)
+{
+	(void)sf_can_host_receive(1);
+
+	if (sf_can_host_replay_ended()) {
+		vecu_print_report();
+		exit(EXIT_SUCCESS);
+	}
+
+	uint32_t now_ms = sf_bootloader_hal_get_1ms_counter();
+	if (now_ms != vecu.last_tick_ms) {
+		vecu.last_tick_ms = now_ms;
+		event_loop_post(EVENT_LOOP_TICK);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	static const struct option options[] = {
+		{ "flash", required_argument, NULL, 'f' },
+		{ "bus", required_argument, NULL, 'b' },
+		{ "board", required_argument, NULL, 'B' },
+		{ "ecu", required_argument, NULL, 'e' },
+		{ "stay", no_argument, NULL, 's' },
+		{ "log", no_argument, NULL, 'l' },
+		{ "erase-us", required_argument, NULL, 'E' },
+		{ "program-us", required_argument, NULL, 'P' },
+		{ NULL, 0, NULL, 0 },
+	};
+	const char *flash_path = NULL;
+	const char *bus = "udp";
+	const char *board = "charger";
+	long ecu_id = -1;
+	bool stay = false;
+	uint32_t erase_us = 0;
+	uint32_t program_us = 0;
+	int option;
+
+	while ((option = getopt_long(argc, argv, "", options, NULL)) != -1) {
+		switch (option) {
+			case 'f': flash_path = optarg; break;
+			case 'b': bus = optarg; break;
+			case 'B': board = optarg; break;
+			case 'e': ecu_id = strtol(optarg, NULL, 0); break;
+			case 's': stay = true; break;
+			case 'l': vecu.log = true; break;
+			case 'E': erase_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+			case 'P': program_us = (uint32_t)strtoul(optarg, NULL, 0); break;
+			default:
+				usage(argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+
+	for (uint32_t i = 0; i < sizeof(vecu_boards) / sizeof(vecu_boards[0]); i++) {
+		if (strcmp(vecu_boards[i].name, board) == 0) {
+			vecu.board = &vecu_boards[i];
+		}
+	}
+
+	if (flash_path == NULL || vecu.board == NULL || ecu_id > 0xFF) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+	vecu.ecu_id = (ecu_id >= 0) ? (uint8_t)ecu_id : vecu.board->ecu_id;
+
+	/* Same order as main.c, the clocks and peripherals aside */
+	boot_timeline_start();
+	timebase_init();
+	dlog_init();
+
+	if (sf_flash_host_open(flash_path, VECU_FLASH_SIZE) != 0) {
+		return EXIT_FAILURE;
+	}
+	sf_flash_host_set_timing(erase_us, program_us);
+
+	mem_init();
+	boot_cache_init();
+	boot_handoff_begin(0U, stay ? BOOT_HANDOFF_REASON_STAY_REQUEST : BOOT_HANDOFF_REASON_POWER_ON);
+
+	/* The tasks of main.c, the LED excepted */
+	vecu_platform.ecu_id = vecu.ecu_id;
+	vecu_platform.version = VECU_BOOTLOADER_VERSION;
+	vecu_platform.before_jump = vecu_print_report;
+	boot_main_init(&vecu_platform);
+
+	if (!stay) {
+		boot_main_fast_boot();
+	}
+
+	if (sf_can_host_open(bus) != 0) {
+		return EXIT_FAILURE;
+	}
+	if (strncmp(bus, SF_CAN_HOST_REPLAY_PREFIX, strlen(SF_CAN_HOST_REPLAY_PREFIX)) == 0) {
+		vecu.replay = true;
+		(void)clock_gettime(CLOCK_MONOTONIC, &vecu.replay_start);
+		(void)atexit(vecu_print_replay);
+	}
+
+	const bootloader_config_t config = {
+		.device_id = vecu.ecu_id,
+		.btea_buffer = btea_buffer,
+		.padding = {
+			.num_bytes = MEM_FLASH_WRITE_ALIGNMENT,
+			.padding_byte = 0xFF
+		},
+		.btea_chunk_size = VECU_BTEA_BUFFER_SIZE,
+		.btea_key = &vecu.board->btea_key,
+		.public_key = &vecu.board->public_key,
+		.jump_to_app_func = boot_main_jump_to_app,
+		.crc32_func = sf_bootloader_hal_crc32_func,
+		.log_func = vecu_log,
+		.magic = BOOTLOADER_MAGIC,
+		.mem_read_func = mem_read,
+		.mem_write_func = mem_write,
+		.mem_copy_func = mem_copy,
+		.send_msg_func = sf_bootloader_hal_send_bootloader_message,
+		.max_copy_retries = 3,
+		.jump_delay = VECU_JUMP_DELAY_MS,
+	};
+
+	boot_main_start(&config, NULL, stay);
+
+	printf("ecu %u (%s) on %s\n", vecu.ecu_id, vecu.board->name, bus);
+	fflush(stdout);
+
+	while (1) {
+		scheduler_run();
+		event_loop_wait();
+	}
+}